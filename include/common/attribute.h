@@ -3,6 +3,7 @@
 #include "raster.h"
 #include "typedefs.h"
 #include "easing_base.h"
+#include <atomic>
 
 namespace Raster {
 
@@ -61,6 +62,11 @@ namespace Raster {
 
         static void ProcessKeyframeShortcuts();
 
+        // bumped whenever keyframes of any attribute are added, removed, retimed or edited in place.
+        // caches derived from keyframes are validated against it instead of rescanning keyframes
+        static std::atomic<uint64_t> s_keyframesRevision;
+        static void InvalidateKeyframes();
+
         bool KeyframeExists(float t_timestamp);
         std::optional<AttributeKeyframe*> GetKeyframeByTimestamp(float t_timestamp);
         std::optional<int> GetKeyframeIndexByTimestamp(float t_timestamp);
@@ -76,6 +82,10 @@ namespace Raster {
 
         void RenderKeyframe(AttributeKeyframe& t_keyframe);
 
+        // returns index of the first keyframe located after t_frame, t_hint is tried before binary search
+        int FindSegment(float t_frame, int t_hint);
+        std::any InterpolateSegment(int t_segment, float t_frame, Composition* t_composition);
+
         virtual Json AbstractSerialize() { return {}; };
 
         void Initialize();
@@ -87,6 +97,11 @@ namespace Raster {
         void RenderKeyframePopup(AttributeKeyframe& t_keyframe);
 
         static std::vector<int> m_deletedKeyframes;
+
+        // value of s_keyframesRevision at which keyframes were last known to be sorted
+        std::atomic<uint64_t> m_sortedRevision = 0;
+        // last segment found by any thread, only a starting guess since FindSegment() validates it
+        std::atomic<int> m_segmentHint = 0;
     };
 
     using AttributeSpawnProcedure = std::function<AbstractAttribute()>;
@@ -8,6 +8,8 @@ namespace Raster {
         int id;
         int redirectID; // negative if not redirecting, positive if redirecting to some audio bus
         bool main;
+        bool muted;
+        float gain; // applied when the bus is mixed into its destination (or to the output for the main bus)
         std::string name;
         std::vector<float> samples;
         std::vector<float> waveformSamples;
@@ -19,6 +21,29 @@ namespace Raster {
         // ensures samples buffer is large enough to hold audio samples
         void ValidateBuffers();
 
+        // t_destination[i] += t_source[i] * t_gain
+        static void AccumulateSamples(float* t_destination, const float* t_source, size_t t_count, float t_gain = 1.0f);
+
         Json Serialize();
     };
+
+    // dependency-ordered mixing plan of project audio buses
+    // rebuilt only when bus ids, redirections or main flags change
+    struct AudioBusRouting {
+        uint64_t signature;
+        std::vector<int> order; // bus indices, every bus comes before the bus it redirects to
+        std::vector<int> destinations; // destination bus index per bus index, -1 if not redirecting
+        std::vector<int> cyclicBuses; // ids of buses whose redirection was ignored because it forms a cycle
+        unordered_dense::map<int, int> indices; // bus id -> bus index
+
+        AudioBusRouting() : signature(0) {}
+
+        // returns true if the routing was rebuilt
+        bool Update(const std::vector<AudioBus>& t_buses);
+        std::optional<int> GetBusIndex(int t_busID) const;
+
+        // true if redirecting t_busID into t_redirectID would make audio loop back into t_busID
+        static bool CreatesCycle(const std::vector<AudioBus>& t_buses, int t_busID, int t_redirectID);
+        static uint64_t ComputeSignature(const std::vector<AudioBus>& t_buses);
+    };
 };
\ No newline at end of file
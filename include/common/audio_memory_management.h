@@ -7,6 +7,8 @@ namespace Raster {
         static void Initialize(size_t t_bytes);
         static void* Allocate(size_t t_bytes);
         static void Reset();
+        // resets calling thread's heap unless it was already reset during the given audio pass
+        static void ResetForPass(int t_audioPassID);
         static void Terminate();
     };
 };
\ No newline at end of file
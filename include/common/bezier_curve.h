@@ -12,6 +12,13 @@ namespace Raster {
 
         glm::vec2 Get(float t_percentage);
 
+        // adaptively flattens the curve, `t_transform` maps curve points into NDC
+        // and `t_tolerance` is the allowed deviation from the real curve in pixels of `t_viewportSize`.
+        // writes curve parameters and NDC positions of every polyline vertex (both ends included)
+        void Tessellate(glm::mat4 t_transform, glm::vec2 t_viewportSize, int t_maxDepth, float t_tolerance, std::vector<float>& t_parameters, std::vector<glm::vec2>& t_points);
+
+        uint64_t Hash();
+
         Json Serialize();
     };
 };
\ No newline at end of file
@@ -0,0 +1,29 @@
+#pragma once
+
+#include "raster.h"
+
+namespace Raster {
+
+    struct Project;
+
+    // interval index over active ranges of project compositions.
+    // composition is active at frame t if t is within [begin - 1; end + 1), same as traversal bounds.
+    // index is refreshed by UI thread once per frame and may be queried from any thread
+    struct CompositionIndex {
+        // rebuilds index if bounds, order or locks of compositions have changed, returns true if index was rebuilt
+        static bool Update(Project& t_project);
+
+        // indices of compositions active at t_frame in project order, O(log n + k)
+        static std::vector<int> GetActiveCompositions(Project& t_project, float t_frame);
+
+        // compositions which become active (t_activated) or inactive (t_deactivated) when moving from t_from to t_to.
+        // returns false if index is out of sync with the project
+        static bool GetActivationChanges(Project& t_project, float t_from, float t_to, std::vector<int>& t_activated, std::vector<int>& t_deactivated);
+
+        // indices of compositions locked to other compositions
+        static std::vector<int> GetLockedCompositions(Project& t_project);
+
+        // changes every time index is rebuilt
+        static uint64_t GetRevision();
+    };
+};
@@ -4,18 +4,39 @@
 #include <glm/ext/matrix_transform.hpp>
 
 namespace Raster {
+    // one rank-1 component of a kernel, kernel(x, y) ~= sum(horizontal[x] * vertical[y])
+    struct SeparableKernelTerm {
+        std::vector<float> horizontal, vertical;
+    };
+
+    // arbitrary-size (width x height) convolution kernel, values are stored row by row.
+    // kernel center is located at (width / 2, height / 2)
     struct ConvolutionKernel {
         static std::vector<std::pair<std::string, ConvolutionKernel>> s_presets;
 
         float multiplier;
-        glm::mat3 kernel;
+        int width, height;
+        std::vector<float> values;
 
-        ConvolutionKernel() : multiplier(1.0), kernel(0, 0, 0, 0, 1, 0, 0, 0, 0) {}
-        ConvolutionKernel(float t_multiplier, glm::mat3 t_kernel) : multiplier(t_multiplier), kernel(t_kernel) {}
+        ConvolutionKernel() : multiplier(1.0), width(3), height(3), values({0, 0, 0, 0, 1, 0, 0, 0, 0}) {}
+        ConvolutionKernel(float t_multiplier, glm::mat3 t_kernel);
+        ConvolutionKernel(float t_multiplier, int t_width, int t_height, std::vector<float> t_values);
         ConvolutionKernel(Json t_data);
 
-        glm::mat3 GetKernel();
+        float Get(int t_x, int t_y) const;
+        void Set(int t_x, int t_y, float t_value);
+        // keeps existing values centered in the new kernel
+        void Resize(int t_width, int t_height);
+
+        // decomposes kernel into a sum of rank-1 terms until relative error drops below t_tolerance.
+        // returns std::nullopt if more than t_maxRank terms are required
+        std::optional<std::vector<SeparableKernelTerm>> Decompose(int t_maxRank, float t_tolerance = 1e-3f) const;
+
+        uint64_t Hash() const;
 
         Json Serialize();
+
+        bool operator==(const ConvolutionKernel& t_other) const;
+        bool operator!=(const ConvolutionKernel& t_other) const { return !(*this == t_other); }
     };
-};
\ No newline at end of file
+};
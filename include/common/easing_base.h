@@ -16,6 +16,8 @@ namespace Raster {
         void RenderDetails();
 
         virtual float Get(float t_percentage) = 0;
+        // evaluates easing at every percentage of t_percentages, easings may override it with a faster batched path
+        virtual void Evaluate(const std::vector<float>& t_percentages, std::vector<float>& t_values);
 
         Json Serialize();
         void Load(Json t_data);
@@ -3,6 +3,9 @@
 #include "raster.h"
 #include "randomizer.h"
 
+// resolution of baked gradients for 8-bit color precision
+#define GRADIENT_LUT_RESOLUTION 256
+
 namespace Raster {
 
     #pragma pack(push, 1)
@@ -36,6 +39,14 @@ namespace Raster {
 
         glm::vec4 Get(float t_percentage);
 
+        // samples the gradient uniformly into `t_resolution` colors, see SampleBaked()
+        std::vector<glm::vec4> Bake(int t_resolution);
+        static glm::vec4 SampleBaked(const std::vector<glm::vec4>& t_lut, float t_percentage);
+        // Bake() result shared between all gradients with identical stops, rebaked only when stops change
+        std::shared_ptr<const std::vector<glm::vec4>> GetBaked(int t_resolution = GRADIENT_LUT_RESOLUTION);
+
+        uint64_t Hash();
+
         void AddStop(float t_percentage, glm::vec4 t_color);
         void SortStops();
 
@@ -3,30 +3,42 @@
 #include "raster.h"
 #include "dylib.hpp"
 #include "typedefs.h"
+#include <mutex>
 
 namespace Raster {
+    // library found by Libraries::Discover(), description is taken from the manifest if the library wasn't changed
+    struct LibraryRecord {
+        std::string key;
+        Json description;
+    };
+
     struct Libraries {
         static std::unordered_map<std::string, internalDylib> s_registry;
 
-        static void LoadLibrary(std::string t_path, std::string t_key) {
-            if (s_registry.find(t_key) != s_registry.end()) return; // do not reload libraries
-            s_registry[t_key] = internalDylib(t_path, t_key);
-        }
+        static void LoadLibrary(std::string t_path, std::string t_key);
 
         template<typename T>
         static T* GetFunction(std::string t_key, std::string t_name) {
-            if (s_registry.find(t_key) == s_registry.end())
-                LoadLibrary(".", t_key);
-            internalDylib* d = &s_registry[t_key];
-            return d->get_function<T>(t_name.c_str());
+            return GetLibrary(t_key).get_function<T>(t_name.c_str());
         }
 
         template<typename T>
         static T& GetVariable(std::string t_key, std::string t_name) {
-            if (s_registry.find(t_key) == s_registry.end())
-                LoadLibrary(".", t_key);
-            internalDylib* d = &s_registry[t_key];
-            return d->get_variable<T>(t_name.c_str());
+            return GetLibrary(t_key).get_variable<T>(t_name.c_str());
         }
+
+        // lists libraries of t_directory. only new or modified libraries and libraries exporting OnStartup are loaded here,
+        // the rest should be loaded with LoadLibrary() on first use. OnStartup hooks are run by this function.
+        // t_describe serializes GetDescription() of a loaded library, changing t_context invalidates all descriptions of t_directory
+        static std::vector<LibraryRecord> Discover(std::string t_directory, std::string t_context, std::function<Json(std::string)> t_describe);
+        // saves descriptions collected by Discover() and prints time spent loading each library
+        static void FinishDiscovery();
+        // attributes time spent in startup code of a library loaded from t_directory, reported by FinishDiscovery()
+        static void RecordStartupTime(std::string t_directory, std::string t_key, float t_milliseconds);
+
+    private:
+        static internalDylib& GetLibrary(std::string t_key);
+
+        static std::recursive_mutex s_mutex;
     };
-};
\ No newline at end of file
+};
@@ -139,6 +139,8 @@ namespace Raster {
         std::vector<std::string> m_attributesOrder;
 
         bool ExecutingInAudioContext(ContextData& t_data);
+        // AbstractExecute() wrapped into profiler zones of this node
+        AbstractPinMap ProfiledExecute(ContextData& t_contextData);
     };
 
     using AbstractNode = std::shared_ptr<NodeBase>;
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "raster.h"
+#include "ocio_pipeline.h"
+
+namespace Raster {
+
+    enum class OCIOBakeMode {
+        None, LUT33, LUT65
+    };
+
+    // process-wide storage of compiled OCIO pipelines
+    // nodes that request identical transforms share one shader program and one set of LUT textures
+    // pipelines are keyed by OCIO processor cache ID and destroyed when the last user releases them
+    struct OCIOPipelineCache {
+        static std::shared_ptr<OCIOPipeline> Acquire(OCIO::ConstTransformRcPtr t_transform, OCIOBakeMode t_bakeMode = OCIOBakeMode::None);
+        static size_t GetPipelinesCount();
+
+    private:
+        static std::optional<OCIOPipeline> BakeLUT(OCIO::ConstProcessorRcPtr t_processor, int t_edgeLength);
+
+        static std::unordered_map<std::string, std::weak_ptr<OCIOPipeline>> s_pipelines;
+        static std::mutex s_mutex;
+    };
+};
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "raster.h"
+#include <atomic>
+
+#define RASTER_PROFILER_CONCAT_IMPL(a, b) a##b
+#define RASTER_PROFILER_CONCAT(a, b) RASTER_PROFILER_CONCAT_IMPL(a, b)
+// measures CPU time of the enclosing scope, t_name must be a string literal
+#define RASTER_PROFILE_ZONE(t_name) Raster::ProfilerScope RASTER_PROFILER_CONCAT(profilerScope, __LINE__)(t_name)
+
+// zones kept per thread, older zones are overwritten
+#define PROFILER_RING_BUFFER_SIZE 65536
+// weight of the newest sample in per-node moving averages
+#define PROFILER_SMOOTHING 0.1f
+
+namespace Raster {
+
+    struct ProfilerZone {
+        // points to a string literal, node zones are named after their node on export
+        const char* name;
+        int nodeID;
+        // nanoseconds since profiler startup
+        uint64_t begin, end;
+    };
+
+    // smoothed self time of a node, time spent in nodes it pulled inputs from is excluded
+    struct NodeProfile {
+        float cpuMilliseconds, gpuMilliseconds, audioMilliseconds;
+
+        NodeProfile() : cpuMilliseconds(0), gpuMilliseconds(0), audioMilliseconds(0) {}
+    };
+
+    // low-overhead instrumentation of CPU zones, GPU work of nodes and audio passes.
+    // everything is a single atomic load while profiler is disabled
+    struct Profiler {
+        static std::atomic<bool> s_enabled;
+
+        static void SetEnabled(bool t_enabled);
+        // names calling thread in exported traces
+        static void SetThreadName(std::string t_name);
+
+        // node zones with t_updateNodeProfile unset are only traced, they don't affect NodeProfile of the node
+        static void BeginZone(const char* t_name, int t_nodeID = 0, bool t_audio = false, bool t_updateNodeProfile = true);
+        static void EndZone();
+
+        // measures GPU time with timer queries until EndGPUZone(), nested zones pause the outer one.
+        // calling thread must own a GPU context
+        static void BeginGPUZone(const char* t_name, int t_nodeID = 0);
+        static void EndGPUZone();
+        // resolves finished timer queries of calling thread, call once per frame from every thread which records GPU zones
+        static void CollectGPUZones();
+
+        static std::optional<NodeProfile> GetNodeProfile(int t_nodeID);
+        // writes all buffered zones in Chrome trace event format (chrome://tracing, Perfetto)
+        static bool ExportChromeTrace(std::string t_path);
+        static void Clear();
+
+        static uint64_t GetTimestamp();
+    };
+
+    struct ProfilerScope {
+        ProfilerScope(const char* t_name, int t_nodeID = 0, bool t_audio = false, bool t_updateNodeProfile = true) : m_active(Profiler::s_enabled.load(std::memory_order_relaxed)) {
+            if (m_active) Profiler::BeginZone(t_name, t_nodeID, t_audio, t_updateNodeProfile);
+        }
+
+        ~ProfilerScope() {
+            if (m_active) Profiler::EndZone();
+        }
+
+    private:
+        bool m_active;
+    };
+
+    struct ProfilerGPUScope {
+        ProfilerGPUScope(const char* t_name, int t_nodeID = 0) : m_active(Profiler::s_enabled.load(std::memory_order_relaxed)) {
+            if (m_active) Profiler::BeginGPUZone(t_name, t_nodeID);
+        }
+
+        ~ProfilerGPUScope() {
+            if (m_active) Profiler::EndGPUZone();
+        }
+
+    private:
+        bool m_active;
+    };
+};
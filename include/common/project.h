@@ -37,6 +37,7 @@ namespace Raster {
         std::vector<int> selectedAssets;
 
         std::vector<AudioBus> audioBuses;
+        AudioBusRouting audioBusRouting;
         std::shared_ptr<std::mutex> audioBusesMutex;
 
         Json customData;
@@ -72,6 +73,13 @@ namespace Raster {
 
         Json Serialize();
     private:
+        // groups of active compositions which are linked through node pins, preserving traversal order
+        std::vector<std::vector<Composition*>> GetIndependentCompositionGroups(const std::vector<int>& t_activeIndices);
+        void ResetInactiveCompositions(const std::vector<int>& t_activeIndices, float t_time);
+
+        std::optional<float> m_lastResetTime;
+        uint64_t m_lastResetRevision = 0;
+
         ThreadUniqueValue<std::optional<float>> m_fakeTime;
     };
 };
\ No newline at end of file
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "raster.h"
+#include "zip.h"
+
+namespace Raster {
+
+    // reads one uncompressed entry straight from the archive file
+    struct ProjectArchiveStream {
+        ProjectArchiveStream(std::string t_archivePath, std::uintmax_t t_offset, std::uintmax_t t_size);
+        ~ProjectArchiveStream();
+
+        bool IsOpened();
+        size_t Read(uint8_t* t_data, size_t t_size);
+        // same semantics as fseek, returns the new position or -1
+        int64_t Seek(int64_t t_offset, int t_whence);
+        std::uintmax_t GetSize();
+
+        // switches stream to t_path read from t_offset while keeping its position, std::nullopt makes it read nothing
+        void Reopen(std::optional<std::string> t_path, std::uintmax_t t_offset = 0);
+
+    private:
+        std::mutex m_mutex;
+        std::FILE* m_file;
+        std::uintmax_t m_offset, m_size, m_position;
+    };
+
+    // virtual view of an opened .raster archive
+    // only the central directory is read on open, everything else is extracted to the project directory on first access
+    // or served directly from the archive when the entry is stored without compression
+    struct ProjectArchive {
+        static std::optional<ZIPManifest> Open(std::string t_archivePath, std::string t_directory);
+        // streams that still read from the archive end up reading nothing
+        static void Close();
+        // moves streams that read from the archive over to the extracted copies of their entries,
+        // so that the archive file itself can be replaced
+        static void DetachStreams();
+
+        // true if t_path is either on disk or inside of the archive
+        static bool Exists(std::string t_path);
+        static std::optional<std::uintmax_t> GetFileSize(std::string t_path);
+
+        static bool Extract(std::string t_path);
+        // starts extraction in background, returns true once t_path is available on disk
+        static bool RequestExtraction(std::string t_path);
+        static void ExtractAll();
+
+        // returns nullptr if t_path is already on disk or can't be read without decompression
+        static std::shared_ptr<ProjectArchiveStream> OpenStream(std::string t_path);
+
+        // should be called when the project deletes a file that might still live only in the archive
+        static void Forget(std::string t_path);
+
+        // entries that were not extracted yet and therefore are unchanged since the archive was written
+        static std::set<std::string> GetArchivedEntries();
+        // records modification times of files extracted since the last call
+        static void UpdateManifest(ZIPManifest& t_manifest);
+    };
+};
@@ -0,0 +1,22 @@
+#pragma once
+
+#include "raster.h"
+#include <condition_variable>
+
+namespace Raster {
+
+    // work-stealing pool for CPU-only work
+    // every worker owns a task queue, idle workers steal from the back of other queues
+    // tasks must not touch the GPU, rendering context is bound only to the rendering thread
+    struct TaskScheduler {
+        // t_workersCount <= 0 picks a count based on hardware concurrency
+        static void Initialize(int t_workersCount = 0);
+        static void Terminate();
+
+        // invokes t_body for every index in [0, t_count) and waits for all invocations to finish
+        // calling thread executes tasks too, so nested calls don't deadlock
+        static void ParallelFor(size_t t_count, std::function<void(size_t)> t_body);
+
+        static int GetWorkersCount();
+    };
+};
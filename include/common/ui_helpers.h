@@ -5,6 +5,7 @@
 #include "workspace.h"
 #include "audio_samples.h"
 #include "gradient_1d.h"
+#include "convolution_kernel.h"
 
 namespace Raster {
     struct UIHelpers {
@@ -26,6 +27,9 @@ namespace Raster {
         static void RenderGradient1D(Gradient1D& t_gradient, float t_width = 0, float t_height = 0, float t_alpha = 1.0f);
         static bool RenderGradient1DEditor(Gradient1D& t_gradient, float t_width = 0, float t_height = 0.0f);
 
+        // edits kernel size and values, large kernels only expose their size
+        static bool RenderConvolutionKernelEditor(ConvolutionKernel& t_kernel);
+
         static void RenderProjectEditor(Project& t_project);
         static void RenderAudioDiscretizationOptionsEditor(AudioDiscretizationOptions& t_options);
 
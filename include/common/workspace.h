@@ -6,10 +6,12 @@
 #include "node_base.h"
 #include "project.h"
 #include "configuration.h"
+#include "zip.h"
 #include "composition.h"
 #include "attribute.h"
 #include "sampler_settings.h"
 #include "easings.h"
+#include <atomic>
 #include "assets.h"
 #include "double_buffered_value.h"
 #include "plugin_base.h"
@@ -20,6 +22,10 @@ namespace Raster {
         static std::mutex s_projectMutex, s_nodesMutex;
         static std::vector<NodeImplementation> s_nodeImplementations;
         static Configuration s_configuration;
+        static ZIPManifest s_projectManifest;
+        static std::optional<std::future<std::optional<ZIPManifest>>> s_projectCompaction;
+        // incremented whenever another project is opened, lets threads drop their per-project GPU caches
+        static std::atomic<int> s_projectGeneration;
 
         static std::unordered_map<std::string, uint32_t> s_colorMarks;
         static std::string s_defaultColorMark;
@@ -43,6 +49,9 @@ namespace Raster {
         static std::optional<Composition*> GetCompositionByNodeID(int t_nodeID);
         static std::optional<Composition*> GetCompositionByAttributeID(int t_attributeID);
 
+        // appends implementation to s_nodeImplementations under the index mutex, FindNodeImplementation() indexes it on next lookup
+        static void RegisterNodeImplementation(NodeImplementation t_implementation);
+
         static std::optional<AbstractNode> AddNode(std::string t_nodeName);
         static std::optional<AbstractNode> InstantiateNode(std::string t_nodeName);
         static std::optional<AbstractNode> InstantiateSerializedNode(Json node);
@@ -53,6 +62,8 @@ namespace Raster {
         static std::optional<NodeImplementation> GetNodeImplementationByPackageName(std::string t_packageName);
 
         static AbstractNode PopulateNode(std::string t_nodeName, AbstractNode node);
+        // matches either library name or package name, returns index into s_nodeImplementations
+        static std::optional<size_t> FindNodeImplementation(std::string t_name, bool t_packageNameOnly = false);
 
         static std::optional<AbstractNode> GetNodeByNodeID(int nodeID);
         static std::optional<AbstractNode> GetNodeByPinID(int pinID);
@@ -83,6 +94,11 @@ namespace Raster {
         static void OpenProject(std::string t_path);
         static void CreateEmptyProject(Project& t_project, std::string t_projectPath);
         static void SaveProject();
+        static void CompactProject();
+        // also collects a finished compaction
+        static bool IsProjectCompacting();
+        // waits for compaction and takes over the manifest it produced, must be called from the UI thread
+        static void CollectProjectCompaction();
         static std::optional<AbstractAsset> ImportAsset(std::string t_assetPath);
         static void DeleteComposition(int t_id);
         static Project& GetProject();
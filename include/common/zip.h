@@ -3,8 +3,36 @@
 #include "raster.h"
 
 namespace Raster {
+    struct ZIPEntryState {
+        std::uintmax_t size;
+        int64_t modificationTime;
+
+        bool operator==(const ZIPEntryState& t_other) const {
+            return size == t_other.size && modificationTime == t_other.modificationTime;
+        }
+    };
+
+    // describes what an archive contains so that later saves can append only the difference
+    struct ZIPManifest {
+        std::string archivePath;
+        std::unordered_map<std::string, ZIPEntryState> entries;
+        std::set<std::string> removedEntries;
+        // bytes occupied by entries that were superseded by appended ones
+        std::uintmax_t staleBytes;
+
+        ZIPManifest() : staleBytes(0) {}
+    };
+
     struct ZIP {
         static void Extract(std::string t_zipFile, std::string t_outputDirectory);
         static void Pack(std::string t_zipFile, std::string t_inputDirectory);
+
+        static std::unordered_map<std::string, ZIPEntryState> Scan(std::string t_inputDirectory);
+
+        // appends changed and new files of t_inputDirectory, removed files are recorded in a journal entry
+        // t_archivedEntries are files that only exist inside of the archive and count as unchanged
+        static bool Append(std::string t_inputDirectory, ZIPManifest& t_manifest, const std::set<std::string>& t_archivedEntries = {});
+        // rewrites the archive from scratch, dropping stale entries
+        static bool Compact(std::string t_inputDirectory, ZIPManifest& t_manifest);
     };
-};
\ No newline at end of file
+};
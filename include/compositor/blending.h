@@ -20,6 +20,7 @@ namespace Raster {
     struct Blending {
         std::vector<BlendingMode> modes;
         std::optional<Pipeline> pipelineCandidate;
+        std::optional<std::string> shaderCode;
         std::optional<Framebuffer> framebufferCandidate;
 
         Blending();
@@ -28,7 +29,9 @@ namespace Raster {
         Framebuffer PerformBlending(BlendingMode& mode, Texture base, Texture blend, float opacity);
         Framebuffer PerformManualBlending(BlendingMode& mode, Texture base, Texture blend, float opacity, glm::vec4 backgroundColor);
 
+        // queues background compilation of the blending shader, pipeline is created by IsReady() once it's compiled
         void GenerateBlendingPipeline();
+        bool IsReady();
         void EnsureResolutionConstraints(Texture& texture);
 
         std::optional<int> GetModeIndexByCodeName(std::string t_codename);
@@ -41,6 +41,15 @@ namespace Raster {
         static Framebuffer GenerateCompatibleFramebuffer(glm::vec2 t_resolution, std::optional<TexturePrecision> t_precision = std::nullopt);
         static DoubleBufferedFramebuffer GenerateCompatibleDoubleBufferedFramebuffer(glm::vec2 t_resolution, std::optional<TexturePrecision> t_precision = std::nullopt);
 
+        // same as GenerateCompatible*, but reuses framebuffers recycled by the current thread when possible
+        static Framebuffer AcquireFramebuffer(glm::vec2 t_resolution, std::optional<TexturePrecision> t_precision = std::nullopt);
+        static DoubleBufferedFramebuffer AcquireDoubleBufferedFramebuffer(glm::vec2 t_resolution, std::optional<TexturePrecision> t_precision = std::nullopt);
+        // returns framebuffer to the pool of the current thread instead of destroying it
+        static void RecycleFramebuffer(Framebuffer& t_fbo);
+        static void RecycleFramebuffer(DoubleBufferedFramebuffer& t_fbo);
+        // destroys framebuffers pooled by the current thread, called when the project changes
+        static void ClearFramebufferPool();
+
         static void EnsureResolutionConstraints();
         static void EnsureResolutionConstraintsForFramebuffer(Framebuffer& t_fbo);
         static void EnsureResolutionConstraintsForFramebuffer(DoubleBufferedFramebuffer& t_fbo);
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "raster.h"
+#include "gpu/gpu.h"
+#include "common/convolution_kernel.h"
+
+// texture kernels with more taps are read back and go through the same strategy selection as regular kernels
+#define MAX_DIRECT_TEXTURE_KERNEL_TAPS 225
+
+namespace Raster {
+
+    enum class ConvolutionStrategy {
+        // single pass, width * height taps per pixel
+        Direct,
+        // rank-1 kernel, horizontal + vertical pass
+        Separable,
+        // sum of a few rank-1 terms, two passes per term
+        LowRank
+    };
+
+    // convolves textures with arbitrary-size kernels, picking the cheapest strategy per kernel.
+    // may be used from any thread owning a GPU context
+    struct Convolution {
+        // renders t_base convolved with t_kernel into the first attachment of t_target.
+        // t_tapSpacing is the distance between kernel taps in pixels of t_base,
+        // pass preview resolution scale to keep kernel footprint consistent across preview resolutions
+        static ConvolutionStrategy Apply(Framebuffer& t_target, Texture& t_base, const ConvolutionKernel& t_kernel, float t_multiplier = 1.0f, float t_tapSpacing = 1.0f);
+        // uses red channel of t_kernelTexture sampled as t_width x t_height kernel
+        static void ApplyTexture(Framebuffer& t_target, Texture& t_base, Texture& t_kernelTexture, int t_width, int t_height, float t_multiplier = 1.0f, bool t_normalize = true, float t_tapSpacing = 1.0f);
+        // resamples red channel of t_kernelTexture into a t_width x t_height kernel the same way ApplyTexture() does.
+        // waits for GPU to finish rendering t_kernelTexture, must not be called while a scissor rect is set
+        static ConvolutionKernel ReadTextureKernel(Texture& t_kernelTexture, int t_width, int t_height, bool t_normalize = true);
+
+        static ConvolutionStrategy GetStrategy(const ConvolutionKernel& t_kernel);
+        static std::string StrategyToString(ConvolutionStrategy t_strategy);
+
+        static void Clear();
+    };
+};
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "raster.h"
+#include "gpu/gpu.h"
+
+namespace Raster {
+
+    // axis-aligned [x0, x1) x [y0, y1) rectangle in framebuffer pixels, y axis points up like in GPU viewport
+    struct PixelRegion {
+        int x0, y0, x1, y1;
+
+        PixelRegion() : x0(0), y0(0), x1(0), y1(0) {}
+        PixelRegion(int t_x0, int t_y0, int t_x1, int t_y1) : x0(t_x0), y0(t_y0), x1(t_x1), y1(t_y1) {}
+
+        static PixelRegion Full(uint32_t t_width, uint32_t t_height);
+        // bounding box of clip-space points projected to t_resolution, padded by a pixel for antialiasing
+        static PixelRegion FromClipSpace(const std::vector<glm::vec4>& t_points, glm::vec2 t_resolution);
+
+        bool IsEmpty() const;
+        bool Covers(uint32_t t_width, uint32_t t_height) const;
+        PixelRegion Union(const PixelRegion& t_other) const;
+        PixelRegion Intersect(const PixelRegion& t_other) const;
+        PixelRegion Expand(int t_x, int t_y) const;
+        PixelRegion Clamp(uint32_t t_width, uint32_t t_height) const;
+
+        // x, y, width, height as expected by GPU::SetScissorRect()
+        glm::ivec4 ToScissor() const;
+    };
+
+    // domain of definition of textures produced during current rendering pass:
+    // everything outside of the recorded region is fully transparent.
+    // textures without recorded region are assumed to cover the whole frame.
+    // regions are kept per thread, rendering thread resets them at the beginning of every rendering pass
+    struct DomainOfDefinition {
+        static void Set(Framebuffer& t_framebuffer, PixelRegion t_region);
+        static std::optional<PixelRegion> Get(Texture& t_texture);
+        static PixelRegion GetOrFull(Texture& t_texture);
+
+        // regions are keyed by raw handles, so they must be dropped once a texture is destroyed or returned to the pool.
+        // only the calling thread's regions are affected, other threads lose theirs with the next Reset()
+        static void Invalidate(Texture& t_texture);
+        static void Invalidate(Framebuffer& t_framebuffer);
+
+        static void Reset();
+    };
+};
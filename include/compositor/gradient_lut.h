@@ -0,0 +1,21 @@
+#pragma once
+
+#include "raster.h"
+#include "gpu/gpu.h"
+#include "common/gradient_1d.h"
+
+namespace Raster {
+
+    // uploads baked gradients as (resolution x 1) RGBA textures so shaders can sample them with a single fetch.
+    // may be used from any thread owning a GPU context
+    struct GradientLUT {
+        // texture is owned by the cache and stays valid until the next Get() call on this thread
+        static Texture Get(Gradient1D& t_gradient, TexturePrecision t_precision);
+        // linear filtering, clamped to edge
+        static Sampler GetSampler();
+
+        static int GetResolution(TexturePrecision t_precision);
+
+        static void Clear();
+    };
+};
@@ -4,6 +4,7 @@
 #include "gpu/gpu.h"
 #include "compositor/compositor.h"
 #include "double_buffered_framebuffer.h"
+#include "domain_of_definition.h"
 
 namespace Raster {
     struct ManagedFramebuffer {
@@ -16,11 +17,20 @@ namespace Raster {
         Framebuffer& GetReadyFramebuffer();
         void Destroy();
 
+        // domain of definition of the base copied by the last Get() call, empty if there was no base
+        PixelRegion GetBaseRegion();
+        // must be called after drawing into framebuffer returned by Get(), t_region has to include GetBaseRegion().
+        // framebuffers without reported region are treated as covering the whole frame
+        void SetDomainOfDefinition(PixelRegion t_region);
+
     private:
         void EnsureResolutionConstraints(std::optional<Framebuffer> t_framebuffer);
         void InstantiateInternalFramebuffer(uint32_t width, uint32_t height, TexturePrecision precision);
         void DestroyInternalFramebuffer();
 
         DoubleBufferedFramebuffer m_internalFramebuffer;
+        // pixels which may be non-transparent in each of the internal framebuffers, std::nullopt if unknown
+        std::optional<PixelRegion> m_writtenRegions[2];
+        PixelRegion m_baseRegion;
     };
 };
\ No newline at end of file
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "raster.h"
+#include "common/common.h"
+
+namespace Raster {
+
+    // picks preview resolution scale from measured render times while playback is running.
+    // scale is quantized to a few steps, so framebuffers of recently used resolutions can be recycled
+    struct ResolutionGovernor {
+        static bool s_enabled;
+        // scale chosen by user, used as an upper bound and whenever playback is paused
+        static float s_maxScale;
+        // size of the displayed preview in pixels, rendering beyond it is wasted
+        static glm::vec2 s_viewportSize;
+
+        // returns scale for the next frame, must only be called from the rendering thread
+        static float GetScale(bool t_playing);
+        // t_renderTime and t_frameBudget are in milliseconds
+        static void ReportRenderTime(float t_renderTime, float t_frameBudget, bool t_playing);
+        // re-renders current frame in full resolution once playback stops
+        static void UpdatePlaybackState(bool t_playing);
+
+        static void Reset();
+    };
+};
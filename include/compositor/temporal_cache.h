@@ -0,0 +1,43 @@
+#pragma once
+
+#include "raster.h"
+#include "common/common.h"
+#include "gpu/gpu.h"
+
+#define TEMPORAL_CACHE_MINIMUM_BUDGET (256ull * 1024 * 1024)
+// upper bound of reservations unless overridden with SetBudget()
+#define TEMPORAL_CACHE_MAXIMUM_BUDGET (2048ull * 1024 * 1024)
+
+namespace Raster {
+
+    struct TemporalCacheStatistics {
+        uint64_t hits, misses;
+        size_t entriesCount, usedBytes, budgetBytes;
+    };
+
+    // keeps upstream results evaluated at other points in time
+    // so time-offset nodes don't execute the same upstream graph again on every frame of linear playback.
+    // must only be used from the rendering thread
+    struct TemporalCache {
+        // identifies result of t_producerPinID at absolute frame t_frame
+        static uint64_t MakeKey(int t_producerPinID, float t_frame, uint64_t t_dependencyHash);
+        // hashes state of every node upstream of t_producerPinID and attributes of their compositions
+        static uint64_t ComputeDependencyHash(int t_producerPinID);
+
+        static std::optional<Framebuffer> GetFramebuffer(uint64_t t_key);
+        // copies attachments of t_framebuffer, returned framebuffer is owned by the cache
+        static Framebuffer PutFramebuffer(uint64_t t_key, Framebuffer& t_framebuffer);
+
+        static std::optional<std::any> GetValue(uint64_t t_key);
+        static void PutValue(uint64_t t_key, std::any t_value);
+
+        // grows budget so that t_entriesCount framebuffers like t_framebuffer fit at once for node t_ownerID
+        static void Reserve(int t_ownerID, Framebuffer& t_framebuffer, int t_entriesCount);
+
+        static TemporalCacheStatistics GetStatistics();
+        // caps budget growth of Reserve()
+        static void SetBudget(size_t t_bytes);
+        // has to be called from the rendering thread, e.g. when another project is opened
+        static void Clear();
+    };
+};
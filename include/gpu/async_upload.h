@@ -10,6 +10,10 @@ namespace Raster {
         Texture texture;
         Texture deleteTexture;
         std::shared_ptr<Image> image;
+        // streamed uploads read the file band by band instead of uploading a decoded image
+        std::optional<std::string> streamPath;
+        int streamLevel;
+        std::string colorSpace;
         bool ready;
         bool executed;
 
@@ -25,6 +29,8 @@ namespace Raster {
         static void UploaderLogic();
 
         static AsyncUploadInfoID GenerateTextureFromImage(std::shared_ptr<Image> t_image);
+        // streams the image reduced by 2^t_level into a texture without holding the whole image in memory
+        static AsyncUploadInfoID GenerateTextureFromImagePath(std::string t_path, int t_level);
         static void DestroyTexture(Texture texture);
 
         static bool IsUploadReady(AsyncUploadInfoID t_id);
@@ -36,7 +42,8 @@ namespace Raster {
         static void SyncPutAsyncUploadInfo(int t_key, AsyncUploadInfo t_info);
         static AsyncUploadInfo& SyncGetAsyncUploadInfo(int t_key);
         static bool SyncIsInfosEmpty();
-        static std::pair<int, AsyncUploadInfo> SyncGetFirstAsyncUploadInfo();
+        static std::optional<std::pair<int, AsyncUploadInfo>> SyncGetFirstAsyncUploadInfo();
+        static std::optional<Texture> StreamTexture(std::string t_path, int t_level, std::string& t_colorSpace);
         static bool SyncAsyncUploadInfoExists(AsyncUploadInfoID t_id);
 
         static bool m_running;
@@ -9,6 +9,8 @@ namespace Raster {
         std::string version;
         int maxTextureSize;
         int maxViewportX, maxViewportY;
+        // GL_EXT_disjoint_timer_query
+        bool timerQueriesSupported;
 
         void* display;
     };
@@ -147,10 +149,17 @@ namespace Raster {
         ArrayBuffer() : handle(nullptr), size(0), usage(ArrayBufferUsage::Static), type(ArrayBufferType::Typical) {}
     };
 
+    // persistent line geometry which can be drawn many times without re-uploading
+    struct LineMesh {
+        ArrayBuffer vertices;
+        int pointsCount;
+
+        LineMesh() : pointsCount(0) {}
+    };
+
     struct GPU {
         static GPUInfo info;
         static Shader s_basicShader;
-        static Pipeline s_kernelPreviewPipeline;
         static Texture s_imageConvolutionPreviewTexture;
 
         static void Initialize();
@@ -174,7 +183,15 @@ namespace Raster {
 
         static void EnableClipping();
         static void DisableClipping();
+        static bool IsClippingEnabled();
         static void SetClipRect(glm::vec2 upperLeft, glm::vec2 bottomRight);
+        // restricts clears and draws to t_rect (x, y, width, height in pixels of bound framebuffer), combined with clip rect.
+        // stays active across BindFramebuffer() calls until reset with std::nullopt
+        static void SetScissorRect(std::optional<glm::ivec4> t_rect);
+
+        // blending is enabled by default, intermediate passes that must write raw values disable it temporarily
+        static void EnableBlending();
+        static void DisableBlending();
 
         static Texture ImportTexture(const char* path);
         static Texture GenerateTexture(uint32_t width, uint32_t height, int channels, TexturePrecision precision = TexturePrecision::Usual, bool mipmapped = false, TextureDimensions dimensions = TextureDimensions::_2D, int depth = 1);
@@ -182,13 +199,18 @@ namespace Raster {
         static void UpdateTexture(Texture texture, uint32_t x, uint32_t y, uint32_t w, uint32_t h, int channels, void* pixels, int z = 0);
         static void DestroyTexture(Texture texture);
         static void BindTextureToShader(Shader shader, std::string name, Texture texture, int unit);
+        static void BindTextureToShader(Shader shader, int location, Texture texture, int unit);
         static void BlitTexture(Texture base, Texture blit);
+        // copies only t_region (x, y, width, height) of blit into the same location of base
+        static void BlitTexture(Texture base, Texture blit, glm::ivec4 t_region);
 
         static Framebuffer GenerateFramebuffer(uint32_t width, uint32_t height, std::vector<Texture> attachments);
         static void DestroyFramebuffer(Framebuffer fbo);
         static void DestroyFramebufferWithAttachments(Framebuffer fbo);
 
         static Shader GenerateShader(ShaderType type, std::string name, bool useBinaryCache = true);
+        // compiles code directly, name is only used as a key for binary cache
+        static Shader GenerateShaderFromSource(ShaderType type, std::string code, std::string name, bool useBinaryCache = true);
 
         // TODO: Implement compute pipeline
         static Pipeline GeneratePipeline(Shader vertexShader, Shader fragmentShader);
@@ -207,6 +229,13 @@ namespace Raster {
         static void SetShaderUniform(Shader shader, std::string name, int size, float* f);
         static void SetShaderUniform(Shader shader, std::string name, int size, int* i);
 
+        // location-based overloads for callers that resolve uniform locations ahead of time
+        static void SetShaderUniform(Shader shader, int location, int i);
+        static void SetShaderUniform(Shader shader, int location, glm::vec4 vec);
+        static void SetShaderUniform(Shader shader, int location, glm::vec3 vec);
+        static void SetShaderUniform(Shader shader, int location, glm::vec2 vec);
+        static void SetShaderUniform(Shader shader, int location, float f);
+
         static void DrawArrays(int count);
 
         // reads pixels from currently bound framebuffer into void* data
@@ -227,7 +256,20 @@ namespace Raster {
         static void SetSamplerTextureWrappingMode(Sampler& sampler, TextureWrappingAxis axis, TextureWrappingMode mode);
         static void DestroySampler(Sampler& sampler);
 
-        static void DrawLines(std::vector<glm::vec2> points, std::vector<glm::vec4> colors, float width, glm::vec2 viewportSize, float antialiasing);
+        // timer queries measure GPU time elapsed between BeginTimerQuery() and EndTimerQuery(), only one may be active at a time
+        static void* GenerateTimerQuery();
+        static void BeginTimerQuery(void* query);
+        static void EndTimerQuery();
+        // nanoseconds, std::nullopt while result is not available yet
+        static std::optional<uint64_t> GetTimerQueryResult(void* query);
+        static void DestroyTimerQuery(void* query);
+
+        static void DrawLines(const std::vector<glm::vec2>& points, const std::vector<glm::vec4>& colors, float width, glm::vec2 viewportSize, float antialiasing);
+
+        // `points` are pairs of NDC segment endpoints, `colors` are matched 1:1 with `points`
+        static void UpdateLineMesh(LineMesh& mesh, const std::vector<glm::vec2>& points, const std::vector<glm::vec4>& colors, float width);
+        static void DrawLineMesh(LineMesh& mesh, glm::vec2 viewportSize, float antialiasing);
+        static void DestroyLineMesh(LineMesh& mesh);
 
         static std::string TextureFilteringOperationToString(TextureFilteringOperation operation) {
             switch (operation) {
@@ -262,7 +304,8 @@ namespace Raster {
 
 
         static void DestroyShader(Shader shader);
-        static void DestroyPipeline(Pipeline pipeline);
+        // pass destroyShaders = false for pipelines built from shared shaders
+        static void DestroyPipeline(Pipeline pipeline, bool destroyShaders = true);
 
         // e.g. "shaders/api/"
         static std::string GetShadersPath();
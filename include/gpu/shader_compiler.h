@@ -0,0 +1,23 @@
+#pragma once
+
+#include "raster.h"
+#include "gpu.h"
+
+namespace Raster {
+
+    // compiles shaders on a background GPU context, so rendering never stalls on driver compilation.
+    // shaders are shared between contexts, pipelines are not, so callers build pipelines themselves once shaders are ready
+    struct ShaderCompiler {
+        static void Initialize();
+        static void Terminate();
+
+        // returns std::nullopt while shader is being compiled, throws std::runtime_error if compilation failed.
+        // repeated requests return the same shader, so it must not be destroyed by caller
+        static std::optional<Shader> Request(ShaderType t_type, std::string t_name, bool t_useBinaryCache = true);
+        // same as Request(), but compiles generated code. t_cacheName enables binary cache for the generated code
+        static std::optional<Shader> RequestSource(ShaderType t_type, std::string t_code, std::string t_cacheName = "");
+
+        // number of shaders queued or being compiled right now
+        static int GetPendingCount();
+    };
+};
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "raster.h"
+#include "gpu.h"
+#include "async_upload.h"
+
+namespace Raster {
+
+    enum class TextureCacheTransform {
+        None, ExrGammaCorrection
+    };
+
+    struct TextureCacheStatistics {
+        uint64_t hits, misses, deduplicatedLoads;
+        size_t entriesCount, referencedBytes, releasedBytes, budgetBytes;
+    };
+
+    // keeps its entry alive while at least one handle exists
+    struct TextureCacheHandle {
+        std::string key;
+
+        TextureCacheHandle(std::string t_key) : key(t_key) {}
+        ~TextureCacheHandle();
+    };
+
+    using SharedTextureHandle = std::shared_ptr<TextureCacheHandle>;
+
+    // process-wide storage of textures loaded from disk
+    // entries are keyed by canonical path, modification time, file size, reduction level and transform,
+    // so edited files are reloaded and identical requests share one load and one texture.
+    // textures without handles stay resident until they fall out of the LRU budget
+    struct TextureCache {
+        static SharedTextureHandle Acquire(std::string t_path, int t_level = 0, TextureCacheTransform t_transform = TextureCacheTransform::None);
+
+        // polls in-flight loads, must be called from a thread with a rendering context
+        static std::optional<Texture> GetTexture(const SharedTextureHandle& t_handle);
+        static std::optional<std::string> GetColorSpace(const SharedTextureHandle& t_handle);
+        static bool IsLoading(const SharedTextureHandle& t_handle);
+
+        static TextureCacheStatistics GetStatistics();
+        static void SetBudget(size_t t_bytes);
+
+        static Texture ApplyTransform(Texture t_texture, TextureCacheTransform t_transform);
+
+    private:
+        friend struct TextureCacheHandle;
+        static void Release(const std::string& t_key);
+        static void PollUploads();
+        static void EvictReleasedEntries();
+    };
+};
@@ -16,15 +16,41 @@ namespace Raster {
         std::vector<uint8_t> data;
         uint32_t width; uint32_t height;
         int channels;
+        int level; // 0 for full resolution, n for an image reduced by 2^n
         std::string colorSpace;
 
         Image();
     };
 
+    // format and dimensions of an image file, read without decoding its pixels
+    struct ImageDescription {
+        ImagePrecision precision;
+        uint32_t width; uint32_t height;
+        int channels;
+        int mipLevels;
+        std::string colorSpace;
+    };
+
     struct ImageLoader {
     public:
         static std::optional<Image> Load(std::string t_path);
 
+        static std::optional<ImageDescription> Describe(std::string t_path);
+
+        // reads rows [t_y, t_y + t_rows) of the image reduced by 2^t_level in both dimensions
+        // stored mip levels are used when present, missing ones are box-filtered from the closest stored level
+        // pixels are pulled through a shared tile cache, so memory usage stays within its budget
+        static std::optional<Image> LoadRegion(std::string t_path, int t_level, uint32_t t_y, uint32_t t_rows);
+        static std::optional<Image> LoadLevel(std::string t_path, int t_level);
+
+        // smallest reduction level whose largest side still covers t_maxDimension
+        static int GetLevelForDimension(const ImageDescription& t_description, uint32_t t_maxDimension);
+        static glm::uvec2 GetLevelSize(const ImageDescription& t_description, int t_level);
+
+        static void SetCacheMemoryBudget(float t_megabytes);
+        // drops cached tiles and closes the file handle, must be called before the file is removed
+        static void ReleaseFile(std::string t_path);
+
         static std::string GetImplementationName();
         static std::vector<std::string> GetSupportedExtensions();
     };
@@ -38,6 +64,8 @@ namespace Raster {
     public:
         AsyncImageLoader();
         AsyncImageLoader(std::string t_path);
+        // loads a reduced image whose largest side is close to t_maxDimension
+        AsyncImageLoader(std::string t_path, uint32_t t_maxDimension);
 
         bool IsReady();
         bool IsInitialized();
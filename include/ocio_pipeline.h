@@ -17,6 +17,13 @@ namespace Raster {
         std::string samplerName;
     };
 
+    // accuracy of a transform that was baked into a 3d lut
+    struct OCIOBakeStatistics {
+        int edgeLength;
+        float maxError, averageError;
+        float bakeMilliseconds;
+    };
+
     struct OCIOPipeline {
         uint8_t* pixels;
         std::unique_ptr<OCIO::PackedImageDesc> img;
@@ -28,9 +35,10 @@ namespace Raster {
         bool gpuPipeline;
         std::vector<OCIOTexture> textures;
         std::unordered_map<std::string, OCIO::GpuShaderDesc::UniformData> uniforms;
+        std::optional<OCIOBakeStatistics> bakeStatistics;
 
-        OCIOPipeline() : valid(false) {}
-        OCIOPipeline(OCIO::ConstTransformRcPtr t_transform, bool t_gpuPipeline = true) {
+        OCIOPipeline() : pixels(nullptr), valid(false), gpuPipeline(false) {}
+        OCIOPipeline(OCIO::ConstTransformRcPtr t_transform, bool t_gpuPipeline = true) : pixels(nullptr), valid(false), gpuPipeline(false) {
             try {
                 processor = ColorManagement::s_config->getProcessor(t_transform);
                 if (t_gpuPipeline) {
@@ -166,6 +166,21 @@ namespace Raster {
         return buffer;
     }
 
+    // content hashing used by caches that need to detect changes of plain data
+    static uint64_t HashBytes(const void* t_data, size_t t_size) {
+        return unordered_dense::detail::wyhash::hash(t_data, t_size);
+    }
+
+    template <typename T>
+    static uint64_t HashValue(const T& t_value) {
+        static_assert(std::is_trivially_copyable_v<T>, "HashValue() expects trivially copyable types");
+        return HashBytes(&t_value, sizeof(T));
+    }
+
+    static uint64_t HashCombine(uint64_t t_seed, uint64_t t_value) {
+        return unordered_dense::detail::wyhash::hash(t_seed ^ (t_value + 0x9E3779B97F4A7C15ULL + (t_seed << 6) + (t_seed >> 2)));
+    }
+
     template <typename T>
     static bool IsInBounds(const T& value, const T& low, const T& high) {
         return !(value < low) && (value < high);
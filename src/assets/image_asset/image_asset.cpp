@@ -1,39 +1,43 @@
 #include "image_asset.h"
 #include "raster.h"
 #include "common/asset_id.h"
+#include "common/project_archive.h"
+#include "compositor/compositor.h"
+#include "compositor/resolution_governor.h"
 #include "../../attributes/transform2d_attribute/transform2d_attribute.h"
 
 namespace Raster {
 
-    std::optional<Pipeline> ImageAsset::s_gammaPipeline;
-
     ImageAsset::ImageAsset() {
         AssetBase::Initialize();
 
         this->m_uploadID = 0;
+        this->m_streamLevel = 0;
+        this->m_textureLevel = 0;
         this->m_texture = std::nullopt;
+        this->m_proxyTexture = std::nullopt;
         this->m_asyncCopy = std::nullopt;
         this->m_loader = AsyncImageLoader();
 
         this->m_relativePath = "";
         this->m_originalPath = "";
         this->colorSpace = "";
-
-        if (!s_gammaPipeline.has_value()) {
-            s_gammaPipeline = GPU::GeneratePipeline(
-                GPU::s_basicShader,
-                GPU::GenerateShader(ShaderType::Fragment, "exr_gamma_correction/shader")
-            );
-        }
     }
 
+    // largest side of the proxy shown while full resolution image is being streamed
+    static constexpr uint32_t s_proxyDimension = 512;
+
     bool ImageAsset::AbstractIsReady() {
-        if (m_texture.has_value()) return true;
+        if (m_texture.has_value()) {
+            UpdateStreamedTexture();
+            return true;
+        }
         if (m_asyncCopy.has_value() && !IsFutureReady(m_asyncCopy.value())) return false;
-        if (!std::filesystem::exists(FormatString("%s/%s", Workspace::GetProject().path.c_str(), m_relativePath.c_str()))) return false;
+        // images are decoded through OIIO's file based cache, so they are extracted from the archive first
+        if (!ProjectArchive::RequestExtraction(GetAbsolutePath())) return false;
 
         if (!m_loader.IsInitialized() && !m_uploadID) {
-            m_loader = AsyncImageLoader(FormatString("%s/%s", Workspace::GetProject().path.c_str(), m_relativePath.c_str()));
+            m_loader = AsyncImageLoader(GetAbsolutePath(), s_proxyDimension);
         }
 
         if (m_loader.IsInitialized() && m_loader.IsReady()) {
@@ -41,50 +45,59 @@ namespace Raster {
             if (imageCandidate.has_value()) {
                 auto& image = imageCandidate.value();
                 colorSpace = image->colorSpace;
+                m_textureLevel = image->level;
                 DUMP_VAR(colorSpace);
 
-                TexturePrecision precision = TexturePrecision::Usual;
-                if (image->precision == ImagePrecision::Half) precision = TexturePrecision::Half;
-                if (image->precision == ImagePrecision::Full) precision = TexturePrecision::Full;
-
                 if (!m_uploadID) {
                     m_uploadID = AsyncUpload::GenerateTextureFromImage(image);
-                    m_loader = AsyncImageLoader();   
+                    m_loader = AsyncImageLoader();
                 }
             }
         }
         if (AsyncUpload::IsUploadReady(m_uploadID)) {
             auto info = AsyncUpload::GetUpload(m_uploadID);
-            m_texture = info.texture;
-
-            // DUMP_VAR(GetExtension(m_relativePath));
-            // RASTER_LOG("UPLOAD IS READY");
-            if (s_gammaPipeline.has_value() && GetExtension(m_relativePath) == ".exr") {
-                // RASTER_LOG("EXR GAMMA CORRECTION");
-                auto& pipeline = s_gammaPipeline.value();
-                Texture gammaTexture = GPU::GenerateTexture(info.texture.width, info.texture.height, info.texture.channels, info.texture.precision);
-                Framebuffer gammaFbo = GPU::GenerateFramebuffer(info.texture.width, info.texture.height, {gammaTexture});
-
-                GPU::BindFramebuffer(gammaFbo);
-                GPU::BindPipeline(pipeline);
-                GPU::ClearFramebuffer(0, 0, 0, 0);
-
-                GPU::SetShaderUniform(pipeline.fragment, "uResolution", glm::vec2(info.texture.width, info.texture.height));
-                GPU::BindTextureToShader(pipeline.fragment, "uTexture", info.texture, 0);
+            m_proxyTexture = TextureCache::ApplyTransform(info.texture, GetTextureTransform());
+            m_texture = m_proxyTexture;
+            AsyncUpload::DestroyUpload(m_uploadID);
+        }
 
-                GPU::DrawArrays(3);
+        return false;
+    }
 
-                GPU::BindFramebuffer(std::nullopt);
-                GPU::DestroyTexture(info.texture);
-                GPU::DestroyFramebuffer(gammaFbo);
-                m_texture = gammaTexture;
+    void ImageAsset::UpdateStreamedTexture() {
+        // follows the scale chosen by user rather than the governed one, which fluctuates during playback and would thrash the stream.
+        // 1.0 preview scale wants the full image, 0.5 is satisfied by half resolution, and so on
+        int desiredLevel = std::max((int) std::floor(std::log2(1.0f / std::clamp(ResolutionGovernor::s_maxScale, 0.01f, 1.0f))), 0);
+
+        if (m_streamHandle && m_streamLevel == desiredLevel) {
+            auto textureCandidate = TextureCache::GetTexture(m_streamHandle);
+            if (!textureCandidate.has_value()) return;
+            m_texture = textureCandidate;
+            m_textureLevel = m_streamLevel;
+            m_textureHandle = std::move(m_streamHandle);
+            if (m_proxyTexture.has_value()) {
+                GPU::DestroyTexture(m_proxyTexture.value());
+                m_proxyTexture = std::nullopt;
             }
+            return;
+        }
 
-            
-            AsyncUpload::DestroyUpload(m_uploadID);
+        if (desiredLevel == m_textureLevel) {
+            m_streamHandle = nullptr;
+            return;
         }
 
-        return false;
+        // levels already loaded by another asset or node come straight from the cache
+        m_streamLevel = desiredLevel;
+        m_streamHandle = TextureCache::Acquire(GetAbsolutePath(), desiredLevel, GetTextureTransform());
+    }
+
+    TextureCacheTransform ImageAsset::GetTextureTransform() {
+        return GetExtension(m_relativePath) == ".exr" ? TextureCacheTransform::ExrGammaCorrection : TextureCacheTransform::None;
+    }
+
+    std::string ImageAsset::GetAbsolutePath() {
+        return FormatString("%s/%s", Workspace::GetProject().path.c_str(), m_relativePath.c_str());
     }
 
     void ImageAsset::AbstractOnTimelineDrop(float t_frame) {
@@ -166,8 +179,8 @@ namespace Raster {
 
     std::optional<std::uintmax_t> ImageAsset::AbstractGetSize() {
         if (m_cachedSize.has_value()) return m_cachedSize;
-        if (std::filesystem::exists(FormatString("%s/%s", Workspace::GetProject().path.c_str(), m_relativePath.c_str()))) {
-            m_cachedSize = std::filesystem::file_size(FormatString("%s/%s", Workspace::GetProject().path.c_str(), m_relativePath.c_str()));
+        if (ProjectArchive::Exists(GetAbsolutePath())) {
+            m_cachedSize = ProjectArchive::GetFileSize(GetAbsolutePath());
             return m_cachedSize;
         }
         return std::nullopt;
@@ -221,14 +234,19 @@ namespace Raster {
     }
 
     void ImageAsset::AbstractDelete() {
+        ImageLoader::ReleaseFile(GetAbsolutePath());
         if (std::filesystem::exists(FormatString("%s/%s", Workspace::GetProject().path.c_str(), m_relativePath.c_str()))) {
             std::filesystem::remove(FormatString("%s/%s", Workspace::GetProject().path.c_str(), m_relativePath.c_str()));
         }
+        ProjectArchive::Forget(GetAbsolutePath());
 
-        auto textureCandidate = AbstractGetPreviewTexture();
-        if (textureCandidate.has_value()) {
-            GPU::DestroyTexture(textureCandidate.value());
+        if (m_proxyTexture.has_value()) {
+            GPU::DestroyTexture(m_proxyTexture.value());
         }
+        m_proxyTexture = std::nullopt;
+        m_texture = std::nullopt;
+        m_textureHandle = nullptr;
+        m_streamHandle = nullptr;
     }
 };
 
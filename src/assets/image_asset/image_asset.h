@@ -2,6 +2,7 @@
 
 #include "common/asset_base.h"
 #include "gpu/async_upload.h"
+#include "gpu/texture_cache.h"
 #include "gpu/gpu.h"
 #include "../../ImGui/imgui.h"
 
@@ -30,17 +31,26 @@ namespace Raster {
 
         void AbstractOnTimelineDrop(float t_frame);
 
+        // swaps the texture for a higher or lower resolution one when preview resolution changes
+        void UpdateStreamedTexture();
+        TextureCacheTransform GetTextureTransform();
+        std::string GetAbsolutePath();
+
         std::string m_relativePath;
         std::string m_originalPath;
 
         AsyncUploadInfoID m_uploadID;
+        SharedTextureHandle m_textureHandle;
+        SharedTextureHandle m_streamHandle;
+        int m_streamLevel;
         AsyncImageLoader m_loader;
+        int m_textureLevel;
 
         std::optional<std::future<bool>> m_asyncCopy;
 
+        // m_texture is either the owned proxy or borrowed from the texture cache through m_textureHandle
         std::optional<Texture> m_texture;
+        std::optional<Texture> m_proxyTexture;
         std::optional<std::uintmax_t> m_cachedSize;
-
-        static std::optional<Pipeline> s_gammaPipeline;
     };
 };
\ No newline at end of file
@@ -7,6 +7,8 @@
 #include <variant>
 #include "common/asset_id.h"
 #include "common/waveform_manager.h"
+#include "common/project_archive.h"
+#include "../../common/project_archive_io.h"
 #include "../../attributes/transform2d_attribute/transform2d_attribute.h"
 
 extern "C" {
@@ -43,6 +45,7 @@ namespace Raster {
         if (std::filesystem::exists(absolutePath) && !std::filesystem::is_directory(absolutePath)) {
             std::filesystem::remove(absolutePath);
         }
+        ProjectArchive::Forget(absolutePath);
     }
 
     bool MediaAsset::AbstractIsReady() {
@@ -53,10 +56,11 @@ namespace Raster {
             m_waveformFuture = std::nullopt;
         }
         if (m_formatCtxWasOpened) return true;
+        std::shared_ptr<av::CustomIO> archiveIO;
         av::FormatContext formatCtx;
-        if (std::filesystem::exists(absolutePath) && !std::filesystem::is_directory(absolutePath) && !formatCtx.isOpened() && !m_formatCtxWasOpened) {
+        if (ProjectArchive::Exists(absolutePath) && !std::filesystem::is_directory(absolutePath) && !formatCtx.isOpened() && !m_formatCtxWasOpened) {
             std::error_code ec;
-            formatCtx.openInput(absolutePath, ec);
+            OpenProjectInput(formatCtx, archiveIO, absolutePath, ec);
             if (ec) {
                 std::cout << "failed to open formatCtx " << av::error2string(ec.value()) << std::endl;
             } 
@@ -173,8 +177,9 @@ namespace Raster {
     }
 
     AudioWaveformData MediaAsset::CalculateWaveformsForPath(std::string t_path) {
+        std::shared_ptr<av::CustomIO> archiveIO;
         av::FormatContext formatCtx;
-        formatCtx.openInput(t_path);
+        OpenProjectInput(formatCtx, archiveIO, t_path);
         if (!formatCtx.isOpened()) return AudioWaveformData();
         AudioWaveformData waveformData;
         waveformData.streamData = std::make_shared<std::vector<std::vector<float>>>();
@@ -509,8 +514,8 @@ namespace Raster {
         if (m_cachedSize.has_value()) {
             return m_cachedSize;
         }
-        if (std::filesystem::exists(FormatString("%s/%s", Workspace::GetProject().path.c_str(), m_relativePath.c_str()))) {
-            m_cachedSize = std::filesystem::file_size(FormatString("%s/%s", Workspace::GetProject().path.c_str(), m_relativePath.c_str()));
+        if (ProjectArchive::Exists(FormatString("%s/%s", Workspace::GetProject().path.c_str(), m_relativePath.c_str()))) {
+            m_cachedSize = ProjectArchive::GetFileSize(FormatString("%s/%s", Workspace::GetProject().path.c_str(), m_relativePath.c_str()));
             return m_cachedSize;
         }
         return std::nullopt;
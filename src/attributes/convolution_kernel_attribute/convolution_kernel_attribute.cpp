@@ -2,6 +2,7 @@
 #include "common/convolution_kernel.h"
 #include "common/localization.h"
 #include "common/ui_helpers.h"
+#include "compositor/convolution.h"
 #include "font/IconsFontAwesome5.h"
 #include "convolution_kernel_attribute.h"
 #include "common/dispatchers.h"
@@ -48,23 +49,16 @@ namespace Raster {
         }
         if (ImGui::BeginPopup("##editKernel")) {
             ImGui::SeparatorText(FormatString("%s %s: %s", ICON_FA_IMAGE, Localization::GetString("EDIT_VALUE").c_str(), name.c_str()).c_str());
-            if (GPU::s_imageConvolutionPreviewTexture.handle && GPU::s_kernelPreviewPipeline.handle) {
+            if (GPU::s_imageConvolutionPreviewTexture.handle) {
                 static Framebuffer s_previewFramebuffer;
                 auto& previewTexture = GPU::s_imageConvolutionPreviewTexture;
                 if (!s_previewFramebuffer.handle) {
                     s_previewFramebuffer = GPU::GenerateFramebuffer(previewTexture.width, previewTexture.height, {GPU::GenerateTexture(previewTexture.width, previewTexture.height, 3)});
                 }
-                static std::optional<glm::mat3> s_lastRenderedKernel = std::nullopt;
-                if (!s_lastRenderedKernel || (s_lastRenderedKernel && *s_lastRenderedKernel != kernel.GetKernel())) {
-                    GPU::BindPipeline(GPU::s_kernelPreviewPipeline);
-                    GPU::BindFramebuffer(s_previewFramebuffer);
-                    GPU::ClearFramebuffer(0, 0, 0, 1);
-                    GPU::SetShaderUniform(GPU::s_kernelPreviewPipeline.fragment, "uResolution", glm::vec2(s_previewFramebuffer.width, s_previewFramebuffer.height));
-                    GPU::SetShaderUniform(GPU::s_kernelPreviewPipeline.fragment, "uKernel", kernel.GetKernel());
-                    GPU::BindTextureToShader(GPU::s_kernelPreviewPipeline.fragment, "uBase", previewTexture, 0);
-                    GPU::DrawArrays(3);
-                    // RASTER_LOG("rendering kernel preview");
-                    s_lastRenderedKernel = kernel.GetKernel();
+                static std::optional<ConvolutionKernel> s_lastRenderedKernel = std::nullopt;
+                if (!s_lastRenderedKernel || (s_lastRenderedKernel && *s_lastRenderedKernel != kernel)) {
+                    Convolution::Apply(s_previewFramebuffer, previewTexture, kernel);
+                    s_lastRenderedKernel = kernel;
                 }
                 auto fitSize = FitRectInRect(ImVec2(200, 200), ImVec2(previewTexture.width, previewTexture.height));
                 ImGui::SetCursorPosX(ImGui::GetWindowSize().x / 2.0f - fitSize.x / 2.0f);
@@ -79,12 +73,7 @@ namespace Raster {
             ImGui::PopItemWidth();
             if (ImGui::IsItemEdited()) isItemEdited = true;
             ImGui::PushItemWidth(ImGui::GetContentRegionAvail().x);
-                ImGui::DragFloat3("##kernel0", glm::value_ptr(kernel.kernel[0]), 1);
-                if (ImGui::IsItemEdited()) isItemEdited = true;
-                ImGui::DragFloat3("##kernel1", glm::value_ptr(kernel.kernel[1]), 1);
-                if (ImGui::IsItemEdited()) isItemEdited = true;
-                ImGui::DragFloat3("##kernel2", glm::value_ptr(kernel.kernel[2]), 1);
-                if (ImGui::IsItemEdited()) isItemEdited = true;
+                if (UIHelpers::RenderConvolutionKernelEditor(kernel)) isItemEdited = true;
             ImGui::PopItemWidth();
             static bool s_searchFocused = false;
             if (ImGui::BeginMenu(FormatString("%s %s", ICON_FA_IMAGE, Localization::GetString("KERNEL_PRESETS").c_str()).c_str())) {
@@ -100,6 +100,7 @@ namespace Raster {
                 vector.a = 1.0f;
                 keyframe.value = vector;
             }
+            InvalidateKeyframes();
         }
         ImGui::Separator();
     }
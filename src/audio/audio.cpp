@@ -12,6 +12,7 @@
 #include "common/workspace.h"
 #include "common/audio_info.h"
 #include "common/threads.h"
+#include "common/profiler.h"
 #include "audio/time_stretcher.h"
 
 namespace Raster {
@@ -28,22 +29,20 @@ namespace Raster {
     static std::optional<AudioDiscretizationOptions> s_internalAudioOptions;
 
     static int PerformAudioPass() {
+        RASTER_PROFILE_ZONE("Audio Pass");
         auto& project = Workspace::GetProject();
         auto& buses = project.audioBuses;
-        int mainBusID = -1;
+        auto& routing = project.audioBusRouting;
+        int samplesCount = AudioInfo::s_periodSize * AudioInfo::s_channels;
 
         auto firstTime = std::chrono::high_resolution_clock::now();
 
         // restoring the main audio bus to the default value
         project.audioBusesMutex->lock();
+        routing.Update(buses);
         for (auto& bus : buses) {
-            if (bus.samples.size() != AudioInfo::s_periodSize * AudioInfo::s_channels) {
-                bus.samples.resize(AudioInfo::s_periodSize * AudioInfo::s_channels);
-            }
-            if (bus.main) mainBusID = bus.id;
-            for (int i = 0; i < AudioInfo::s_periodSize * AudioInfo::s_channels; i++) {
-                bus.samples[i] = 0.0f;
-            }
+            bus.ValidateBuffers();
+            std::fill(bus.samples.begin(), bus.samples.end(), 0.0f);
         }
         project.audioBusesMutex->unlock();
 
@@ -60,19 +59,26 @@ namespace Raster {
 
         project.audioBusesMutex->lock();
 
-        // redirecting audio buses
-        for (auto& bus : buses) {
-            if (!bus.main && bus.redirectID >= 0) {
-                auto redirectBusCandidate = Workspace::GetAudioBusByID(bus.redirectID);
-                if (redirectBusCandidate.has_value()) {
-                    auto& redirectBus = redirectBusCandidate.value();
-                    if (redirectBus->samples.size() > 0 && bus.samples.size() > 0) {
-                        for (int i = 0; i < AudioInfo::s_periodSize * AudioInfo::s_channels; i++) {
-                            redirectBus->samples[i] += bus.samples[i];
-                        }
-                    }
+        // buses may have been edited during traversal
+        routing.Update(buses);
+
+        // mixing buses into their destinations in dependency order, so chained submixes are complete
+        // by the time they're forwarded further
+        for (auto busIndex : routing.order) {
+            auto& bus = buses[busIndex];
+            if (bus.main) {
+                if (bus.muted) {
+                    std::fill(bus.samples.begin(), bus.samples.end(), 0.0f);
+                } else if (bus.gain != 1.0f) {
+                    for (auto& sample : bus.samples) sample *= bus.gain;
                 }
+                continue;
             }
+            int destinationIndex = routing.destinations[busIndex];
+            if (destinationIndex < 0 || bus.muted || bus.gain == 0.0f) continue;
+            auto& destination = buses[destinationIndex];
+            if (bus.samples.size() < samplesCount || destination.samples.size() < samplesCount) continue;
+            AudioBus::AccumulateSamples(destination.samples.data(), bus.samples.data(), samplesCount, bus.gain);
         }
         project.audioBusesMutex->unlock();
         AudioInfo::s_audioPassID++;
@@ -97,7 +103,9 @@ namespace Raster {
     }
 
     static void raster_data_callback(ma_device* t_device, void* t_output, const void* t_input, ma_uint32 t_frameCount) {
+        if (Threads::s_audioThreadID != std::this_thread::get_id()) Profiler::SetThreadName("Audio");
         Threads::s_audioThreadID = std::this_thread::get_id();
+        RASTER_PROFILE_ZONE("Audio Callback");
         float* fOutput = (float*) t_output;
         auto allowedMsPerCall = (1.0 / ((double) AudioInfo::s_sampleRate / (double) AudioInfo::s_periodSize)) * 1000 / 2;
         if (s_slowedDownAudioPass.has_value() && IsFutureReady(s_slowedDownAudioPass.value())) {
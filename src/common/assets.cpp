@@ -4,24 +4,27 @@ namespace Raster {
     std::vector<AssetImplementation> Assets::s_implementations;
 
     void Assets::Initialize() {
-        if (!std::filesystem::exists("assets/")) {
-            std::filesystem::create_directory("assets");
-        }
-        auto iterator = std::filesystem::directory_iterator("assets");
-        for (auto &entry : iterator) {
-            std::string transformedPath = std::regex_replace(
-                GetBaseName(entry.path().string()), std::regex(".dll|.so|lib"), "");
-            Libraries::LoadLibrary("assets", transformedPath);
+        auto libraries = Libraries::Discover("assets", "", [](std::string t_key) -> Json {
+            auto description = Libraries::GetFunction<AssetDescription()>(t_key, "GetDescription")();
+            return {
+                {"PrettyName", description.prettyName},
+                {"PackageName", description.packageName},
+                {"Icon", description.icon},
+                {"Extensions", description.extensions}
+            };
+        });
+        for (auto& library : libraries) {
             AssetImplementation implementation;
-            implementation.description = Libraries::GetFunction<AssetDescription()>(transformedPath, "GetDescription")();
-            implementation.spawn = Libraries::GetFunction<AbstractAsset()>(transformedPath, "SpawnAsset");
-            try {
-                Libraries::GetFunction<void()>(transformedPath, "OnStartup")();
-            } catch (internalDylib::exception ex) {
-                // skip
-            }
+            implementation.description.prettyName = library.description["PrettyName"].get<std::string>();
+            implementation.description.packageName = library.description["PackageName"].get<std::string>();
+            implementation.description.icon = library.description["Icon"].get<std::string>();
+            implementation.description.extensions = library.description["Extensions"].get<std::vector<std::string>>();
+            implementation.spawn = [key = library.key]() {
+                Libraries::LoadLibrary("assets", key);
+                return Libraries::GetFunction<AbstractAsset()>(key, "SpawnAsset")();
+            };
             s_implementations.push_back(implementation);
-            std::cout << "loading asset '" << implementation.description.packageName << "'" << std::endl;
+            std::cout << "registering asset '" << implementation.description.packageName << "'" << std::endl;
         }
     }
 
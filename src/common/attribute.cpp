@@ -23,6 +23,7 @@ namespace Raster {
     };
 
     static std::vector<int> s_deletedAttributes;
+    std::atomic<uint64_t> AttributeBase::s_keyframesRevision = 1;
     static std::vector<AttributeDuplicateBundle> s_duplicatedAttributes;
 
     static void DrawRect(RectBounds bounds, ImVec4 color) {
@@ -82,47 +83,49 @@ namespace Raster {
         };
     }
 
-    std::any AttributeBase::Get(float t_frame, Composition* t_composition) {
-        this->composition = t_composition;
-        SortKeyframes();
-        auto& project = Workspace::s_project.value();
-
-        int targetKeyframeIndex = -1;
+    int AttributeBase::FindSegment(float t_frame, int t_hint) {
+        // segment is identified by the first keyframe located after t_frame
         int keyframesLength = keyframes.size();
-        float renderViewTime = t_frame;
-
-        for (int i = 0; i < keyframesLength; i++) {
-            float keyframeTimestamp = keyframes[i].timestamp;
-            if (renderViewTime < keyframeTimestamp) {
-                targetKeyframeIndex = i;
-                break;
-            }
-        }
+        auto isSegment = [&](int t_index) {
+            if (t_index < 0 || t_index > keyframesLength) return false;
+            bool afterBegin = t_index == 0 || keyframes[t_index - 1].timestamp <= t_frame;
+            bool beforeEnd = t_index == keyframesLength || t_frame < keyframes[t_index].timestamp;
+            return afterBegin && beforeEnd;
+        };
+        if (isSegment(t_hint)) return t_hint;
+        if (isSegment(t_hint + 1)) return t_hint + 1;
+        auto upper = std::upper_bound(keyframes.begin(), keyframes.end(), t_frame, [](float frame, const AttributeKeyframe& keyframe) {
+            return frame < keyframe.timestamp;
+        });
+        return upper - keyframes.begin();
+    }
 
-        if (targetKeyframeIndex == -1) {
+    std::any AttributeBase::InterpolateSegment(int t_segment, float t_frame, Composition* t_composition) {
+        if (t_segment >= (int) keyframes.size()) {
             return AbstractInterpolate(keyframes.back().value, keyframes.back().value, 0.0f, 0.0f, composition);
         }
 
-        if (targetKeyframeIndex == 0) {
+        if (t_segment == 0) {
             return AbstractInterpolate(keyframes.front().value, keyframes.front().value, 0.0f, 0.0f, composition);
         }
 
-        float keyframeTimestamp = keyframes[targetKeyframeIndex].timestamp;
-        float interpolationPercentage = 0;
-        if (targetKeyframeIndex == 1) {
-            interpolationPercentage = renderViewTime / keyframeTimestamp;
-        } else {
-            float previousFrame = keyframes[targetKeyframeIndex - 1].timestamp;
-            interpolationPercentage = (renderViewTime - previousFrame) / (keyframeTimestamp - previousFrame);
+        auto& beginKeyframe = keyframes[t_segment - 1];
+        auto& endKeyframe = keyframes[t_segment];
+        float interpolationPercentage = (t_frame - beginKeyframe.timestamp) / (endKeyframe.timestamp - beginKeyframe.timestamp);
+        if (endKeyframe.easing.has_value()) {
+            interpolationPercentage = endKeyframe.easing.value()->Get(interpolationPercentage);
         }
 
-        auto& beginKeyframeValue = keyframes[targetKeyframeIndex - 1].value;
-        auto& endkeyframeValue = keyframes[targetKeyframeIndex].value;
-        if (keyframes[targetKeyframeIndex].easing.has_value()) {
-            interpolationPercentage = keyframes[targetKeyframeIndex].easing.value()->Get(interpolationPercentage);
-        }
+        return AbstractInterpolate(beginKeyframe.value, endKeyframe.value, interpolationPercentage, t_frame, t_composition);
+    }
 
-        return AbstractInterpolate(beginKeyframeValue, endkeyframeValue, interpolationPercentage, t_frame, t_composition);
+    std::any AttributeBase::Get(float t_frame, Composition* t_composition) {
+        this->composition = t_composition;
+        SortKeyframes();
+
+        int segment = FindSegment(t_frame, m_segmentHint.load(std::memory_order_relaxed));
+        m_segmentHint.store(segment, std::memory_order_relaxed);
+        return InterpolateSegment(segment, t_frame, t_composition);
     }
 
     static bool s_legendFocused = false;
@@ -168,6 +171,7 @@ namespace Raster {
                             bool isEasingSelected = nextKeyframe.easing.has_value() && nextKeyframe.easing.value()->packageName == implementation.description.packageName;
                             if (ImGui::MenuItem(FormatString("%s%s %s", isEasingSelected ? ICON_FA_CHECK " " : "", ICON_FA_BEZIER_CURVE, implementation.description.prettyName.c_str()).c_str())) {
                                 nextKeyframe.easing = Easings::InstantiateEasing(implementation.description.packageName);
+                                InvalidateKeyframes();
                             }
                         }
                     }
@@ -330,6 +334,7 @@ namespace Raster {
             ImGui::EndPopup();
         } else renameFieldFocused = false;
 
+        if (shouldAddKeyframe) InvalidateKeyframes();
         if (shouldAddKeyframe && keyframes.size() == 1 && !buttonPressed) {
             keyframes[0].value = currentValue;
         } else if (shouldAddKeyframe && !KeyframeExists(currentFrame)) {
@@ -390,22 +395,35 @@ namespace Raster {
         }
     }
 
+    void AttributeBase::InvalidateKeyframes() {
+        s_keyframesRevision++;
+    }
+
     void AttributeBase::SortKeyframes() {
-        for (int step = 0; step < keyframes.size() - 1; ++step) {
-            for (int i = 1; i < keyframes.size() - step - 1; ++i) {
-                if (keyframes[i].timestamp > keyframes[i + 1].timestamp ) {
-                    std::swap(keyframes[i], keyframes[i + 1]);
-                }
-            }
+        // keyframes can only become unordered through an edit, which bumps the revision.
+        // revision is read before checking, so edits made meanwhile are checked again next time
+        uint64_t revision = s_keyframesRevision;
+        if (m_sortedRevision == revision) return;
+        m_sortedRevision = revision;
+
+        auto isOrdered = [](const AttributeKeyframe& a, const AttributeKeyframe& b) {
+            return a.timestamp < b.timestamp && int(a.timestamp) != int(b.timestamp);
+        };
+        bool ordered = true;
+        for (size_t i = 1; i < keyframes.size() && ordered; i++) {
+            ordered = isOrdered(keyframes[i - 1], keyframes[i]);
         }
+        if (ordered) return;
 
-        for (int i = 0; i < keyframes.size(); i++) {
-            AttributeKeyframe& stamp = keyframes.at(i);
-            for (int j = i + 1; j < keyframes.size(); j++) {
-                if (int(stamp.timestamp) ==
-                    int(keyframes[j].timestamp)) {
-                    stamp.timestamp = int(keyframes[j].timestamp) + 1;
-                }
+        std::stable_sort(keyframes.begin(), keyframes.end(), [](auto& a, auto& b) {
+            return a.timestamp < b.timestamp;
+        });
+
+        // when two keyframes share the same frame, the earlier one is moved right after the later one
+        for (size_t i = 1; i < keyframes.size(); i++) {
+            if (int(keyframes[i].timestamp) <= int(keyframes[i - 1].timestamp)) {
+                keyframes[i - 1].timestamp = int(keyframes[i].timestamp) + 1;
+                std::swap(keyframes[i - 1], keyframes[i]);
             }
         }
     }
@@ -572,6 +590,7 @@ namespace Raster {
                         selectedKeyframe->timestamp += keyframeDragDistance / UIShared::s_timelinePixelsPerFrame;
                         selectedKeyframe->timestamp = std::max(selectedKeyframe->timestamp, 1.0f);
                         selectedKeyframe->timestamp = std::min(selectedKeyframe->timestamp, composition->GetEndFrame() - composition->GetBeginFrame());
+                        InvalidateKeyframes();
                     }
                 }
             } else {
@@ -609,6 +628,7 @@ namespace Raster {
                     if (selectedKeyframeCandidate.has_value()) {
                         auto& selectedKeyframe = selectedKeyframeCandidate.value();
                         selectedKeyframe->timestamp = std::floor(selectedKeyframe->timestamp);
+                        InvalidateKeyframes();
                     }
                 }
             }
@@ -632,7 +652,11 @@ namespace Raster {
                 std::vector<float> percentages(SMOOTHNESS);
                 float step = 1.0f / (float) SMOOTHNESS;
                 for (int i = 0; i < SMOOTHNESS; i++) {
-                    percentages[i] = std::clamp(nextEasing->Get(i * step), 0.0f, 0.95f);
+                    percentages[i] = i * step;
+                }
+                nextEasing->Evaluate(percentages, percentages);
+                for (auto& percentage : percentages) {
+                    percentage = std::clamp(percentage, 0.0f, 0.95f);
                 }
 
                 ImVec2 canvasPos = keyframeBounds.BR;
@@ -708,11 +732,13 @@ namespace Raster {
             }
             if (ImGui::MenuItem(FormatString("%s %s", ICON_FA_XMARK, Localization::GetString("NO_EASING").c_str()).c_str())) {
                 t_keyframe.easing = std::nullopt;
+                InvalidateKeyframes();
             }
             for (auto& implementation : Easings::s_implementations) {
                 bool isEasingSelected = t_keyframe.easing.has_value() && t_keyframe.easing.value()->packageName == implementation.description.packageName;
                 if (ImGui::MenuItem(FormatString("%s%s %s", isEasingSelected ? ICON_FA_CHECK " " : "", ICON_FA_BEZIER_CURVE, implementation.description.prettyName.c_str()).c_str())) {
                     t_keyframe.easing = Easings::InstantiateEasing(implementation.description.packageName);
+                    InvalidateKeyframes();
                 }
             }
             ImGui::EndMenu();
@@ -755,6 +781,7 @@ namespace Raster {
                         keyframeIndex++;
                     }
                     attribute->keyframes.erase(attribute->keyframes.begin() + keyframeIndex);
+                    InvalidateKeyframes();
                 }
             }
         }
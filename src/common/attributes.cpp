@@ -69,24 +69,23 @@ namespace Raster {
     }
 
     void Attributes::Initialize() {
-        if (!std::filesystem::exists("attributes/")) {
-            std::filesystem::create_directory("attributes");
-        }
-        auto iterator = std::filesystem::directory_iterator("attributes");
-        for (auto &entry : iterator) {
-            std::string transformedPath = std::regex_replace(
-                GetBaseName(entry.path().string()), std::regex(".dll|.so|lib"), "");
-            Libraries::LoadLibrary("attributes", transformedPath);
+        auto libraries = Libraries::Discover("attributes", "", [](std::string t_key) -> Json {
+            auto description = Libraries::GetFunction<AttributeDescription()>(t_key, "GetDescription")();
+            return {
+                {"PackageName", description.packageName},
+                {"PrettyName", description.prettyName}
+            };
+        });
+        for (auto& library : libraries) {
             AttributeImplementation implementation;
-            implementation.description = Libraries::GetFunction<AttributeDescription()>(transformedPath, "GetDescription")();
-            implementation.spawn = Libraries::GetFunction<AbstractAttribute()>(transformedPath, "SpawnAttribute");
-            try {
-                Libraries::GetFunction<void()>(transformedPath, "OnStartup")();
-            } catch (internalDylib::exception ex) {
-                // skip
-            }
+            implementation.description.packageName = library.description["PackageName"].get<std::string>();
+            implementation.description.prettyName = library.description["PrettyName"].get<std::string>();
+            implementation.spawn = [key = library.key]() {
+                Libraries::LoadLibrary("attributes", key);
+                return Libraries::GetFunction<AbstractAttribute()>(key, "SpawnAttribute")();
+            };
             s_implementations.push_back(implementation);
-            std::cout << "loading attribute '" << implementation.description.packageName << "'" << std::endl;
+            std::cout << "registering attribute '" << implementation.description.packageName << "'" << std::endl;
         }
     }
 };
\ No newline at end of file
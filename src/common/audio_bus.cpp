@@ -2,12 +2,19 @@
 #include "common/workspace.h"
 #include "common/audio_info.h"
 
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+    #include <xmmintrin.h>
+    #define RASTER_AUDIO_BUS_SSE
+#endif
+
 namespace Raster {
     AudioBus::AudioBus() {
         this->name = "Audio Bus";
         this->id = Randomizer::GetRandomInteger();
         this->redirectID = 0;
         this->main = false;
+        this->muted = false;
+        this->gain = 1.0f;
         this->colorMark = Workspace::s_colorMarks[Workspace::s_defaultColorMark];
     }
 
@@ -16,6 +23,8 @@ namespace Raster {
         this->id = t_data["ID"];
         this->redirectID = t_data["RedirectID"];
         this->main = t_data["Main"];
+        this->muted = t_data.contains("Muted") ? t_data["Muted"].get<bool>() : false;
+        this->gain = t_data.contains("Gain") ? t_data["Gain"].get<float>() : 1.0f;
         if (t_data.contains("ColorMark")) this->colorMark = t_data["ColorMark"];
     }
 
@@ -25,13 +34,109 @@ namespace Raster {
         }
     }
 
+    void AudioBus::AccumulateSamples(float* t_destination, const float* t_source, size_t t_count, float t_gain) {
+        size_t i = 0;
+#ifdef RASTER_AUDIO_BUS_SSE
+        __m128 gain = _mm_set1_ps(t_gain);
+        for (; i + 8 <= t_count; i += 8) {
+            __m128 a = _mm_add_ps(_mm_loadu_ps(t_destination + i), _mm_mul_ps(_mm_loadu_ps(t_source + i), gain));
+            __m128 b = _mm_add_ps(_mm_loadu_ps(t_destination + i + 4), _mm_mul_ps(_mm_loadu_ps(t_source + i + 4), gain));
+            _mm_storeu_ps(t_destination + i, a);
+            _mm_storeu_ps(t_destination + i + 4, b);
+        }
+#endif
+        for (; i < t_count; i++) {
+            t_destination[i] += t_source[i] * t_gain;
+        }
+    }
+
     Json AudioBus::Serialize() {
         return {
             {"Name", name},
             {"ID", id},
             {"RedirectID", redirectID},
             {"Main", main},
+            {"Muted", muted},
+            {"Gain", gain},
             {"ColorMark", colorMark}
         };
     }
+
+    uint64_t AudioBusRouting::ComputeSignature(const std::vector<AudioBus>& t_buses) {
+        uint64_t signature = HashValue(t_buses.size());
+        for (auto& bus : t_buses) {
+            signature = HashCombine(signature, HashValue(bus.id));
+            signature = HashCombine(signature, HashValue(bus.main ? -1 : bus.redirectID));
+        }
+        return signature;
+    }
+
+    bool AudioBusRouting::Update(const std::vector<AudioBus>& t_buses) {
+        auto newSignature = ComputeSignature(t_buses);
+        if (newSignature == signature && indices.size() == t_buses.size()) return false;
+        signature = newSignature;
+
+        int busesCount = t_buses.size();
+        indices.clear();
+        for (int i = 0; i < busesCount; i++) {
+            indices[t_buses[i].id] = i;
+        }
+
+        destinations.assign(busesCount, -1);
+        std::vector<int> incomingCount(busesCount, 0);
+        for (int i = 0; i < busesCount; i++) {
+            auto& bus = t_buses[i];
+            if (bus.main || bus.redirectID < 0 || bus.redirectID == bus.id) continue;
+            auto destinationIterator = indices.find(bus.redirectID);
+            if (destinationIterator == indices.end()) continue;
+            destinations[i] = destinationIterator->second;
+            incomingCount[destinations[i]]++;
+        }
+
+        // kahn's algorithm, buses that never become free are part of (or fed by) a cycle
+        order.clear();
+        order.reserve(busesCount);
+        for (int i = 0; i < busesCount; i++) {
+            if (incomingCount[i] == 0) order.push_back(i);
+        }
+        for (int i = 0; i < order.size(); i++) {
+            int destination = destinations[order[i]];
+            if (destination >= 0 && --incomingCount[destination] == 0) {
+                order.push_back(destination);
+            }
+        }
+
+        cyclicBuses.clear();
+        if (order.size() != busesCount) {
+            for (int i = 0; i < busesCount; i++) {
+                if (incomingCount[i] == 0) continue;
+                destinations[i] = -1;
+                order.push_back(i);
+                cyclicBuses.push_back(t_buses[i].id);
+                RASTER_LOG("ignoring cyclic redirection of audio bus '" << t_buses[i].name << "'");
+            }
+        }
+
+        return true;
+    }
+
+    std::optional<int> AudioBusRouting::GetBusIndex(int t_busID) const {
+        auto indexIterator = indices.find(t_busID);
+        if (indexIterator != indices.end()) return indexIterator->second;
+        return std::nullopt;
+    }
+
+    bool AudioBusRouting::CreatesCycle(const std::vector<AudioBus>& t_buses, int t_busID, int t_redirectID) {
+        // walking the redirection chain from the new destination, it must never reach the bus itself
+        int currentID = t_redirectID;
+        for (int step = 0; step <= t_buses.size(); step++) {
+            if (currentID == t_busID) return true;
+            auto busIterator = std::find_if(t_buses.begin(), t_buses.end(), [currentID](const AudioBus& t_bus) {
+                return t_bus.id == currentID;
+            });
+            if (busIterator == t_buses.end() || busIterator->main || busIterator->redirectID < 0) return false;
+            currentID = busIterator->redirectID;
+        }
+        return true;
+    }
 };
\ No newline at end of file
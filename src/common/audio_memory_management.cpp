@@ -8,12 +8,14 @@ namespace Raster {
         uint8_t* base;
         uint8_t* current;
         size_t size;
-        AudioHeapState() : base(nullptr), current(nullptr), size(0) {}
+        int lastAudioPassID;
+        AudioHeapState() : base(nullptr), current(nullptr), size(0), lastAudioPassID(-1) {}
     };
 
     static size_t s_requiredSize;
     static ThreadUniqueValue<AudioHeapState> s_heapState;
     static std::vector<uint8_t*> s_heaps;
+    static std::mutex s_heapsMutex;
 
     void AudioMemoryManagement::Initialize(size_t t_bytes) {
         RASTER_LOG("initializing " << t_bytes << " bytes for audio heap (" << t_bytes / 1024 / 1024 << " megabytes)");
@@ -27,6 +29,7 @@ namespace Raster {
             heap.base = new uint8_t[s_requiredSize];
             heap.current = heap.base;
             heap.size = s_requiredSize;
+            RASTER_SYNCHRONIZED(s_heapsMutex);
             s_heaps.push_back(heap.base);
         }
         if (heap.size - (size_t) (heap.current - heap.base) < t_bytes) {
@@ -45,8 +48,16 @@ namespace Raster {
         heap.current = heap.base;
     }
 
+    void AudioMemoryManagement::ResetForPass(int t_audioPassID) {
+        auto& heap = s_heapState.Get();
+        if (heap.lastAudioPassID == t_audioPassID) return;
+        heap.current = heap.base;
+        heap.lastAudioPassID = t_audioPassID;
+    }
+
     void AudioMemoryManagement::Terminate() {
         RASTER_LOG("terminating all audio heaps");
+        RASTER_SYNCHRONIZED(s_heapsMutex);
         for (auto& heap : s_heaps) {
             delete[] heap;
         }
@@ -19,9 +19,7 @@ namespace Raster {
         }
     }
 
-    static glm::vec2 InternalGet(float t_percentage, std::vector<glm::vec2> points) {
-        static ThreadUniqueValue<std::vector<glm::vec2>> s_temporaryStorage;
-        auto& temporaryStorage = s_temporaryStorage.Get();
+    static glm::vec2 InternalGet(float t_percentage, const std::vector<glm::vec2>& points, std::vector<glm::vec2>& temporaryStorage) {
         if (temporaryStorage.size() < points.size()) {
             temporaryStorage.resize(points.size());
         }
@@ -56,7 +54,7 @@ namespace Raster {
         return {x, y};
         }
 
-    glm::vec2 BezierCurve::Get(float t_percentage) {
+    static glm::vec2 EvaluateCurve(float t_percentage, const std::vector<glm::vec2>& points, bool smoothCurve, std::vector<glm::vec2>& temporaryStorage) {
         if (smoothCurve) {
             int p0, p1, p2, p3;
             auto t = t_percentage * (points.size() - 1);
@@ -70,7 +68,55 @@ namespace Raster {
             auto p = catmullRom({points[p0].x, points[p0].y}, {points[p1].x, points[p1].y}, {points[p2].x, points[p2].y}, {points[p3].x, points[p3].y}, t);
             return {p.first, p.second};
         }
-        return InternalGet(t_percentage, points);
+        return InternalGet(t_percentage, points, temporaryStorage);
+    }
+
+    glm::vec2 BezierCurve::Get(float t_percentage) {
+        static ThreadUniqueValue<std::vector<glm::vec2>> s_temporaryStorage;
+        return EvaluateCurve(t_percentage, points, smoothCurve, s_temporaryStorage.Get());
+    }
+
+    void BezierCurve::Tessellate(glm::mat4 t_transform, glm::vec2 t_viewportSize, int t_maxDepth, float t_tolerance, std::vector<float>& t_parameters, std::vector<glm::vec2>& t_points) {
+        t_parameters.clear();
+        t_points.clear();
+        if (points.empty()) return;
+
+        std::vector<glm::vec2> projectedPoints(points.size());
+        for (int i = 0; i < points.size(); i++) {
+            auto point4 = t_transform * glm::vec4(points[i].x, points[i].y, 0, 1);
+            projectedPoints[i] = glm::vec2(point4.x, point4.y);
+        }
+
+        std::vector<glm::vec2> temporaryStorage(projectedPoints.size());
+        auto halfViewport = t_viewportSize * 0.5f;
+
+        // a single midpoint test can miss wiggles between control points,
+        // so every span between them gets subdivided at least once
+        int minDepth = std::min(t_maxDepth, (int) std::ceil(std::log2(std::max((int) points.size() - 1, 1))) + 1);
+
+        std::function<void(float, glm::vec2, float, glm::vec2, int)> subdivide = [&](float t0, glm::vec2 p0, float t1, glm::vec2 p1, int depth) {
+            float tm = (t0 + t1) * 0.5f;
+            auto pm = EvaluateCurve(tm, projectedPoints, smoothCurve, temporaryStorage);
+            auto error = (pm - (p0 + p1) * 0.5f) * halfViewport;
+            bool flat = glm::dot(error, error) <= t_tolerance * t_tolerance;
+            if (depth >= t_maxDepth || (depth >= minDepth && flat)) {
+                t_parameters.push_back(t1);
+                t_points.push_back(p1);
+                return;
+            }
+            subdivide(t0, p0, tm, pm, depth + 1);
+            subdivide(tm, pm, t1, p1, depth + 1);
+        };
+
+        auto begin = EvaluateCurve(0, projectedPoints, smoothCurve, temporaryStorage);
+        auto end = EvaluateCurve(1, projectedPoints, smoothCurve, temporaryStorage);
+        t_parameters.push_back(0);
+        t_points.push_back(begin);
+        subdivide(0, begin, 1, end, 0);
+    }
+
+    uint64_t BezierCurve::Hash() {
+        return HashCombine(HashBytes(points.data(), points.size() * sizeof(glm::vec2)), smoothCurve);
     }
 
     Json BezierCurve::Serialize() {
@@ -42,5 +42,4 @@ namespace Raster {
         return data;
     }
 
-    std::unordered_map<std::string, internalDylib> Libraries::s_registry;
 }
\ No newline at end of file
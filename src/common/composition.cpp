@@ -167,48 +167,112 @@ namespace Raster {
         }
     }
 
-    static float InternalMapTime(Composition* t_composition, float t_time, bool t_inverseSpeed) {
-        if (t_composition->speedAttributeID < 0) return t_time * (t_inverseSpeed ? 1.0f / t_composition->speed : t_composition->speed);
-        auto lockedCompositionCandidate = Workspace::GetCompositionByID(t_composition->lockedCompositionID);
-        int speedAttributeID = t_composition->speedAttributeID;
-        if (lockedCompositionCandidate) speedAttributeID = (*lockedCompositionCandidate)->speedAttributeID;
-        auto attributeCandidate = Workspace::GetAttributeByAttributeID(speedAttributeID);
-        if (!attributeCandidate || (attributeCandidate && (*attributeCandidate)->packageName != RASTER_PACKAGED "float_attribute")) return t_time * (t_inverseSpeed ? 1.0f * t_composition->speed : t_composition->speed);
-        auto& attribute = *attributeCandidate;
-        if (attribute->keyframes.size() == 1) return t_time * (t_inverseSpeed ? 1.0f / std::any_cast<float>(attribute->keyframes[0].value) : std::any_cast<float>(attribute->keyframes[0].value));
-        auto keyframes = attribute->keyframes;
-        if (keyframes[keyframes.size() - 1].timestamp != t_composition->endFrame - t_composition->endFrame) {
-            keyframes.push_back(AttributeKeyframe(t_composition->endFrame - t_composition->beginFrame, keyframes[keyframes.size() - 1].value));
-        }
-        float result = 0;
-        for (int i = 0; i < keyframes.size() - 1; i++) {
-            bool mustBreak = false;
-            auto keyframe = keyframes[i];
-            auto nextKeyframe = keyframes[i + 1];
-            if (nextKeyframe.timestamp > t_time) {
-                mustBreak = true;
-                auto speed = std::any_cast<float>(keyframe.value);
-                auto nextSpeed = std::any_cast<float>(nextKeyframe.value);
-                auto percentage = GetPercentageInBounds(t_time, keyframe.timestamp, nextKeyframe.timestamp);
-                nextKeyframe.value = glm::mix(speed, nextSpeed, percentage);
-                nextKeyframe.timestamp = t_time;
+    // speed curve is stored as piecewise-linear samples with cumulative integrals of speed and 1 / speed,
+    // eased segments are subdivided so that the samples follow the easing shape
+    #define SPEED_INTEGRAL_SUBDIVISIONS 32
+    #define MIN_COMPOSITION_SPEED 0.1f
+
+    struct SpeedIntegralSample {
+        float time;
+        float speed[2];
+        float integral[2];
+    };
+
+    struct SpeedIntegral {
+        std::weak_ptr<AttributeBase> attribute;
+        uint64_t keyframesRevision;
+        std::vector<SpeedIntegralSample> samples;
+    };
+
+    // MapTime() is called both from rendering thread and UI, so every thread keeps it's own tables
+    static thread_local unordered_dense::map<int, SpeedIntegral> s_speedIntegrals;
+
+    static void PushSpeedSample(std::vector<SpeedIntegralSample>& t_samples, float t_time, float t_speed) {
+        SpeedIntegralSample sample;
+        sample.time = t_time;
+        sample.speed[0] = glm::max(t_speed, MIN_COMPOSITION_SPEED);
+        sample.speed[1] = 1.0f / sample.speed[0];
+        sample.integral[0] = sample.integral[1] = 0.0f;
+        if (!t_samples.empty()) {
+            auto& previous = t_samples.back();
+            float width = t_time - previous.time;
+            for (int i = 0; i < 2; i++) {
+                sample.integral[i] = previous.integral[i] + (previous.speed[i] + sample.speed[i]) / 2.0f * width;
             }
-            auto speed = std::any_cast<float>(keyframe.value);
-            auto nextSpeed = std::any_cast<float>(nextKeyframe.value);
-            speed = glm::max(speed, 0.1f);
-            nextSpeed = glm::max(nextSpeed, 0.1f);
-            if (t_inverseSpeed) {
-                speed = 1.0f / speed;
-                nextSpeed = 1.0f / nextSpeed;
+        }
+        t_samples.push_back(sample);
+    }
+
+    static std::vector<SpeedIntegralSample> BuildSpeedIntegral(AttributeBase* t_attribute, Composition* t_composition) {
+        t_attribute->SortKeyframes();
+        auto& keyframes = t_attribute->keyframes;
+
+        // speed is constant before the first keyframe and after the last one
+        std::vector<float> times = {glm::min(0.0f, keyframes.front().timestamp)};
+        if (keyframes.front().timestamp > 0) times.push_back(keyframes.front().timestamp);
+        for (size_t i = 1; i < keyframes.size(); i++) {
+            auto& keyframe = keyframes[i - 1];
+            auto& nextKeyframe = keyframes[i];
+            auto value = std::any_cast<float>(&keyframe.value);
+            auto nextValue = std::any_cast<float>(&nextKeyframe.value);
+            bool isConstant = !nextKeyframe.easing.has_value() && value && nextValue && *value == *nextValue;
+            int subdivisions = isConstant ? 1 : SPEED_INTEGRAL_SUBDIVISIONS;
+            for (int j = 1; j <= subdivisions; j++) {
+                times.push_back(glm::mix(keyframe.timestamp, nextKeyframe.timestamp, (float) j / subdivisions));
             }
-            float width = (nextKeyframe.timestamp - keyframe.timestamp);
-            float innerHeight = std::max(speed, nextSpeed) - std::min(speed, nextSpeed);
-            float upperWidth = std::sqrt(width*width+innerHeight*innerHeight);
-            float area = (upperWidth + width) / 2.0f * std::max(speed, nextSpeed);
-            result += area;
-            if (mustBreak) break;
         }
-        return result;
+
+        // times ascend, so segment hint of the attribute keeps every lookup O(1)
+        std::vector<SpeedIntegralSample> samples;
+        for (auto& time : times) {
+            auto speedValue = t_attribute->Get(time, t_composition);
+            auto speed = std::any_cast<float>(&speedValue);
+            PushSpeedSample(samples, time, speed ? *speed : 1.0f);
+        }
+        return samples;
+    }
+
+    static std::vector<SpeedIntegralSample>* GetSpeedIntegral(Composition* t_composition) {
+        int attributeID = t_composition->speedAttributeID;
+        AbstractAttribute attribute;
+        auto cachedIterator = s_speedIntegrals.find(attributeID);
+        if (cachedIterator != s_speedIntegrals.end()) attribute = cachedIterator->second.attribute.lock();
+        if (!attribute || attribute->id != attributeID) {
+            auto attributeCandidate = Workspace::GetAttributeByAttributeID(attributeID);
+            if (!attributeCandidate) return nullptr;
+            attribute = *attributeCandidate;
+        }
+        if (attribute->packageName != RASTER_PACKAGED "float_attribute" || attribute->keyframes.empty()) return nullptr;
+
+        // revision is read before building, so edits made while building invalidate the table again
+        uint64_t keyframesRevision = AttributeBase::s_keyframesRevision;
+        auto& integral = s_speedIntegrals[attributeID];
+        if (integral.attribute.lock() != attribute || integral.keyframesRevision != keyframesRevision || integral.samples.empty()) {
+            integral.attribute = attribute;
+            integral.samples = BuildSpeedIntegral(attribute.get(), t_composition);
+            integral.keyframesRevision = keyframesRevision;
+        }
+        return &integral.samples;
+    }
+
+    static float IntegrateSpeed(std::vector<SpeedIntegralSample>& t_samples, float t_time, int t_channel) {
+        auto upper = std::upper_bound(t_samples.begin(), t_samples.end(), t_time, [](float time, auto& sample) { return time < sample.time; });
+        auto& sample = upper == t_samples.begin() ? *upper : *(upper - 1);
+        float offset = t_time - sample.time;
+        if (upper == t_samples.begin() || upper == t_samples.end()) {
+            return sample.integral[t_channel] + sample.speed[t_channel] * offset;
+        }
+        auto& nextSample = *upper;
+        float slope = (nextSample.speed[t_channel] - sample.speed[t_channel]) / (nextSample.time - sample.time);
+        return sample.integral[t_channel] + sample.speed[t_channel] * offset + slope * offset * offset / 2.0f;
+    }
+
+    static float InternalMapTime(Composition* t_composition, float t_time, bool t_inverseSpeed) {
+        float speed = t_inverseSpeed ? 1.0f / t_composition->speed : t_composition->speed;
+        if (t_composition->speedAttributeID < 0) return t_time * speed;
+        auto samples = GetSpeedIntegral(t_composition);
+        if (!samples) return t_time * speed;
+        return IntegrateSpeed(*samples, t_time, t_inverseSpeed ? 1 : 0);
     }
 
     float Composition::GetSpeed() {
@@ -0,0 +1,153 @@
+#include "common/composition_index.h"
+#include "common/project.h"
+#include "common/composition.h"
+
+namespace Raster {
+
+    struct CompositionRange {
+        float begin, end;
+        int index, id;
+        int lockedCompositionID;
+
+        bool operator==(const CompositionRange& t_other) const {
+            return begin == t_other.begin && end == t_other.end && index == t_other.index && id == t_other.id && lockedCompositionID == t_other.lockedCompositionID;
+        }
+    };
+
+    struct CompositionIntervals {
+        // sorted by beginning, viewed as an implicit balanced tree where [lo; hi) subtree is rooted at (lo + hi) / 2
+        std::vector<CompositionRange> ranges;
+        // maximum end of the subtree rooted at the same position
+        std::vector<float> maxEnds;
+        std::vector<CompositionRange> lockedCompositions;
+        size_t compositionsCount;
+        uint64_t revision;
+    };
+
+    // snapshots are replaced by UI thread and read by rendering and audio threads
+    static std::mutex s_intervalsMutex;
+    static std::shared_ptr<const CompositionIntervals> s_intervals;
+    static std::vector<CompositionRange> s_lastRanges;
+    static uint64_t s_revision = 0;
+
+    static std::shared_ptr<const CompositionIntervals> GetIntervals() {
+        std::lock_guard<std::mutex> lock(s_intervalsMutex);
+        return s_intervals;
+    }
+
+    static float BuildMaxEnds(CompositionIntervals& t_intervals, int t_lo, int t_hi) {
+        if (t_lo >= t_hi) return std::numeric_limits<float>::lowest();
+        int mid = (t_lo + t_hi) / 2;
+        float maxEnd = t_intervals.ranges[mid].end;
+        maxEnd = std::max(maxEnd, BuildMaxEnds(t_intervals, t_lo, mid));
+        maxEnd = std::max(maxEnd, BuildMaxEnds(t_intervals, mid + 1, t_hi));
+        t_intervals.maxEnds[mid] = maxEnd;
+        return maxEnd;
+    }
+
+    static void CollectActiveRanges(const CompositionIntervals& t_intervals, float t_frame, int t_lo, int t_hi, std::vector<const CompositionRange*>& t_result) {
+        if (t_lo >= t_hi) return;
+        int mid = (t_lo + t_hi) / 2;
+        if (t_intervals.maxEnds[mid] <= t_frame) return;
+        CollectActiveRanges(t_intervals, t_frame, t_lo, mid, t_result);
+        auto& range = t_intervals.ranges[mid];
+        // everything to the right begins even later
+        if (range.begin > t_frame) return;
+        if (t_frame < range.end) t_result.push_back(&range);
+        CollectActiveRanges(t_intervals, t_frame, mid + 1, t_hi, t_result);
+    }
+
+    static bool IsRangeValid(Project& t_project, const CompositionRange& t_range) {
+        return t_range.index < t_project.compositions.size() && t_project.compositions[t_range.index].id == t_range.id;
+    }
+
+    static std::optional<std::vector<int>> QueryActiveCompositions(Project& t_project, float t_frame) {
+        auto intervals = GetIntervals();
+        if (!intervals || intervals->compositionsCount != t_project.compositions.size()) return std::nullopt;
+        std::vector<const CompositionRange*> ranges;
+        CollectActiveRanges(*intervals, t_frame, 0, intervals->ranges.size(), ranges);
+        std::vector<int> result;
+        result.reserve(ranges.size());
+        for (auto range : ranges) {
+            if (!IsRangeValid(t_project, *range)) return std::nullopt;
+            result.push_back(range->index);
+        }
+        std::sort(result.begin(), result.end());
+        return result;
+    }
+
+    bool CompositionIndex::Update(Project& t_project) {
+        std::vector<CompositionRange> ranges;
+        ranges.reserve(t_project.compositions.size());
+        for (int i = 0; i < t_project.compositions.size(); i++) {
+            auto& composition = t_project.compositions[i];
+            ranges.push_back({composition.GetBeginFrame() - 1, composition.GetEndFrame() + 1, i, composition.id, composition.lockedCompositionID});
+        }
+        if (ranges == s_lastRanges && GetIntervals()) return false;
+
+        auto intervals = std::make_shared<CompositionIntervals>();
+        intervals->ranges = ranges;
+        std::sort(intervals->ranges.begin(), intervals->ranges.end(), [](auto& a, auto& b) {
+            return a.begin < b.begin;
+        });
+        intervals->maxEnds.resize(ranges.size());
+        BuildMaxEnds(*intervals, 0, ranges.size());
+        for (auto& range : ranges) {
+            if (range.lockedCompositionID >= 0) intervals->lockedCompositions.push_back(range);
+        }
+        intervals->compositionsCount = ranges.size();
+        intervals->revision = ++s_revision;
+        s_lastRanges = ranges;
+
+        std::lock_guard<std::mutex> lock(s_intervalsMutex);
+        s_intervals = intervals;
+        return true;
+    }
+
+    std::vector<int> CompositionIndex::GetActiveCompositions(Project& t_project, float t_frame) {
+        auto resultCandidate = QueryActiveCompositions(t_project, t_frame);
+        if (resultCandidate) return *resultCandidate;
+
+        // index hasn't caught up with project edits yet
+        std::vector<int> result;
+        for (int i = 0; i < t_project.compositions.size(); i++) {
+            auto& composition = t_project.compositions[i];
+            if (IsInBounds(t_frame, composition.GetBeginFrame() - 1, composition.GetEndFrame() + 1)) result.push_back(i);
+        }
+        return result;
+    }
+
+    bool CompositionIndex::GetActivationChanges(Project& t_project, float t_from, float t_to, std::vector<int>& t_activated, std::vector<int>& t_deactivated) {
+        auto fromCandidate = QueryActiveCompositions(t_project, t_from);
+        auto toCandidate = QueryActiveCompositions(t_project, t_to);
+        if (!fromCandidate || !toCandidate) return false;
+        t_activated.clear();
+        t_deactivated.clear();
+        std::set_difference(toCandidate->begin(), toCandidate->end(), fromCandidate->begin(), fromCandidate->end(), std::back_inserter(t_activated));
+        std::set_difference(fromCandidate->begin(), fromCandidate->end(), toCandidate->begin(), toCandidate->end(), std::back_inserter(t_deactivated));
+        return true;
+    }
+
+    std::vector<int> CompositionIndex::GetLockedCompositions(Project& t_project) {
+        std::vector<int> result;
+        auto intervals = GetIntervals();
+        if (intervals && intervals->compositionsCount == t_project.compositions.size()) {
+            bool valid = true;
+            for (auto& range : intervals->lockedCompositions) {
+                valid = valid && IsRangeValid(t_project, range);
+                result.push_back(range.index);
+            }
+            if (valid) return result;
+            result.clear();
+        }
+        for (int i = 0; i < t_project.compositions.size(); i++) {
+            if (t_project.compositions[i].lockedCompositionID >= 0) result.push_back(i);
+        }
+        return result;
+    }
+
+    uint64_t CompositionIndex::GetRevision() {
+        auto intervals = GetIntervals();
+        return intervals ? intervals->revision : 0;
+    }
+};
@@ -2,34 +2,196 @@
 
 namespace Raster {
 
+    static ConvolutionKernel GenerateGaussianKernel(int t_size, float t_sigma) {
+        std::vector<float> weights(t_size);
+        float sum = 0.0f;
+        for (int i = 0; i < t_size; i++) {
+            float x = i - t_size / 2;
+            weights[i] = std::exp(-(x * x) / (2.0f * t_sigma * t_sigma));
+            sum += weights[i];
+        }
+        std::vector<float> values(t_size * t_size);
+        for (int y = 0; y < t_size; y++) {
+            for (int x = 0; x < t_size; x++) {
+                values[y * t_size + x] = weights[x] * weights[y] / (sum * sum);
+            }
+        }
+        return ConvolutionKernel(1.0f, t_size, t_size, values);
+    }
+
+    static ConvolutionKernel GenerateBoxKernel(int t_size) {
+        return ConvolutionKernel(1.0f / (t_size * t_size), t_size, t_size, std::vector<float>(t_size * t_size, 1.0f));
+    }
+
+    static ConvolutionKernel GenerateUnsharpMaskKernel(int t_size, float t_sigma, float t_amount) {
+        auto kernel = GenerateGaussianKernel(t_size, t_sigma);
+        for (auto& value : kernel.values) value = -value * t_amount;
+        kernel.Set(t_size / 2, t_size / 2, kernel.Get(t_size / 2, t_size / 2) + 1.0f + t_amount);
+        return kernel;
+    }
+
     std::vector<std::pair<std::string, ConvolutionKernel>> ConvolutionKernel::s_presets = {
-        {"Identity", {1.0f, {0, 0, 0, 0, 1, 0, 0, 0, 0}}},
-        {"Edge Detection (Horizontal)", {1.0f, {-1, -1, -1, 0, 0, 0, 1, 1, 1}}},
-        {"Edge Detection (Vertical)", {1.0f, {-1, 0, 1, -1, 0, 1, -1, 0, 1}}},
-        {"Sharpen", {1.0f, {0, -1, 0 , -1, 5, -1, 0, -1, 0}}},
-        {"Box Blur", {1.0f, {1.0f / 9.0f, 1.0f / 9.0f, 1.0f / 9.0f, 1.0f / 9.0f, 1.0f / 9.0f, 1.0f / 9.0f, 1.0f / 9.0f, 1.0f / 9.0f, 1.0f / 9.0f}}},
-        {"Gaussian Blur", {1.0f / 16.0f, {1, 2, 1, 2, 4, 2, 1, 2, 1}}},
-        {"Sobel (Horizontal)", {1.0f, {-1, 0, 1, -2, 0, 2, -1, 0, 1}}},
-        {"Sobel (Vertical)", {1.0f, {-1, -2 , -1, 0, 0, 0, 1, 2, 1}}},
-        {"Prewitt (Horizontal)", {1.0f, {-1, 0, 1, -1, 0, 1, -1, 0, 1}}},
-        {"Prewitt (Vertical)", {1.0f, {-1, -1, -1, 0, 0, 0, 1, 1, 1}}},
-        {"Laplacian", {1.0f, {0, -1, 0, -1, 4, -1, 0, -1, 0}}},
-        {"Emboss", {1.0f, {-2, -1, 0, -1, 1, 1, 0, 1, 2}}}
+        {"Identity", {1.0f, glm::mat3(0, 0, 0, 0, 1, 0, 0, 0, 0)}},
+        {"Edge Detection (Horizontal)", {1.0f, glm::mat3(-1, -1, -1, 0, 0, 0, 1, 1, 1)}},
+        {"Edge Detection (Vertical)", {1.0f, glm::mat3(-1, 0, 1, -1, 0, 1, -1, 0, 1)}},
+        {"Sharpen", {1.0f, glm::mat3(0, -1, 0 , -1, 5, -1, 0, -1, 0)}},
+        {"Box Blur", {1.0f, glm::mat3(1.0f / 9.0f, 1.0f / 9.0f, 1.0f / 9.0f, 1.0f / 9.0f, 1.0f / 9.0f, 1.0f / 9.0f, 1.0f / 9.0f, 1.0f / 9.0f, 1.0f / 9.0f)}},
+        {"Box Blur (15x15)", GenerateBoxKernel(15)},
+        {"Gaussian Blur", {1.0f / 16.0f, glm::mat3(1, 2, 1, 2, 4, 2, 1, 2, 1)}},
+        {"Gaussian Blur (15x15)", GenerateGaussianKernel(15, 3.0f)},
+        {"Gaussian Blur (63x63)", GenerateGaussianKernel(63, 12.0f)},
+        {"Unsharp Mask (9x9)", GenerateUnsharpMaskKernel(9, 2.0f, 1.0f)},
+        {"Sobel (Horizontal)", {1.0f, glm::mat3(-1, 0, 1, -2, 0, 2, -1, 0, 1)}},
+        {"Sobel (Vertical)", {1.0f, glm::mat3(-1, -2 , -1, 0, 0, 0, 1, 2, 1)}},
+        {"Prewitt (Horizontal)", {1.0f, glm::mat3(-1, 0, 1, -1, 0, 1, -1, 0, 1)}},
+        {"Prewitt (Vertical)", {1.0f, glm::mat3(-1, -1, -1, 0, 0, 0, 1, 1, 1)}},
+        {"Laplacian", {1.0f, glm::mat3(0, -1, 0, -1, 4, -1, 0, -1, 0)}},
+        {"Emboss", {1.0f, glm::mat3(-2, -1, 0, -1, 1, 1, 0, 1, 2)}}
     };
 
+    ConvolutionKernel::ConvolutionKernel(float t_multiplier, glm::mat3 t_kernel) : multiplier(t_multiplier), width(3), height(3), values(9) {
+        // glm::mat3 kernels are indexed as kernel[x][y]
+        for (int x = 0; x < 3; x++) {
+            for (int y = 0; y < 3; y++) {
+                values[y * 3 + x] = t_kernel[x][y];
+            }
+        }
+    }
+
+    ConvolutionKernel::ConvolutionKernel(float t_multiplier, int t_width, int t_height, std::vector<float> t_values) : multiplier(t_multiplier), width(std::max(t_width, 1)), height(std::max(t_height, 1)), values(t_values) {
+        values.resize(width * height, 0.0f);
+    }
+
     ConvolutionKernel::ConvolutionKernel(Json t_data) {
-        this->kernel = glm::mat3(t_data["Kernel"][0], t_data["Kernel"][1], t_data["Kernel"][2], t_data["Kernel"][3], t_data["Kernel"][4], t_data["Kernel"][5], t_data["Kernel"][6], t_data["Kernel"][7], t_data["Kernel"][8]);
         this->multiplier = t_data["Multiplier"];
+        if (!t_data.contains("Width")) {
+            // legacy 3x3 kernels were serialized as column-major glm::mat3
+            auto& k = t_data["Kernel"];
+            *this = ConvolutionKernel(multiplier, glm::mat3(k[0], k[1], k[2], k[3], k[4], k[5], k[6], k[7], k[8]));
+            return;
+        }
+        this->width = std::max(t_data["Width"].get<int>(), 1);
+        this->height = std::max(t_data["Height"].get<int>(), 1);
+        this->values = t_data["Kernel"].get<std::vector<float>>();
+        this->values.resize(width * height, 0.0f);
     }
 
-    glm::mat3 ConvolutionKernel::GetKernel() {
-        return kernel * multiplier;
+    float ConvolutionKernel::Get(int t_x, int t_y) const {
+        return values[t_y * width + t_x];
+    }
+
+    void ConvolutionKernel::Set(int t_x, int t_y, float t_value) {
+        values[t_y * width + t_x] = t_value;
+    }
+
+    void ConvolutionKernel::Resize(int t_width, int t_height) {
+        t_width = std::max(t_width, 1);
+        t_height = std::max(t_height, 1);
+        std::vector<float> resizedValues(t_width * t_height, 0.0f);
+        int offsetX = t_width / 2 - width / 2;
+        int offsetY = t_height / 2 - height / 2;
+        for (int y = 0; y < height; y++) {
+            for (int x = 0; x < width; x++) {
+                int dstX = x + offsetX, dstY = y + offsetY;
+                if (dstX < 0 || dstY < 0 || dstX >= t_width || dstY >= t_height) continue;
+                resizedValues[dstY * t_width + dstX] = Get(x, y);
+            }
+        }
+        this->width = t_width;
+        this->height = t_height;
+        this->values = resizedValues;
+    }
+
+    std::optional<std::vector<SeparableKernelTerm>> ConvolutionKernel::Decompose(int t_maxRank, float t_tolerance) const {
+        std::vector<float> residual = values;
+        float originalNorm = 0.0f;
+        for (auto& value : residual) originalNorm += value * value;
+        if (originalNorm == 0.0f) return std::vector<SeparableKernelTerm>();
+
+        std::vector<SeparableKernelTerm> terms;
+        float threshold = originalNorm * t_tolerance * t_tolerance;
+        while ((int) terms.size() < t_maxRank) {
+            // power iteration for the dominant singular pair of the residual
+            int pivotRow = 0;
+            float pivotNorm = 0.0f;
+            for (int y = 0; y < height; y++) {
+                float rowNorm = 0.0f;
+                for (int x = 0; x < width; x++) rowNorm += residual[y * width + x] * residual[y * width + x];
+                if (rowNorm > pivotNorm) {
+                    pivotNorm = rowNorm;
+                    pivotRow = y;
+                }
+            }
+            std::vector<float> u(height, 0.0f), v(width, 0.0f);
+            for (int x = 0; x < width; x++) v[x] = residual[pivotRow * width + x] / std::sqrt(pivotNorm);
+
+            float sigma = 0.0f;
+            for (int iteration = 0; iteration < 64; iteration++) {
+                float uNorm = 0.0f;
+                for (int y = 0; y < height; y++) {
+                    u[y] = 0.0f;
+                    for (int x = 0; x < width; x++) u[y] += residual[y * width + x] * v[x];
+                    uNorm += u[y] * u[y];
+                }
+                uNorm = std::sqrt(uNorm);
+                if (uNorm == 0.0f) break;
+                for (auto& value : u) value /= uNorm;
+
+                float vNorm = 0.0f;
+                std::vector<float> nextV(width, 0.0f);
+                for (int x = 0; x < width; x++) {
+                    for (int y = 0; y < height; y++) nextV[x] += residual[y * width + x] * u[y];
+                    vNorm += nextV[x] * nextV[x];
+                }
+                vNorm = std::sqrt(vNorm);
+                if (vNorm == 0.0f) break;
+                float delta = 0.0f;
+                for (int x = 0; x < width; x++) {
+                    nextV[x] /= vNorm;
+                    delta += std::abs(nextV[x] - v[x]);
+                }
+                v = nextV;
+                bool converged = std::abs(vNorm - sigma) <= vNorm * 1e-6f && delta < 1e-5f;
+                sigma = vNorm;
+                if (converged) break;
+            }
+            if (sigma == 0.0f) break;
+
+            SeparableKernelTerm term;
+            float scale = std::sqrt(sigma);
+            for (auto& value : v) term.horizontal.push_back(value * scale);
+            for (auto& value : u) term.vertical.push_back(value * scale);
+
+            float residualNorm = 0.0f;
+            for (int y = 0; y < height; y++) {
+                for (int x = 0; x < width; x++) {
+                    auto& value = residual[y * width + x];
+                    value -= term.vertical[y] * term.horizontal[x];
+                    residualNorm += value * value;
+                }
+            }
+            terms.push_back(term);
+            if (residualNorm <= threshold) return terms;
+        }
+        return std::nullopt;
+    }
+
+    uint64_t ConvolutionKernel::Hash() const {
+        uint64_t hash = HashCombine(HashValue(width), HashValue(height));
+        hash = HashCombine(hash, HashValue(multiplier));
+        return HashCombine(hash, HashBytes(values.data(), values.size() * sizeof(float)));
     }
 
     Json ConvolutionKernel::Serialize() {
         return {
             {"Multiplier", multiplier},
-            {"Kernel", {kernel[0][0], kernel[0][1], kernel[0][2], kernel[1][0], kernel[1][1], kernel[1][2], kernel[2][0], kernel[2][1], kernel[2][2]}}
+            {"Width", width},
+            {"Height", height},
+            {"Kernel", values}
         };
     }
-}
\ No newline at end of file
+
+    bool ConvolutionKernel::operator==(const ConvolutionKernel& t_other) const {
+        return multiplier == t_other.multiplier && width == t_other.width && height == t_other.height && values == t_other.values;
+    }
+}
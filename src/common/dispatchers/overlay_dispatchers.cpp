@@ -308,6 +308,7 @@ namespace Raster {
             } else {
                 attribute->keyframes.push_back(AttributeKeyframe(compositionRelativeTime, transform));
             }
+            AttributeBase::InvalidateKeyframes();
         }
 
 
@@ -472,6 +473,7 @@ namespace Raster {
             } else {
                 attribute->keyframes.push_back(AttributeKeyframe(compositionRelativeTime, line));
             }
+            AttributeBase::InvalidateKeyframes();
         }
 
         t_attribute = line;
@@ -865,6 +867,7 @@ namespace Raster {
             } else {
                 attribute->keyframes.push_back(AttributeKeyframe(compositionRelativeTime, bezier));
             }
+            AttributeBase::InvalidateKeyframes();
         }
 
         t_attribute = bezier;
@@ -1023,6 +1026,7 @@ namespace Raster {
             } else {
                 attribute->keyframes.push_back(AttributeKeyframe(compositionRelativeTime, transform));
             }
+            AttributeBase::InvalidateKeyframes();
         }
 
         if (attributeCandidate.has_value()) {
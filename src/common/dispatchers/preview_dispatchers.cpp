@@ -3,6 +3,7 @@
 #include "common/line2d.h"
 #include "common/localization.h"
 #include "compositor/compositor.h"
+#include "compositor/resolution_governor.h"
 #include "font/IconsFontAwesome5.h"
 #include "font/font.h"
 #include "../../ImGui/imgui.h"
@@ -169,6 +170,8 @@ namespace Raster {
 
         Texture texture = std::any_cast<Texture>(t_attribute);
         ImVec2 fitTextureSize = FitRectInRect(ImGui::GetWindowSize(), ImVec2(texture.width, texture.height));
+        ImVec2 displayedTextureSize = fitTextureSize * zoom * ImGui::GetIO().DisplayFramebufferScale;
+        ResolutionGovernor::s_viewportSize = glm::vec2(displayedTextureSize.x, displayedTextureSize.y);
 
         ImGui::BeginChild("##imageContainer", ImGui::GetContentRegionAvail(), 0, ImGuiWindowFlags_NoScrollbar | ImGuiWindowFlags_NoScrollWithMouse);
             static bool maskR = true;
@@ -1,5 +1,6 @@
 #include "common/easing_base.h"
 #include "common/rendering.h"
+#include "common/attribute.h"
 
 namespace Raster {
     void EasingBase::Initialize() {
@@ -8,7 +9,17 @@ namespace Raster {
     }
 
     void EasingBase::RenderDetails() {
+        // easings are edited in place, serialized state tells whether the details actually changed anything
+        auto previousData = AbstractSerialize();
         AbstractRenderDetails();
+        if (AbstractSerialize() != previousData) AttributeBase::InvalidateKeyframes();
+    }
+
+    void EasingBase::Evaluate(const std::vector<float>& t_percentages, std::vector<float>& t_values) {
+        t_values.resize(t_percentages.size());
+        for (size_t i = 0; i < t_percentages.size(); i++) {
+            t_values[i] = Get(t_percentages[i]);
+        }
     }
 
     Json EasingBase::Serialize() {
@@ -4,24 +4,23 @@ namespace Raster {
     std::vector<EasingImplementation> Easings::s_implementations;
 
     void Easings::Initialize() {
-        if (!std::filesystem::exists("easings/")) {
-            std::filesystem::create_directory("easings");
-        }
-        auto iterator = std::filesystem::directory_iterator("easings");
-        for (auto &entry : iterator) {
-            std::string transformedPath = std::regex_replace(
-                GetBaseName(entry.path().string()), std::regex(".dll|.so|lib"), "");
-            Libraries::LoadLibrary("easings", transformedPath);
+        auto libraries = Libraries::Discover("easings", "", [](std::string t_key) -> Json {
+            auto description = Libraries::GetFunction<EasingDescription()>(t_key, "GetDescription")();
+            return {
+                {"PrettyName", description.prettyName},
+                {"PackageName", description.packageName}
+            };
+        });
+        for (auto& library : libraries) {
             EasingImplementation implementation;
-            implementation.description = Libraries::GetFunction<EasingDescription()>(transformedPath, "GetDescription")();
-            implementation.spawn = Libraries::GetFunction<AbstractEasing()>(transformedPath, "SpawnEasing");
-            try {
-                Libraries::GetFunction<void()>(transformedPath, "OnStartup")();
-            } catch (internalDylib::exception ex) {
-                // skip
-            }
+            implementation.description.prettyName = library.description["PrettyName"].get<std::string>();
+            implementation.description.packageName = library.description["PackageName"].get<std::string>();
+            implementation.spawn = [key = library.key]() {
+                Libraries::LoadLibrary("easings", key);
+                return Libraries::GetFunction<AbstractEasing()>(key, "SpawnEasing")();
+            };
             s_implementations.push_back(implementation);
-            std::cout << "loading easing '" << implementation.description.packageName << "'" << std::endl;
+            std::cout << "registering easing '" << implementation.description.packageName << "'" << std::endl;
         }
     }
 
@@ -4,8 +4,10 @@
 #include "common/audio_info.h"
 #include "common/audio_samples.h"
 #include "audio_decoders.h"
+#include "../project_archive_io.h"
 #include "common/thread_unique_value.h"
 #include "common/typedefs.h"
+#include "common/profiler.h"
 #include "raster.h"
 #include <rubberband/RubberBandStretcher.h>
 
@@ -97,6 +99,7 @@ namespace Raster {
     }
 
     std::optional<AudioSamples> GenericAudioDecoder::DecodeSamples(int audioPassID, ContextData t_contextData) {
+        RASTER_PROFILE_ZONE("Audio Decoding");
         SharedLockGuard guard(m_decodingMutex);
         auto& project = Workspace::GetProject();
 
@@ -140,7 +143,7 @@ namespace Raster {
             // print("opening format context");    
 
             decoder->formatCtx.close();
-            decoder->formatCtx.openInput(FormatString("%s/%s", project.path.c_str(), assetPath.c_str()));
+            OpenProjectInput(decoder->formatCtx, decoder->archiveIO, FormatString("%s/%s", project.path.c_str(), assetPath.c_str()));
             decoder->formatCtx.findStreamInfo();
 
             bool streamWasFound = false;
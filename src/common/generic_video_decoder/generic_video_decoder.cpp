@@ -3,8 +3,10 @@
 #include "raster.h"
 #include "video_decoder.h"
 #include "video_decoders.h"
+#include "../project_archive_io.h"
 #include "cache_allocator.h"
 #include "cache_allocator.h"
+#include "common/profiler.h"
 
 namespace Raster {
     struct VideoCacheEntry {
@@ -192,7 +194,7 @@ namespace Raster {
             print("opening format context");    
 
             decoder->formatCtx.close();
-            decoder->formatCtx.openInput(FormatString("%s/%s", project.path.c_str(), assetPath.c_str()));
+            OpenProjectInput(decoder->formatCtx, decoder->archiveIO, FormatString("%s/%s", project.path.c_str(), assetPath.c_str()));
             decoder->formatCtx.findStreamInfo();
 
             bool streamWasFound = false;
@@ -238,6 +240,7 @@ namespace Raster {
     }
 
     bool GenericVideoDecoder::DecodeFrame(ImageAllocation& t_imageAllocation, int t_renderPassID, std::optional<float> t_targetFrame) {
+        RASTER_PROFILE_ZONE("Video Decoding");
         if (assetID == 0) {
             Destroy();
             return false;
@@ -19,6 +19,8 @@
 
 namespace Raster {
     struct VideoDecoder {
+        // keeps custom io of media read from the project archive alive, has to be destroyed after formatCtx
+        std::shared_ptr<av::CustomIO> archiveIO;
         av::FormatContext formatCtx;
         av::Stream targetVideoStream;
         av::VideoDecoderContext videoDecoderCtx;
@@ -1,7 +1,14 @@
 #include "common/gradient_1d.h"
+#include <mutex>
+
+#define MAX_BAKED_GRADIENTS 256
 
 namespace Raster {
 
+    // gradients are copied by value into every consumer, so baked LUTs are shared by content hash
+    static std::mutex s_bakedMutex;
+    static unordered_dense::map<uint64_t, std::shared_ptr<const std::vector<glm::vec4>>> s_baked;
+
     Gradient1D::Gradient1D() {
         this->stops.push_back(GradientStop1D(0, glm::vec4(glm::vec3(0), 1)));
         this->stops.push_back(GradientStop1D(1, glm::vec4(1)));
@@ -62,6 +69,43 @@ namespace Raster {
         return glm::mix(beginKeyframeValue, endkeyframeValue, interpolationPercentage);
     }
 
+    std::vector<glm::vec4> Gradient1D::Bake(int t_resolution) {
+        std::vector<glm::vec4> result(std::max(t_resolution, 2));
+        for (int i = 0; i < result.size(); i++) {
+            result[i] = Get((float) i / (float) (result.size() - 1));
+        }
+        return result;
+    }
+
+    glm::vec4 Gradient1D::SampleBaked(const std::vector<glm::vec4>& t_lut, float t_percentage) {
+        float position = glm::clamp(t_percentage, 0.0f, 1.0f) * (t_lut.size() - 1);
+        int index = std::min((int) position, (int) t_lut.size() - 2);
+        return glm::mix(t_lut[index], t_lut[index + 1], position - index);
+    }
+
+    std::shared_ptr<const std::vector<glm::vec4>> Gradient1D::GetBaked(int t_resolution) {
+        auto key = HashCombine(Hash(), HashValue(t_resolution));
+        {
+            std::lock_guard<std::mutex> lock(s_bakedMutex);
+            auto iterator = s_baked.find(key);
+            if (iterator != s_baked.end()) return iterator->second;
+        }
+        auto lut = std::make_shared<const std::vector<glm::vec4>>(Bake(t_resolution));
+        std::lock_guard<std::mutex> lock(s_bakedMutex);
+        if (s_baked.size() >= MAX_BAKED_GRADIENTS) s_baked.clear();
+        s_baked[key] = lut;
+        return lut;
+    }
+
+    uint64_t Gradient1D::Hash() {
+        uint64_t result = HashValue(stops.size());
+        for (auto& stop : stops) {
+            result = HashCombine(result, HashValue(stop.percentage));
+            result = HashCombine(result, HashValue(stop.color));
+        }
+        return result;
+    }
+
     void Gradient1D::SortStops() {
         for (int step = 0; step < stops.size() - 1; ++step) {
             for (int i = 1; i < stops.size() - step - 1; ++i) {
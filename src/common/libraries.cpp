@@ -0,0 +1,149 @@
+#include "common/libraries.h"
+
+#define LIBRARIES_MANIFEST_PATH "libraries.json"
+
+namespace Raster {
+    std::unordered_map<std::string, internalDylib> Libraries::s_registry;
+    std::recursive_mutex Libraries::s_mutex;
+
+    struct LibraryTiming {
+        std::string name;
+        float loadMilliseconds, startupMilliseconds;
+    };
+
+    static std::optional<Json> s_manifest;
+    static Json s_updatedManifest = Json::object();
+    static std::vector<LibraryTiming> s_timings;
+    static bool s_manifestChanged = false;
+
+    static float MillisecondsSince(std::chrono::steady_clock::time_point t_begin) {
+        return std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - t_begin).count();
+    }
+
+    static Json& GetManifest() {
+        if (!s_manifest) {
+            s_manifest = Json::object();
+            try {
+                if (std::filesystem::exists(LIBRARIES_MANIFEST_PATH)) s_manifest = ReadJson(LIBRARIES_MANIFEST_PATH);
+            } catch (...) {
+                RASTER_LOG("failed to read " << LIBRARIES_MANIFEST_PATH << ", describing all libraries");
+            }
+        }
+        return *s_manifest;
+    }
+
+    void Libraries::LoadLibrary(std::string t_path, std::string t_key) {
+        std::lock_guard<std::recursive_mutex> lock(s_mutex);
+        if (s_registry.find(t_key) != s_registry.end()) return; // do not reload libraries
+        auto loadBegin = std::chrono::steady_clock::now();
+        s_registry[t_key] = internalDylib(t_path, t_key);
+        s_timings.push_back({t_path + "/" + t_key, MillisecondsSince(loadBegin), 0.0f});
+    }
+
+    internalDylib& Libraries::GetLibrary(std::string t_key) {
+        std::lock_guard<std::recursive_mutex> lock(s_mutex);
+        if (s_registry.find(t_key) == s_registry.end())
+            LoadLibrary(".", t_key);
+        return s_registry[t_key];
+    }
+
+    std::vector<LibraryRecord> Libraries::Discover(std::string t_directory, std::string t_context, std::function<Json(std::string)> t_describe) {
+        if (!std::filesystem::exists(t_directory + "/")) {
+            std::filesystem::create_directory(t_directory);
+        }
+
+        auto& manifest = GetManifest();
+        Json cachedLibraries = Json::object();
+        if (manifest.contains(t_directory) && manifest[t_directory].value("Context", "") == t_context) {
+            cachedLibraries = manifest[t_directory]["Libraries"];
+        }
+
+        Json updatedLibraries = Json::object();
+        std::vector<LibraryRecord> result;
+        auto iterator = std::filesystem::directory_iterator(t_directory);
+        for (auto &entry : iterator) {
+            // plugin folders may also carry their resources next to the libraries
+            if (!entry.is_regular_file()) continue;
+            auto fileName = entry.path().filename().string();
+            std::string transformedPath = std::regex_replace(
+                GetBaseName(entry.path().string()), std::regex(".dll|.so|lib"), "");
+            uint64_t size = entry.file_size();
+            int64_t modificationTime = (int64_t) entry.last_write_time().time_since_epoch().count();
+
+            Json library;
+            if (cachedLibraries.contains(fileName)) {
+                auto& cachedLibrary = cachedLibraries[fileName];
+                if (cachedLibrary["Key"] == transformedPath && cachedLibrary["Size"] == size && cachedLibrary["ModificationTime"] == modificationTime) {
+                    library = cachedLibrary;
+                }
+            }
+
+            if (library.is_null()) {
+                LoadLibrary(t_directory, transformedPath);
+                bool hasStartup = true;
+                try {
+                    GetLibrary(transformedPath).get_symbol("OnStartup");
+                } catch (internalDylib::exception ex) {
+                    hasStartup = false;
+                }
+                library = {
+                    {"Key", transformedPath},
+                    {"Size", size},
+                    {"ModificationTime", modificationTime},
+                    {"Startup", hasStartup},
+                    {"Description", t_describe(transformedPath)}
+                };
+                s_manifestChanged = true;
+            }
+
+            // startup hooks may register types and dispatchers, so these libraries can't be deferred
+            if (library["Startup"].get<bool>()) {
+                LoadLibrary(t_directory, transformedPath);
+                auto startupBegin = std::chrono::steady_clock::now();
+                GetFunction<void()>(transformedPath, "OnStartup")();
+                RecordStartupTime(t_directory, transformedPath, MillisecondsSince(startupBegin));
+            }
+
+            result.push_back({transformedPath, library["Description"]});
+            updatedLibraries[fileName] = library;
+        }
+
+        if (cachedLibraries.size() != updatedLibraries.size()) s_manifestChanged = true;
+        s_updatedManifest[t_directory] = {
+            {"Context", t_context},
+            {"Libraries", updatedLibraries}
+        };
+        return result;
+    }
+
+    void Libraries::RecordStartupTime(std::string t_directory, std::string t_key, float t_milliseconds) {
+        std::lock_guard<std::recursive_mutex> lock(s_mutex);
+        for (auto& timing : s_timings) {
+            if (timing.name == t_directory + "/" + t_key) timing.startupMilliseconds += t_milliseconds;
+        }
+    }
+
+    void Libraries::FinishDiscovery() {
+        if (s_manifestChanged) {
+            try {
+                WriteFile(LIBRARIES_MANIFEST_PATH ".tmp", s_updatedManifest.dump());
+                std::filesystem::rename(LIBRARIES_MANIFEST_PATH ".tmp", LIBRARIES_MANIFEST_PATH);
+            } catch (...) {
+                RASTER_LOG("failed to write " << LIBRARIES_MANIFEST_PATH);
+            }
+            s_manifestChanged = false;
+        }
+        s_manifest = s_updatedManifest;
+
+        std::lock_guard<std::recursive_mutex> lock(s_mutex);
+        auto timings = s_timings;
+        std::sort(timings.begin(), timings.end(), [](auto& a, auto& b) { return a.loadMilliseconds + a.startupMilliseconds > b.loadMilliseconds + b.startupMilliseconds; });
+        float totalMilliseconds = 0.0f;
+        print(FormatString("%-48s %10s %10s", "library", "load (ms)", "startup (ms)"));
+        for (auto& timing : timings) {
+            print(FormatString("%-48s %10.2f %10.2f", timing.name.c_str(), timing.loadMilliseconds, timing.startupMilliseconds));
+            totalMilliseconds += timing.loadMilliseconds + timing.startupMilliseconds;
+        }
+        print(FormatString("%i libraries loaded in %.2f ms", (int) timings.size(), totalMilliseconds));
+    }
+};
@@ -10,6 +10,7 @@
 #include "common/audio_samples.h"
 #include "common/asset_id.h"
 #include "common/generic_audio_decoder.h"
+#include "common/profiler.h"
 #include "common/generic_resolution.h"
 #include "common/gradient_1d.h"
 #include "raster.h"
@@ -86,7 +87,7 @@ namespace Raster {
         }
         // if (!ExecutingInAudioContext(t_contextData)) Workspace::UpdatePinCache(t_accumulator); 
         if (RASTER_GET_CONTEXT_VALUE(t_contextData, "INCREMENT_EPF", bool)) executionsPerFrame.SetBackValue(executionsPerFrame.Get() + 1); 
-        auto pinMap = AbstractExecute(t_contextData);
+        auto pinMap = ProfiledExecute(t_contextData);
         if (!ExecutingInAudioContext(t_contextData)) Workspace::UpdatePinCache(pinMap);
         auto outputPin = flowOutputPin.value_or(GenericPin());
         if (outputPin.connectedPinID > 0) {
@@ -348,7 +349,7 @@ namespace Raster {
 
         auto targetNode = Workspace::GetNodeByPinID(attributePin.connectedPinID);
         if (targetNode.has_value() && targetNode.value()->enabled) {
-            auto pinMap = targetNode.value()->AbstractExecute(t_contextData);
+            auto pinMap = targetNode.value()->ProfiledExecute(t_contextData);
             if (!ExecutingInAudioContext(t_contextData)) Workspace::UpdatePinCache(pinMap);
             auto dynamicAttribute = pinMap[attributePin.connectedPinID];
             if (RASTER_GET_CONTEXT_VALUE(t_contextData, "INCREMENT_EPF", bool)) targetNode.value()->executionsPerFrame.SetBackValue(targetNode.value()->executionsPerFrame.Get() + 1); 
@@ -513,6 +514,17 @@ namespace Raster {
         return AbstractGetContentDuration();
     }
 
+    AbstractPinMap NodeBase::ProfiledExecute(ContextData& t_contextData) {
+        bool audioContext = ExecutingInAudioContext(t_contextData);
+        // waveform computation isn't playback, so it stays out of live audio timings
+        bool waveformContext = RASTER_GET_CONTEXT_VALUE(t_contextData, "WAVEFORM_PASS", bool);
+        ProfilerScope profilerZone("Node", nodeID, audioContext, !waveformContext);
+        // audio thread has no GPU context
+        std::optional<ProfilerGPUScope> profilerGPUZone;
+        if (!audioContext) profilerGPUZone.emplace("Node", nodeID);
+        return AbstractExecute(t_contextData);
+    }
+
     bool NodeBase::ExecutingInAudioContext(ContextData& t_data) {
         return t_data.find("AUDIO_PASS") != t_data.end();
     }
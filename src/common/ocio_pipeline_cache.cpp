@@ -0,0 +1,132 @@
+#include "common/ocio_pipeline_cache.h"
+#include "common/color_management.h"
+
+namespace Raster {
+    std::unordered_map<std::string, std::weak_ptr<OCIOPipeline>> OCIOPipelineCache::s_pipelines;
+    std::mutex OCIOPipelineCache::s_mutex;
+
+    std::shared_ptr<OCIOPipeline> OCIOPipelineCache::Acquire(OCIO::ConstTransformRcPtr t_transform, OCIOBakeMode t_bakeMode) {
+        OCIO::ConstProcessorRcPtr processor;
+        try {
+            processor = ColorManagement::s_config->getProcessor(t_transform);
+        } catch (const OCIO::Exception& ex) {
+            RASTER_LOG("failed to create OCIO processor");
+            RASTER_LOG(ex.what());
+            return nullptr;
+        }
+
+        // dynamic properties can change every frame, so such transforms can't be baked
+        int edgeLength = 0;
+        if (t_bakeMode != OCIOBakeMode::None && !processor->isDynamic()) {
+            edgeLength = t_bakeMode == OCIOBakeMode::LUT33 ? 33 : 65;
+        }
+
+        std::string key = std::string(processor->getCacheID()) + "/" + std::to_string(edgeLength);
+        if (ColorManagement::s_useLegacyGPU) key += "/legacy";
+
+        RASTER_SYNCHRONIZED(s_mutex);
+        auto cachedIterator = s_pipelines.find(key);
+        if (cachedIterator != s_pipelines.end()) {
+            if (auto cachedPipeline = cachedIterator->second.lock()) {
+                return cachedPipeline;
+            }
+        }
+
+        std::optional<OCIOPipeline> pipelineCandidate;
+        if (edgeLength) pipelineCandidate = BakeLUT(processor, edgeLength);
+        if (!pipelineCandidate) pipelineCandidate = OCIOPipeline(t_transform);
+        if (!pipelineCandidate->valid) return nullptr;
+
+        std::shared_ptr<OCIOPipeline> pipeline(new OCIOPipeline(std::move(*pipelineCandidate)), [](OCIOPipeline* t_pipeline) {
+            t_pipeline->Destroy();
+            delete t_pipeline;
+        });
+
+        // dropping pipelines whose users are already gone
+        for (auto it = s_pipelines.begin(); it != s_pipelines.end();) {
+            if (it->second.expired()) it = s_pipelines.erase(it);
+            else it++;
+        }
+        s_pipelines[key] = pipeline;
+
+        return pipeline;
+    }
+
+    size_t OCIOPipelineCache::GetPipelinesCount() {
+        RASTER_SYNCHRONIZED(s_mutex);
+        size_t count = 0;
+        for (auto& pipeline : s_pipelines) {
+            if (!pipeline.second.expired()) count++;
+        }
+        return count;
+    }
+
+    std::optional<OCIOPipeline> OCIOPipelineCache::BakeLUT(OCIO::ConstProcessorRcPtr t_processor, int t_edgeLength) {
+        try {
+            auto bakeBegin = std::chrono::steady_clock::now();
+            auto cpuProcessor = t_processor->getOptimizedCPUProcessor(OCIO::OptimizationFlags::OPTIMIZATION_LOSSLESS);
+
+            // red is the fastest changing axis, matching the layout of Lut3DTransform
+            int entriesCount = t_edgeLength * t_edgeLength * t_edgeLength;
+            std::vector<float> values(entriesCount * 3);
+            float step = 1.0f / (float) (t_edgeLength - 1);
+            for (int b = 0; b < t_edgeLength; b++) {
+                for (int g = 0; g < t_edgeLength; g++) {
+                    for (int r = 0; r < t_edgeLength; r++) {
+                        int index = ((b * t_edgeLength + g) * t_edgeLength + r) * 3;
+                        values[index + 0] = r * step;
+                        values[index + 1] = g * step;
+                        values[index + 2] = b * step;
+                    }
+                }
+            }
+            OCIO::PackedImageDesc valuesImage(values.data(), entriesCount, 1, 3);
+            cpuProcessor->apply(valuesImage);
+
+            auto lut = OCIO::Lut3DTransform::Create(t_edgeLength);
+            for (int b = 0; b < t_edgeLength; b++) {
+                for (int g = 0; g < t_edgeLength; g++) {
+                    for (int r = 0; r < t_edgeLength; r++) {
+                        int index = ((b * t_edgeLength + g) * t_edgeLength + r) * 3;
+                        lut->setValue(r, g, b, values[index + 0], values[index + 1], values[index + 2]);
+                    }
+                }
+            }
+
+            // measuring error between lattice points, where the lut has to interpolate
+            static constexpr int s_probesPerAxis = 16;
+            std::vector<float> reference(s_probesPerAxis * s_probesPerAxis * s_probesPerAxis * 3);
+            for (int i = 0; i < reference.size() / 3; i++) {
+                reference[i * 3 + 0] = ((i % s_probesPerAxis) + 0.37f) / s_probesPerAxis;
+                reference[i * 3 + 1] = ((i / s_probesPerAxis % s_probesPerAxis) + 0.61f) / s_probesPerAxis;
+                reference[i * 3 + 2] = ((i / (s_probesPerAxis * s_probesPerAxis)) + 0.23f) / s_probesPerAxis;
+            }
+            auto approximation = reference;
+            OCIO::PackedImageDesc referenceImage(reference.data(), reference.size() / 3, 1, 3);
+            OCIO::PackedImageDesc approximationImage(approximation.data(), approximation.size() / 3, 1, 3);
+            cpuProcessor->apply(referenceImage);
+            ColorManagement::s_config->getProcessor(lut)->getDefaultCPUProcessor()->apply(approximationImage);
+
+            float maxError = 0.0f, errorSum = 0.0f;
+            for (int i = 0; i < reference.size(); i++) {
+                float error = std::abs(reference[i] - approximation[i]);
+                maxError = std::max(maxError, error);
+                errorSum += error;
+            }
+
+            OCIOPipeline pipeline(lut);
+            if (!pipeline.valid) return std::nullopt;
+            pipeline.bakeStatistics = OCIOBakeStatistics{
+                .edgeLength = t_edgeLength,
+                .maxError = maxError,
+                .averageError = errorSum / (float) reference.size(),
+                .bakeMilliseconds = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - bakeBegin).count()
+            };
+            return pipeline;
+        } catch (const OCIO::Exception& ex) {
+            RASTER_LOG("failed to bake OCIO transform into 3D LUT");
+            RASTER_LOG(ex.what());
+        }
+        return std::nullopt;
+    }
+};
@@ -10,18 +10,22 @@ namespace Raster {
     std::vector<AbstractPlugin> Plugins::s_plugins;
 
     void Plugins::Initialize() {
-        auto pluginIterator = std::filesystem::recursive_directory_iterator("plugins");
-        for (auto &entry : pluginIterator) {
-            std::string transformedPath = std::regex_replace(
-                GetBaseName(entry.path().string()), std::regex(".dll|.so|lib"), "");
-            Libraries::LoadLibrary("plugins", transformedPath);
-            auto pluginSpawn = Libraries::GetFunction<AbstractPlugin()>(transformedPath, "SpawnPlugin");
+        // plugins provide UI and initialization hooks which run before any of their code could be requested lazily,
+        // so every plugin is loaded and spawned here. Discover() still lists them and accounts their load and spawn times
+        auto libraries = Libraries::Discover("plugins", "", [](std::string t_key) -> Json {
+            return nullptr;
+        });
+        for (auto& library : libraries) {
+            Libraries::LoadLibrary("plugins", library.key);
+            auto spawnBegin = std::chrono::steady_clock::now();
             try {
+                auto pluginSpawn = Libraries::GetFunction<AbstractPlugin()>(library.key, "SpawnPlugin");
                 s_plugins.push_back(pluginSpawn());
-                print("instantiating plugin '" << transformedPath << "'");
+                print("instantiating plugin '" << library.key << "'");
             } catch (...) {
-                print("failed to instantiate plugin '" << transformedPath << "'");
+                print("failed to instantiate plugin '" << library.key << "'");
             }
+            Libraries::RecordStartupTime("plugins", library.key, std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - spawnBegin).count());
         }
     }
 
@@ -0,0 +1,317 @@
+#include "common/profiler.h"
+#include "common/workspace.h"
+#include "gpu/gpu.h"
+#include <deque>
+
+namespace Raster {
+    std::atomic<bool> Profiler::s_enabled = false;
+
+    struct ProfilerOpenZone {
+        ProfilerZone zone;
+        // time spent in nested node zones, excluded from self time of node zones
+        uint64_t nestedNodesTime;
+        bool audio;
+        bool updateNodeProfile;
+    };
+
+    struct ProfilerThread {
+        std::string name;
+        int id;
+        std::mutex mutex;
+        std::vector<ProfilerZone> zones;
+        uint64_t written;
+        // only accessed by the owning thread
+        std::vector<ProfilerOpenZone> openZones;
+
+        ProfilerThread() : id(0), zones(PROFILER_RING_BUFFER_SIZE), written(0) {}
+
+        void Write(ProfilerZone& t_zone) {
+            std::lock_guard<std::mutex> lock(mutex);
+            zones[written % zones.size()] = t_zone;
+            written++;
+        }
+    };
+
+    struct ProfilerGPUSegment {
+        void* query;
+        const char* name;
+        int nodeID;
+        uint64_t begin, frame;
+    };
+
+    static std::mutex s_threadsMutex;
+    static std::vector<std::shared_ptr<ProfilerThread>> s_threads;
+    // buffers of exited threads, reused by new threads so short-lived ones don't keep allocating tracks
+    static std::vector<std::shared_ptr<ProfilerThread>> s_freeThreads;
+
+    static void ReleaseThread(std::shared_ptr<ProfilerThread> t_thread) {
+        t_thread->openZones.clear();
+        std::lock_guard<std::mutex> lock(s_threadsMutex);
+        s_freeThreads.push_back(t_thread);
+    }
+
+    // hands buffer of a thread back to the free list once the thread exits
+    struct ProfilerThreadHandle {
+        std::shared_ptr<ProfilerThread> thread;
+
+        ~ProfilerThreadHandle() {
+            if (thread) ReleaseThread(thread);
+        }
+    };
+
+    // timer queries belong to a GPU context, so every thread keeps its own state
+    struct ProfilerGPUState {
+        std::vector<std::pair<const char*, int>> zones;
+        void* activeQuery;
+        uint64_t activeBegin;
+        std::deque<ProfilerGPUSegment> pending;
+        std::vector<void*> freeQueries;
+        uint64_t frame, resolvingFrame;
+        unordered_dense::map<int, uint64_t> resolvingNodeTimes;
+        ProfilerThreadHandle track;
+
+        ProfilerGPUState() : activeQuery(nullptr), activeBegin(0), frame(0), resolvingFrame(0) {}
+    };
+
+    static const auto s_epoch = std::chrono::steady_clock::now();
+
+    static std::mutex s_nodeProfilesMutex;
+    static unordered_dense::map<int, NodeProfile> s_nodeProfiles;
+
+    static thread_local ProfilerThreadHandle s_thread;
+    static thread_local ProfilerGPUState s_gpuState;
+
+    static std::shared_ptr<ProfilerThread> RegisterThread(std::string t_name) {
+        std::lock_guard<std::mutex> lock(s_threadsMutex);
+        if (!s_freeThreads.empty()) {
+            // zones of the exited thread stay in the buffer and are exported on the same track
+            auto thread = s_freeThreads.back();
+            s_freeThreads.pop_back();
+            std::lock_guard<std::mutex> threadLock(thread->mutex);
+            thread->name = t_name.empty() ? FormatString("Thread %i", thread->id) : t_name;
+            return thread;
+        }
+        auto thread = std::make_shared<ProfilerThread>();
+        thread->id = (int) s_threads.size() + 1;
+        thread->name = t_name.empty() ? FormatString("Thread %i", thread->id) : t_name;
+        s_threads.push_back(thread);
+        return thread;
+    }
+
+    static ProfilerThread& GetThread() {
+        if (!s_thread.thread) s_thread.thread = RegisterThread("");
+        return *s_thread.thread;
+    }
+
+    static void UpdateNodeProfile(int t_nodeID, float t_milliseconds, float NodeProfile::* t_field) {
+        std::lock_guard<std::mutex> lock(s_nodeProfilesMutex);
+        auto& profile = s_nodeProfiles[t_nodeID];
+        auto& value = profile.*t_field;
+        value = value == 0.0f ? t_milliseconds : glm::mix(value, t_milliseconds, PROFILER_SMOOTHING);
+    }
+
+    uint64_t Profiler::GetTimestamp() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - s_epoch).count();
+    }
+
+    void Profiler::SetEnabled(bool t_enabled) {
+        s_enabled = t_enabled;
+    }
+
+    void Profiler::SetThreadName(std::string t_name) {
+        auto& thread = GetThread();
+        std::lock_guard<std::mutex> lock(thread.mutex);
+        thread.name = t_name;
+    }
+
+    void Profiler::BeginZone(const char* t_name, int t_nodeID, bool t_audio, bool t_updateNodeProfile) {
+        auto& thread = GetThread();
+        ProfilerOpenZone openZone;
+        openZone.zone.name = t_name;
+        openZone.zone.nodeID = t_nodeID;
+        openZone.zone.begin = GetTimestamp();
+        openZone.zone.end = openZone.zone.begin;
+        openZone.nestedNodesTime = 0;
+        openZone.audio = t_audio;
+        openZone.updateNodeProfile = t_updateNodeProfile;
+        thread.openZones.push_back(openZone);
+    }
+
+    void Profiler::EndZone() {
+        auto& thread = GetThread();
+        if (thread.openZones.empty()) return;
+        auto openZone = thread.openZones.back();
+        thread.openZones.pop_back();
+
+        auto& zone = openZone.zone;
+        zone.end = GetTimestamp();
+        uint64_t duration = zone.end - zone.begin;
+        if (!thread.openZones.empty()) {
+            // generic zones pass nested node time through, so node self time stays exclusive of its inputs only
+            thread.openZones.back().nestedNodesTime += zone.nodeID ? duration : openZone.nestedNodesTime;
+        }
+        thread.Write(zone);
+
+        if (zone.nodeID && openZone.updateNodeProfile) {
+            float selfMilliseconds = (duration - std::min(duration, openZone.nestedNodesTime)) / 1e6f;
+            UpdateNodeProfile(zone.nodeID, selfMilliseconds, openZone.audio ? &NodeProfile::audioMilliseconds : &NodeProfile::cpuMilliseconds);
+        }
+    }
+
+    static void BeginGPUSegment(ProfilerGPUState& t_state) {
+        if (t_state.freeQueries.empty()) {
+            t_state.activeQuery = GPU::GenerateTimerQuery();
+        } else {
+            t_state.activeQuery = t_state.freeQueries.back();
+            t_state.freeQueries.pop_back();
+        }
+        t_state.activeBegin = Profiler::GetTimestamp();
+        GPU::BeginTimerQuery(t_state.activeQuery);
+    }
+
+    static void EndGPUSegment(ProfilerGPUState& t_state) {
+        if (!t_state.activeQuery) return;
+        GPU::EndTimerQuery();
+        auto& zone = t_state.zones.back();
+        t_state.pending.push_back({t_state.activeQuery, zone.first, zone.second, t_state.activeBegin, t_state.frame});
+        t_state.activeQuery = nullptr;
+    }
+
+    void Profiler::BeginGPUZone(const char* t_name, int t_nodeID) {
+        if (!GPU::info.timerQueriesSupported) return;
+        auto& state = s_gpuState;
+        // only one timer query can be active at a time, so outer zone is split around the nested one
+        if (!state.zones.empty()) EndGPUSegment(state);
+        state.zones.push_back({t_name, t_nodeID});
+        BeginGPUSegment(state);
+    }
+
+    void Profiler::EndGPUZone() {
+        if (!GPU::info.timerQueriesSupported) return;
+        auto& state = s_gpuState;
+        if (state.zones.empty()) return;
+        EndGPUSegment(state);
+        state.zones.pop_back();
+        if (!state.zones.empty()) BeginGPUSegment(state);
+    }
+
+    static void CommitGPUFrame(ProfilerGPUState& t_state) {
+        for (auto& [nodeID, time] : t_state.resolvingNodeTimes) {
+            UpdateNodeProfile(nodeID, time / 1e6f, &NodeProfile::gpuMilliseconds);
+        }
+        t_state.resolvingNodeTimes.clear();
+    }
+
+    void Profiler::CollectGPUZones() {
+        if (!GPU::info.timerQueriesSupported) return;
+        auto& state = s_gpuState;
+        while (!state.pending.empty()) {
+            auto segment = state.pending.front();
+            auto resultCandidate = GPU::GetTimerQueryResult(segment.query);
+            if (!resultCandidate.has_value()) break;
+            state.pending.pop_front();
+            state.freeQueries.push_back(segment.query);
+
+            if (segment.frame != state.resolvingFrame) {
+                CommitGPUFrame(state);
+                state.resolvingFrame = segment.frame;
+            }
+            if (segment.nodeID) state.resolvingNodeTimes[segment.nodeID] += resultCandidate.value();
+
+            // GPU timings have no timestamps of their own, they're placed at the moment they were submitted
+            if (!state.track.thread) state.track.thread = RegisterThread(GetThread().name + " (GPU)");
+            ProfilerZone zone;
+            zone.name = segment.name;
+            zone.nodeID = segment.nodeID;
+            zone.begin = segment.begin;
+            zone.end = segment.begin + resultCandidate.value();
+            state.track.thread->Write(zone);
+        }
+        if (state.pending.empty()) CommitGPUFrame(state);
+        state.frame++;
+    }
+
+    std::optional<NodeProfile> Profiler::GetNodeProfile(int t_nodeID) {
+        std::lock_guard<std::mutex> lock(s_nodeProfilesMutex);
+        auto iterator = s_nodeProfiles.find(t_nodeID);
+        if (iterator == s_nodeProfiles.end()) return std::nullopt;
+        return iterator->second;
+    }
+
+    bool Profiler::ExportChromeTrace(std::string t_path) {
+        std::vector<std::shared_ptr<ProfilerThread>> threads;
+        {
+            std::lock_guard<std::mutex> lock(s_threadsMutex);
+            threads = s_threads;
+        }
+
+        unordered_dense::map<int, std::string> nodeNames;
+        Json events = Json::array();
+        for (auto& thread : threads) {
+            std::vector<ProfilerZone> zones;
+            std::string threadName;
+            {
+                std::lock_guard<std::mutex> lock(thread->mutex);
+                threadName = thread->name;
+                uint64_t count = std::min<uint64_t>(thread->written, thread->zones.size());
+                for (uint64_t i = thread->written - count; i < thread->written; i++) {
+                    zones.push_back(thread->zones[i % thread->zones.size()]);
+                }
+            }
+
+            events.push_back({
+                {"name", "thread_name"},
+                {"ph", "M"},
+                {"pid", 0},
+                {"tid", thread->id},
+                {"args", {{"name", threadName}}}
+            });
+            for (auto& zone : zones) {
+                std::string name = zone.name;
+                Json args = Json::object();
+                if (zone.nodeID) {
+                    if (nodeNames.find(zone.nodeID) == nodeNames.end()) {
+                        auto nodeCandidate = Workspace::GetNodeByNodeID(zone.nodeID);
+                        nodeNames[zone.nodeID] = nodeCandidate.has_value() ? nodeCandidate.value()->Header() : FormatString("Node %i", zone.nodeID);
+                    }
+                    name = nodeNames[zone.nodeID];
+                    args["NodeID"] = zone.nodeID;
+                }
+                events.push_back({
+                    {"name", name},
+                    {"cat", zone.nodeID ? "node" : "zone"},
+                    {"ph", "X"},
+                    {"pid", 0},
+                    {"tid", thread->id},
+                    // trace timestamps are expressed in microseconds
+                    {"ts", zone.begin / 1e3},
+                    {"dur", (zone.end - zone.begin) / 1e3},
+                    {"args", args}
+                });
+            }
+        }
+
+        try {
+            WriteFile(t_path, Json({
+                {"traceEvents", events},
+                {"displayTimeUnit", "ms"}
+            }).dump());
+        } catch (...) {
+            RASTER_LOG("failed to export profiler trace to " << t_path);
+            return false;
+        }
+        return true;
+    }
+
+    void Profiler::Clear() {
+        {
+            std::lock_guard<std::mutex> lock(s_threadsMutex);
+            for (auto& thread : s_threads) {
+                std::lock_guard<std::mutex> threadLock(thread->mutex);
+                thread->written = 0;
+            }
+        }
+        std::lock_guard<std::mutex> lock(s_nodeProfilesMutex);
+        s_nodeProfiles.clear();
+    }
+};
@@ -3,6 +3,9 @@
 #include "raster.h"
 #include "common/common.h"
 #include "common/rendering.h"
+#include "common/task_scheduler.h"
+#include "common/audio_memory_management.h"
+#include "common/composition_index.h"
 
 namespace Raster {
     Project::Project(Json data) {
@@ -109,10 +112,10 @@ namespace Raster {
     }
 
     std::optional<Camera> Project::GetCamera() {
-        for (int i = compositions.size(); i --> 0;) {
-            auto& composition = compositions[i];
+        auto activeCompositions = CompositionIndex::GetActiveCompositions(*this, GetCorrectCurrentTime());
+        for (int i = activeCompositions.size(); i --> 0;) {
+            auto& composition = compositions[activeCompositions[i]];
             if (!composition.enabled) continue;
-            if (!IsInBounds(GetCorrectCurrentTime(), composition.beginFrame - 1, composition.endFrame + 1)) continue;
             for (auto& attribute : composition.attributes) {
                 if (attribute->packageName != RASTER_PACKAGED "camera_attribute") continue;
                 auto cameraCandidate = attribute->Get(GetCorrectCurrentTime() - composition.beginFrame, &composition);
@@ -124,10 +127,10 @@ namespace Raster {
     }
 
     std::optional<AbstractAttribute> Project::GetCameraAttribute() {
-        for (int i = compositions.size(); i --> 0;) {
-            auto& composition = compositions[i];
+        auto activeCompositions = CompositionIndex::GetActiveCompositions(*this, GetCorrectCurrentTime());
+        for (int i = activeCompositions.size(); i --> 0;) {
+            auto& composition = compositions[activeCompositions[i]];
             if (!composition.enabled) continue;
-            if (!IsInBounds(GetCorrectCurrentTime(), composition.beginFrame - 1, composition.endFrame + 1)) continue;
             for (auto& attribute : composition.attributes) {
                 if (attribute->packageName != RASTER_PACKAGED "camera_attribute") continue;
                 auto cameraCandidate = attribute->Get(GetCorrectCurrentTime() - composition.beginFrame, &composition);
@@ -161,16 +164,104 @@ namespace Raster {
     }
 
     void Project::Traverse(ContextData t_data) {
+        float currentTime = GetCorrectCurrentTime();
+        auto activeIndices = CompositionIndex::GetActiveCompositions(*this, currentTime);
         if (RASTER_GET_CONTEXT_VALUE(t_data, "RESET_WORKSPACE_STATE", bool)) {
             Workspace::s_pinCache.Get().clear();
+            ResetInactiveCompositions(activeIndices, currentTime);
         }
-        for (auto& composition : compositions) {
-            composition.Traverse(t_data);
+        std::vector<Composition*> activeCompositions;
+        for (auto index : activeIndices) activeCompositions.push_back(&compositions[index]);
+
+        // audio nodes only do CPU work, so independent compositions can be mixed concurrently
+        // rendering passes stay on the rendering thread because nodes submit GPU work while executing
+        bool parallelAudioPass = RASTER_GET_CONTEXT_VALUE(t_data, "AUDIO_PASS", bool) && !RASTER_GET_CONTEXT_VALUE(t_data, "WAVEFORM_PASS", bool);
+        if (parallelAudioPass && TaskScheduler::GetWorkersCount() > 0 && activeCompositions.size() > 1) {
+            auto audioPassID = RASTER_GET_CONTEXT_VALUE(t_data, "AUDIO_PASS_ID", int);
+            auto groups = GetIndependentCompositionGroups(activeIndices);
+            TaskScheduler::ParallelFor(groups.size(), [&](size_t t_groupIndex) {
+                AudioMemoryManagement::ResetForPass(audioPassID);
+                for (auto composition : groups[t_groupIndex]) {
+                    composition->Traverse(t_data);
+                }
+            });
+        } else {
+            for (auto composition : activeCompositions) {
+                composition->Traverse(t_data);
+            }
         }
 
         timeTravelStack.Get().clear();
     }
 
+    void Project::ResetInactiveCompositions(const std::vector<int>& t_activeIndices, float t_time) {
+        // inactive compositions are no longer traversed, so their per-frame node state is reset once when they go idle
+        auto resetComposition = [](Composition& t_composition) {
+            for (auto& pair : t_composition.nodes) {
+                pair.second->executionsPerFrame.Set(0);
+            }
+        };
+        auto revision = CompositionIndex::GetRevision();
+        std::vector<int> activated, deactivated;
+        if (m_lastResetTime.has_value() && m_lastResetRevision == revision && CompositionIndex::GetActivationChanges(*this, *m_lastResetTime, t_time, activated, deactivated)) {
+            for (auto index : deactivated) resetComposition(compositions[index]);
+        } else {
+            // compositions were edited since the last reset, so any of them might have gone idle
+            for (int i = 0; i < compositions.size(); i++) {
+                if (!std::binary_search(t_activeIndices.begin(), t_activeIndices.end(), i)) resetComposition(compositions[i]);
+            }
+        }
+        m_lastResetTime = t_time;
+        m_lastResetRevision = revision;
+    }
+
+    std::vector<std::vector<Composition*>> Project::GetIndependentCompositionGroups(const std::vector<int>& t_activeIndices) {
+        // compositions whose nodes are linked to each other must be traversed by the same thread,
+        // links through inactive compositions still count because their nodes may be pulled by active ones
+        std::vector<int> parents(compositions.size());
+        for (int i = 0; i < parents.size(); i++) parents[i] = i;
+        auto findRoot = [&](int t_index) {
+            while (parents[t_index] != t_index) {
+                parents[t_index] = parents[parents[t_index]];
+                t_index = parents[t_index];
+            }
+            return t_index;
+        };
+
+        unordered_dense::map<int, int> pinCompositions;
+        std::vector<std::pair<int, int>> links;
+        auto registerPin = [&](GenericPin& t_pin, int t_compositionIndex) {
+            pinCompositions[t_pin.pinID] = t_compositionIndex;
+            if (t_pin.connectedPinID > 0) links.push_back({t_compositionIndex, t_pin.connectedPinID});
+        };
+        for (int i = 0; i < compositions.size(); i++) {
+            for (auto& pair : compositions[i].nodes) {
+                auto& node = pair.second;
+                if (node->flowInputPin) registerPin(*node->flowInputPin, i);
+                if (node->flowOutputPin) registerPin(*node->flowOutputPin, i);
+                for (auto& pin : node->inputPins) registerPin(pin, i);
+                for (auto& pin : node->outputPins) registerPin(pin, i);
+            }
+        }
+        for (auto& link : links) {
+            auto compositionIterator = pinCompositions.find(link.second);
+            if (compositionIterator == pinCompositions.end()) continue;
+            parents[findRoot(link.first)] = findRoot(compositionIterator->second);
+        }
+
+        std::vector<std::vector<Composition*>> groups;
+        unordered_dense::map<int, int> groupIndices;
+        for (auto i : t_activeIndices) {
+            int root = findRoot(i);
+            if (groupIndices.find(root) == groupIndices.end()) {
+                groupIndices[root] = groups.size();
+                groups.push_back({});
+            }
+            groups[groupIndices[root]].push_back(&compositions[i]);
+        }
+        return groups;
+    }
+
     void Project::SetFakeTime(float t_frame) {
         auto& fakeTime = m_fakeTime.Get();
         fakeTime = t_frame;
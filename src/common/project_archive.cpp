@@ -0,0 +1,325 @@
+#include "common/project_archive.h"
+
+#define MINIZ_HEADER_FILE_ONLY
+#include "zip/miniz.h"
+
+namespace Raster {
+
+    struct ProjectArchiveEntry {
+        mz_uint index;
+        bool stored;
+        std::uintmax_t size;
+        std::optional<std::uintmax_t> dataOffset;
+    };
+
+    // s_archiveMutex guards the bookkeeping, s_readerMutex the miniz reader which isn't thread-safe
+    static std::mutex s_archiveMutex, s_readerMutex;
+    static std::optional<mz_zip_archive> s_archive;
+    static std::string s_archivePath;
+    static std::unordered_map<std::string, ProjectArchiveEntry> s_entries;
+    static std::unordered_map<std::string, ZIPEntryState> s_extractedEntries;
+    static std::unordered_map<std::string, std::shared_future<bool>> s_extractions;
+    static std::filesystem::file_time_type s_openTime;
+    // streams still reading from the archive file, keyed by entry name
+    static std::vector<std::pair<std::string, std::weak_ptr<ProjectArchiveStream>>> s_streams;
+
+    static std::string NormalizeEntryName(std::string t_path) {
+        return std::filesystem::path(t_path).lexically_normal().generic_string();
+    }
+
+    static bool SeekFile(std::FILE* t_file, std::uintmax_t t_offset) {
+        #ifdef RASTER_PLATFORM_WINDOWS
+            return _fseeki64(t_file, (int64_t) t_offset, SEEK_SET) == 0;
+        #else
+            return fseeko(t_file, (off_t) t_offset, SEEK_SET) == 0;
+        #endif
+    }
+
+    ProjectArchiveStream::ProjectArchiveStream(std::string t_archivePath, std::uintmax_t t_offset, std::uintmax_t t_size) {
+        this->m_file = std::fopen(t_archivePath.c_str(), "rb");
+        this->m_offset = t_offset;
+        this->m_size = t_size;
+        this->m_position = 0;
+    }
+
+    ProjectArchiveStream::~ProjectArchiveStream() {
+        if (m_file) std::fclose(m_file);
+    }
+
+    bool ProjectArchiveStream::IsOpened() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_file != nullptr;
+    }
+
+    void ProjectArchiveStream::Reopen(std::optional<std::string> t_path, std::uintmax_t t_offset) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_file) std::fclose(m_file);
+        m_file = t_path.has_value() ? std::fopen(t_path->c_str(), "rb") : nullptr;
+        m_offset = t_offset;
+    }
+
+    size_t ProjectArchiveStream::Read(uint8_t* t_data, size_t t_size) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_file || m_position >= m_size) return 0;
+        t_size = (size_t) std::min<std::uintmax_t>(t_size, m_size - m_position);
+        if (!SeekFile(m_file, m_offset + m_position)) return 0;
+        auto readCount = std::fread(t_data, 1, t_size, m_file);
+        m_position += readCount;
+        return readCount;
+    }
+
+    int64_t ProjectArchiveStream::Seek(int64_t t_offset, int t_whence) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        int64_t base = 0;
+        if (t_whence == SEEK_CUR) base = (int64_t) m_position;
+        if (t_whence == SEEK_END) base = (int64_t) m_size;
+        int64_t position = base + t_offset;
+        if (position < 0 || position > (int64_t) m_size) return -1;
+        m_position = (std::uintmax_t) position;
+        return position;
+    }
+
+    std::uintmax_t ProjectArchiveStream::GetSize() {
+        return m_size;
+    }
+
+    std::optional<ZIPManifest> ProjectArchive::Open(std::string t_archivePath, std::string t_directory) {
+        Close();
+        RASTER_SYNCHRONIZED(s_archiveMutex);
+        std::lock_guard<std::mutex> readerLock(s_readerMutex);
+
+        mz_zip_archive archive;
+        mz_zip_zero_struct(&archive);
+        if (!mz_zip_reader_init_file(&archive, t_archivePath.c_str(), 0)) return std::nullopt;
+
+        ZIPManifest manifest;
+        manifest.archivePath = t_archivePath;
+        s_openTime = std::filesystem::file_time_type::clock::now();
+        std::uintmax_t liveBytes = 0;
+
+        std::optional<mz_uint> journalIndex;
+        auto journalName = NormalizeEntryName(t_directory + "/.journal.json");
+        mz_uint entriesCount = mz_zip_reader_get_num_files(&archive);
+        for (mz_uint i = 0; i < entriesCount; i++) {
+            mz_zip_archive_file_stat stat;
+            if (!mz_zip_reader_file_stat(&archive, i, &stat) || stat.m_is_directory) continue;
+            auto name = NormalizeEntryName(stat.m_filename);
+            if (name == journalName) {
+                journalIndex = i;
+                continue;
+            }
+
+            // appended entries come later in the central directory and replace the stale ones
+            ProjectArchiveEntry entry;
+            entry.index = i;
+            entry.stored = stat.m_method == 0 && !stat.m_is_encrypted;
+            entry.size = stat.m_uncomp_size;
+            s_entries[name] = entry;
+        }
+
+        if (journalIndex.has_value()) {
+            size_t journalSize = 0;
+            auto journalData = (char*) mz_zip_reader_extract_to_heap(&archive, journalIndex.value(), &journalSize, 0);
+            if (journalData) {
+                try {
+                    for (auto& removedName : Json::parse(std::string(journalData, journalSize))) {
+                        std::string normalizedName = NormalizeEntryName(removedName);
+                        manifest.removedEntries.insert(normalizedName);
+                        s_entries.erase(normalizedName);
+                    }
+                } catch (...) {
+                    RASTER_LOG("failed to parse project journal in " << t_archivePath);
+                }
+                mz_free(journalData);
+            }
+        }
+
+        for (auto& [name, entry] : s_entries) {
+            ZIPEntryState state;
+            state.size = entry.size;
+            state.modificationTime = s_openTime.time_since_epoch().count();
+            manifest.entries[name] = state;
+            liveBytes += entry.size;
+        }
+        std::error_code error;
+        auto archiveSize = std::filesystem::file_size(t_archivePath, error);
+        // entries are stored uncompressed, so everything beyond live data is roughly stale
+        if (!error && archiveSize > liveBytes) manifest.staleBytes = archiveSize - liveBytes;
+
+        s_archive = archive;
+        s_archivePath = t_archivePath;
+        return manifest;
+    }
+
+    void ProjectArchive::Close() {
+        std::unordered_map<std::string, std::shared_future<bool>> extractions;
+        {
+            RASTER_SYNCHRONIZED(s_archiveMutex);
+            extractions = s_extractions;
+        }
+        for (auto& [name, extraction] : extractions) extraction.wait();
+
+        RASTER_SYNCHRONIZED(s_archiveMutex);
+        std::lock_guard<std::mutex> readerLock(s_readerMutex);
+        for (auto& [name, weakStream] : s_streams) {
+            auto stream = weakStream.lock();
+            if (stream) stream->Reopen(std::nullopt);
+        }
+        s_streams.clear();
+        if (s_archive.has_value()) mz_zip_reader_end(&s_archive.value());
+        s_archive = std::nullopt;
+        s_archivePath = "";
+        s_entries.clear();
+        s_extractions.clear();
+        s_extractedEntries.clear();
+    }
+
+    bool ProjectArchive::Exists(std::string t_path) {
+        std::error_code error;
+        if (std::filesystem::is_regular_file(t_path, error)) return true;
+        RASTER_SYNCHRONIZED(s_archiveMutex);
+        return s_entries.find(NormalizeEntryName(t_path)) != s_entries.end();
+    }
+
+    std::optional<std::uintmax_t> ProjectArchive::GetFileSize(std::string t_path) {
+        std::error_code error;
+        if (std::filesystem::is_regular_file(t_path, error)) return std::filesystem::file_size(t_path, error);
+        RASTER_SYNCHRONIZED(s_archiveMutex);
+        auto entryIterator = s_entries.find(NormalizeEntryName(t_path));
+        if (entryIterator == s_entries.end()) return std::nullopt;
+        return entryIterator->second.size;
+    }
+
+    bool ProjectArchive::Extract(std::string t_path) {
+        auto name = NormalizeEntryName(t_path);
+        std::error_code error;
+        ProjectArchiveEntry entry;
+        {
+            RASTER_SYNCHRONIZED(s_archiveMutex);
+            if (std::filesystem::is_regular_file(name, error)) return true;
+            auto entryIterator = s_entries.find(name);
+            if (!s_archive.has_value() || entryIterator == s_entries.end()) return false;
+            entry = entryIterator->second;
+        }
+
+        // extract next to the target so that readers never see a partially written file
+        auto temporaryPath = name + ".extracting";
+        std::filesystem::create_directories(std::filesystem::path(name).parent_path(), error);
+        bool extracted = false;
+        {
+            RASTER_SYNCHRONIZED(s_readerMutex);
+            extracted = s_archive.has_value() && mz_zip_reader_extract_to_file(&s_archive.value(), entry.index, temporaryPath.c_str(), 0);
+        }
+        if (!extracted) {
+            RASTER_LOG("failed to extract " << name << " from " << s_archivePath);
+            std::filesystem::remove(temporaryPath, error);
+            return false;
+        }
+        std::filesystem::rename(temporaryPath, name, error);
+        if (error) return false;
+
+        ZIPEntryState state;
+        state.size = entry.size;
+        state.modificationTime = std::filesystem::last_write_time(name, error).time_since_epoch().count();
+
+        RASTER_SYNCHRONIZED(s_archiveMutex);
+        s_extractedEntries[name] = state;
+        s_entries.erase(name);
+        return true;
+    }
+
+    bool ProjectArchive::RequestExtraction(std::string t_path) {
+        auto name = NormalizeEntryName(t_path);
+        std::error_code error;
+        if (std::filesystem::is_regular_file(name, error)) return true;
+
+        RASTER_SYNCHRONIZED(s_archiveMutex);
+        if (s_entries.find(name) == s_entries.end()) return false;
+        auto extractionIterator = s_extractions.find(name);
+        if (extractionIterator == s_extractions.end()) {
+            s_extractions[name] = std::async(std::launch::async, [name]() {
+                return Extract(name);
+            }).share();
+        }
+        return false;
+    }
+
+    void ProjectArchive::DetachStreams() {
+        RASTER_SYNCHRONIZED(s_archiveMutex);
+        std::error_code error;
+        for (auto& [name, weakStream] : s_streams) {
+            auto stream = weakStream.lock();
+            if (!stream) continue;
+            if (std::filesystem::is_regular_file(name, error)) {
+                stream->Reopen(name);
+            } else stream->Reopen(std::nullopt);
+        }
+        s_streams.clear();
+    }
+
+    void ProjectArchive::ExtractAll() {
+        for (auto& name : GetArchivedEntries()) {
+            Extract(name);
+        }
+    }
+
+    std::shared_ptr<ProjectArchiveStream> ProjectArchive::OpenStream(std::string t_path) {
+        auto name = NormalizeEntryName(t_path);
+        std::error_code error;
+        if (std::filesystem::is_regular_file(name, error)) return nullptr;
+
+        RASTER_SYNCHRONIZED(s_archiveMutex);
+        auto entryIterator = s_entries.find(name);
+        if (!s_archive.has_value() || entryIterator == s_entries.end()) return nullptr;
+        auto& entry = entryIterator->second;
+        if (!entry.stored) return nullptr;
+
+        if (!entry.dataOffset.has_value()) {
+            mz_zip_archive_file_stat stat;
+            {
+                RASTER_SYNCHRONIZED(s_readerMutex);
+                if (!mz_zip_reader_file_stat(&s_archive.value(), entry.index, &stat)) return nullptr;
+            }
+
+            // local header is 30 bytes followed by the file name and the extra field
+            uint8_t localHeader[30];
+            std::FILE* archiveFile = std::fopen(s_archivePath.c_str(), "rb");
+            if (!archiveFile) return nullptr;
+            bool headerRead = SeekFile(archiveFile, stat.m_local_header_ofs) &&
+                                std::fread(localHeader, 1, sizeof(localHeader), archiveFile) == sizeof(localHeader);
+            std::fclose(archiveFile);
+            if (!headerRead || localHeader[0] != 'P' || localHeader[1] != 'K' || localHeader[2] != 3 || localHeader[3] != 4) return nullptr;
+            std::uintmax_t nameLength = localHeader[26] | (localHeader[27] << 8);
+            std::uintmax_t extraLength = localHeader[28] | (localHeader[29] << 8);
+            entry.dataOffset = stat.m_local_header_ofs + sizeof(localHeader) + nameLength + extraLength;
+        }
+
+        auto stream = std::make_shared<ProjectArchiveStream>(s_archivePath, entry.dataOffset.value(), entry.size);
+        if (!stream->IsOpened()) return nullptr;
+        s_streams.erase(std::remove_if(s_streams.begin(), s_streams.end(), [](auto& pair) { return pair.second.expired(); }), s_streams.end());
+        s_streams.push_back({name, stream});
+        return stream;
+    }
+
+    void ProjectArchive::Forget(std::string t_path) {
+        RASTER_SYNCHRONIZED(s_archiveMutex);
+        s_entries.erase(NormalizeEntryName(t_path));
+    }
+
+    std::set<std::string> ProjectArchive::GetArchivedEntries() {
+        RASTER_SYNCHRONIZED(s_archiveMutex);
+        std::set<std::string> entries;
+        for (auto& [name, entry] : s_entries) entries.insert(name);
+        return entries;
+    }
+
+    void ProjectArchive::UpdateManifest(ZIPManifest& t_manifest) {
+        RASTER_SYNCHRONIZED(s_archiveMutex);
+        if (t_manifest.archivePath != s_archivePath) return;
+        for (auto& [name, state] : s_extractedEntries) {
+            // files that were already edited after extraction stay different from the recorded state
+            if (t_manifest.entries.find(name) != t_manifest.entries.end()) t_manifest.entries[name] = state;
+        }
+        s_extractedEntries.clear();
+    }
+};
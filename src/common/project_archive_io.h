@@ -0,0 +1,49 @@
+#pragma once
+
+#include "raster.h"
+#include "common/project_archive.h"
+#include "../avcpp/formatcontext.h"
+
+namespace Raster {
+
+    // lets avformat demux media that is stored uncompressed inside of the project archive
+    struct ProjectArchiveIO : public av::CustomIO {
+        std::shared_ptr<ProjectArchiveStream> stream;
+        std::string path;
+
+        ProjectArchiveIO(std::shared_ptr<ProjectArchiveStream> t_stream, std::string t_path) : stream(t_stream), path(t_path) {}
+
+        int read(uint8_t* t_data, size_t t_size) override {
+            auto readCount = stream->Read(t_data, t_size);
+            return readCount == 0 ? AVERROR_EOF : (int) readCount;
+        }
+
+        int64_t seek(int64_t t_offset, int t_whence) override {
+            if (t_whence & AVSEEK_SIZE) return (int64_t) stream->GetSize();
+            return stream->Seek(t_offset, t_whence & ~AVSEEK_FORCE);
+        }
+
+        int seekable() const override {
+            return AVIO_SEEKABLE_NORMAL;
+        }
+
+        const char* name() const override {
+            return path.c_str();
+        }
+    };
+
+    // opens t_path from disk, or straight from the archive if it wasn't extracted yet
+    // t_io must outlive t_formatCtx
+    static inline void OpenProjectInput(av::FormatContext& t_formatCtx, std::shared_ptr<av::CustomIO>& t_io, std::string t_path, av::OptionalErrorCode t_ec = av::throws()) {
+        auto stream = ProjectArchive::OpenStream(t_path);
+        if (stream) {
+            t_io = std::make_shared<ProjectArchiveIO>(stream, t_path);
+            t_formatCtx.openInput(t_io.get(), t_ec);
+            return;
+        }
+        // compressed entries have to be extracted before they can be decoded
+        ProjectArchive::Extract(t_path);
+        t_io = nullptr;
+        t_formatCtx.openInput(t_path, t_ec);
+    }
+};
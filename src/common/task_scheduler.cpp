@@ -0,0 +1,150 @@
+#include "common/task_scheduler.h"
+#include <deque>
+
+namespace Raster {
+
+    struct TaskBatch {
+        std::function<void(size_t)> body;
+        std::atomic<size_t> remaining;
+        std::mutex mutex;
+        std::condition_variable finished;
+    };
+
+    struct Task {
+        std::shared_ptr<TaskBatch> batch;
+        size_t index;
+    };
+
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    static std::vector<std::unique_ptr<WorkerQueue>> s_queues;
+    static std::vector<std::thread> s_workers;
+    static std::atomic<bool> s_running = false;
+    static std::atomic<int> s_pendingTasks = 0;
+    static std::atomic<size_t> s_nextQueue = 0;
+    static std::mutex s_wakeMutex;
+    static std::condition_variable s_wake;
+
+    static bool TryPopTask(int t_preferredQueue, Task& t_task) {
+        int queuesCount = s_queues.size();
+        // own queue is consumed from the front, others are stolen from the back
+        for (int offset = 0; offset < queuesCount; offset++) {
+            auto& queue = *s_queues[(t_preferredQueue + offset) % queuesCount];
+            RASTER_SYNCHRONIZED(queue.mutex);
+            if (queue.tasks.empty()) continue;
+            if (offset == 0) {
+                t_task = std::move(queue.tasks.front());
+                queue.tasks.pop_front();
+            } else {
+                t_task = std::move(queue.tasks.back());
+                queue.tasks.pop_back();
+            }
+            s_pendingTasks--;
+            return true;
+        }
+        return false;
+    }
+
+    static void RunTask(Task& t_task) {
+        auto& batch = *t_task.batch;
+        try {
+            batch.body(t_task.index);
+        } catch (const std::exception& ex) {
+            RASTER_LOG("unhandled exception in scheduled task: " << ex.what());
+        } catch (...) {
+            RASTER_LOG("unhandled unknown exception in scheduled task");
+        }
+        if (--batch.remaining == 0) {
+            RASTER_SYNCHRONIZED(batch.mutex);
+            batch.finished.notify_all();
+        }
+    }
+
+    static void WorkerLoop(int t_workerIndex) {
+        while (s_running) {
+            Task task;
+            if (TryPopTask(t_workerIndex, task)) {
+                RunTask(task);
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(s_wakeMutex);
+            s_wake.wait(lock, []() {
+                return !s_running || s_pendingTasks > 0;
+            });
+        }
+    }
+
+    void TaskScheduler::Initialize(int t_workersCount) {
+        if (t_workersCount <= 0) {
+            // leaving room for rendering and audio threads
+            t_workersCount = std::max((int) std::thread::hardware_concurrency() - 2, 1);
+        }
+        RASTER_LOG("starting task scheduler with " << t_workersCount << " workers");
+        s_running = true;
+        for (int i = 0; i < t_workersCount; i++) {
+            s_queues.push_back(std::make_unique<WorkerQueue>());
+        }
+        for (int i = 0; i < t_workersCount; i++) {
+            s_workers.push_back(std::thread(WorkerLoop, i));
+        }
+    }
+
+    void TaskScheduler::Terminate() {
+        {
+            RASTER_SYNCHRONIZED(s_wakeMutex);
+            s_running = false;
+        }
+        s_wake.notify_all();
+        for (auto& worker : s_workers) {
+            worker.join();
+        }
+        s_workers.clear();
+        s_queues.clear();
+    }
+
+    void TaskScheduler::ParallelFor(size_t t_count, std::function<void(size_t)> t_body) {
+        if (t_count == 0) return;
+        if (t_count == 1 || s_workers.empty() || !s_running) {
+            for (size_t i = 0; i < t_count; i++) {
+                t_body(i);
+            }
+            return;
+        }
+
+        auto batch = std::make_shared<TaskBatch>();
+        batch->body = std::move(t_body);
+        batch->remaining = t_count;
+
+        size_t firstQueue = s_nextQueue.fetch_add(1);
+        for (size_t i = 0; i < t_count; i++) {
+            auto& queue = *s_queues[(firstQueue + i) % s_queues.size()];
+            RASTER_SYNCHRONIZED(queue.mutex);
+            queue.tasks.push_back(Task{batch, i});
+        }
+        {
+            RASTER_SYNCHRONIZED(s_wakeMutex);
+            s_pendingTasks += t_count;
+        }
+        s_wake.notify_all();
+
+        // helping the workers instead of idling until the batch is done
+        while (batch->remaining > 0) {
+            Task task;
+            if (TryPopTask(firstQueue % s_queues.size(), task)) {
+                RunTask(task);
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(batch->mutex);
+            batch->finished.wait(lock, [&batch]() {
+                return batch->remaining == 0;
+            });
+        }
+    }
+
+    int TaskScheduler::GetWorkersCount() {
+        return s_workers.size();
+    }
+};
@@ -9,6 +9,7 @@
 #include "common/item_aligner.h"
 #include "common/localization.h"
 #include "common/project_color_precision.h"
+#include "compositor/convolution.h"
 #include "font/IconsFontAwesome5.h"
 #include "raster.h"
 
@@ -974,4 +975,44 @@ namespace Raster {
         }
         ImGui::PopItemWidth();
     }
+    bool UIHelpers::RenderConvolutionKernelEditor(ConvolutionKernel& t_kernel) {
+        bool isItemEdited = false;
+        ImGui::PushID("##convolutionKernelEditor");
+        ImGui::AlignTextToFramePadding();
+        ImGui::Text("%s %s ", ICON_FA_UP_RIGHT_AND_DOWN_LEFT_FROM_CENTER, Localization::GetString("KERNEL_SIZE").c_str());
+        ImGui::SameLine();
+        ImGui::PushItemWidth(ImGui::GetContentRegionAvail().x);
+            int size[2] = {t_kernel.width, t_kernel.height};
+            ImGui::DragInt2("##kernelSize", size, 0.1f, 1, 255);
+            if (ImGui::IsItemEdited() && (size[0] != t_kernel.width || size[1] != t_kernel.height)) {
+                t_kernel.Resize(size[0], size[1]);
+                isItemEdited = true;
+            }
+        ImGui::PopItemWidth();
+
+        // larger kernels are expected to come from presets, serialized data or textures
+        if (t_kernel.width <= 9 && t_kernel.height <= 9) {
+            float cellWidth = (ImGui::GetContentRegionAvail().x - ImGui::GetStyle().ItemSpacing.x * (t_kernel.width - 1)) / t_kernel.width;
+            for (int y = 0; y < t_kernel.height; y++) {
+                for (int x = 0; x < t_kernel.width; x++) {
+                    ImGui::PushID(y * t_kernel.width + x);
+                    if (x > 0) ImGui::SameLine();
+                    ImGui::PushItemWidth(cellWidth);
+                    float value = t_kernel.Get(x, y);
+                    ImGui::DragFloat("##kernelValue", &value, 0.01f);
+                    if (ImGui::IsItemEdited()) {
+                        t_kernel.Set(x, y, value);
+                        isItemEdited = true;
+                    }
+                    ImGui::PopItemWidth();
+                    ImGui::PopID();
+                }
+            }
+        } else {
+            ImGui::Text("%s %s", ICON_FA_CIRCLE_INFO, Localization::GetString("KERNEL_IS_TOO_LARGE_TO_EDIT").c_str());
+        }
+        ImGui::Text("%s %s: %s", ICON_FA_GEARS, Localization::GetString("CONVOLUTION_STRATEGY").c_str(), Convolution::StrategyToString(Convolution::GetStrategy(t_kernel)).c_str());
+        ImGui::PopID();
+        return isItemEdited;
+    }
 };
\ No newline at end of file
@@ -21,6 +21,7 @@
 #include "raster.h"
 #include <filesystem>
 #include "common/zip.h"
+#include "common/project_archive.h"
 #include "common/transform3d.h"
 
 
@@ -30,7 +31,14 @@ namespace Raster {
     std::mutex Workspace::s_nodesMutex;
 
     std::vector<NodeImplementation> Workspace::s_nodeImplementations;
+    // library and package names mapped to indices into s_nodeImplementations
+    static unordered_dense::map<std::string, size_t> s_libraryNameIndex, s_packageNameIndex;
+    static size_t s_indexedImplementationsCount = 0;
+    static std::mutex s_implementationIndexMutex;
     Configuration Workspace::s_configuration;
+    ZIPManifest Workspace::s_projectManifest;
+    std::optional<std::future<std::optional<ZIPManifest>>> Workspace::s_projectCompaction;
+    std::atomic<int> Workspace::s_projectGeneration = 0;
 
     DoubleBufferedValue<unordered_dense::map<int, std::any>> Workspace::s_pinCache;
 
@@ -138,30 +146,39 @@ namespace Raster {
     };
 
     void Workspace::Initialize() {
-        if (!std::filesystem::exists("nodes/")) {
-            std::filesystem::create_directory("nodes");
-        }
-        auto iterator = std::filesystem::directory_iterator("nodes");
-        for (auto &entry : iterator) {
-            std::string transformedPath = std::regex_replace(
-                GetBaseName(entry.path().string()), std::regex(".dll|.so|lib"), "");
-            Libraries::LoadLibrary("nodes", transformedPath);
+        // category IDs are random and names are localized, so descriptions keep category names instead of IDs
+        std::string categoriesContext;
+        for (auto& category : NodeCategoryUtils::s_categoriesOrder) {
+            categoriesContext += NodeCategoryUtils::ToString(category) + ";";
+        }
+
+        auto libraries = Libraries::Discover("nodes", categoriesContext, [](std::string t_key) -> Json {
+            auto description = Libraries::GetFunction<NodeDescription()>(t_key, "GetDescription")();
+            return {
+                {"PrettyName", description.prettyName},
+                {"PackageName", description.packageName},
+                {"CategoryIcon", NodeCategoryUtils::ToIcon(description.category)},
+                {"CategoryName", NodeCategoryUtils::s_nameMap.count(description.category) ? NodeCategoryUtils::s_nameMap[description.category] : ""}
+            };
+        });
+        for (auto& library : libraries) {
             NodeImplementation implementation;
-            implementation.libraryName = transformedPath;
-            implementation.description = Libraries::GetFunction<NodeDescription()>(transformedPath, "GetDescription")();
-            implementation.spawn = Libraries::GetFunction<AbstractNode()>(transformedPath, "SpawnNode");
-            try {
-                Libraries::GetFunction<void()>(transformedPath, "OnStartup")();
-            } catch (internalDylib::exception ex) {
-                // skip
-            }
-            s_nodeImplementations.push_back(implementation);
-            std::cout << "loading node '" << implementation.description.packageName << "'" << std::endl;
+            implementation.libraryName = library.key;
+            implementation.description.prettyName = library.description["PrettyName"].get<std::string>();
+            implementation.description.packageName = library.description["PackageName"].get<std::string>();
+            implementation.description.category = NodeCategoryUtils::RegisterCategory(library.description["CategoryIcon"].get<std::string>(), library.description["CategoryName"].get<std::string>());
+            implementation.spawn = [key = library.key]() {
+                Libraries::LoadLibrary("nodes", key);
+                return Libraries::GetFunction<AbstractNode()>(key, "SpawnNode")();
+            };
+            RegisterNodeImplementation(implementation);
+            std::cout << "registering node '" << implementation.description.packageName << "'" << std::endl;
         }
 
         Easings::Initialize();
         Assets::Initialize();
         Attributes::Initialize();
+        Libraries::FinishDiscovery();
 
         // reordering attribute implementations
         std::vector<AttributeImplementation> newAttributeImplementations;
@@ -295,32 +312,23 @@ namespace Raster {
     }
 
     std::optional<AbstractNode> Workspace::InstantiateNode(std::string t_nodeName) {
-        std::optional<NodeImplementation> nodeImplementation;
-        for (auto& impl : s_nodeImplementations) {
-            if (impl.libraryName == t_nodeName) {
-                nodeImplementation = impl;
-                break;
-            }
-            if (impl.description.packageName == t_nodeName) {
-                nodeImplementation = impl;
-                break;
-            }
-        }
-        if (nodeImplementation.has_value()) {
-            return PopulateNode(t_nodeName, nodeImplementation.value().spawn());
+        auto indexCandidate = FindNodeImplementation(t_nodeName);
+        if (indexCandidate.has_value()) {
+            return PopulateNode(t_nodeName, s_nodeImplementations[indexCandidate.value()].spawn());
         }
         return std::nullopt;
     }
 
     std::optional<AbstractNode> Workspace::InstantiateSerializedNode(Json data) {
         // std::cout << data.dump() << std::endl;
-        auto nodeImplementation = GetNodeImplementationByPackageName((std::string) data["PackageName"]);
-        if (nodeImplementation.has_value()) {
-            auto nodeInstance = InstantiateNode(nodeImplementation.value().libraryName);
+        auto indexCandidate = FindNodeImplementation((std::string) data["PackageName"], true);
+        if (indexCandidate.has_value()) {
+            auto& libraryName = s_nodeImplementations[indexCandidate.value()].libraryName;
+            auto nodeInstance = InstantiateNode(libraryName);
             if (nodeInstance.has_value()) {
                 auto& node = nodeInstance.value();
                 node->nodeID = data["NodeID"];
-                node->libraryName = nodeImplementation.value().libraryName;
+                node->libraryName = libraryName;
                 node->enabled = data["Enabled"];
                 node->bypassed = data["Bypassed"];
                 if (data.contains("OverridenHeader")) {
@@ -391,24 +399,42 @@ namespace Raster {
     }
 
     std::optional<NodeImplementation> Workspace::GetNodeImplementationByLibraryName(std::string t_libraryName) {
-        for (auto& impl : s_nodeImplementations) {
-            if (impl.libraryName == t_libraryName) {
-                return impl;
-            }
-            if (impl.description.packageName == t_libraryName) {
-                return impl;
-            }
-        }
+        auto indexCandidate = FindNodeImplementation(t_libraryName);
+        if (indexCandidate.has_value()) return s_nodeImplementations[indexCandidate.value()];
         return std::nullopt;
     }
 
     std::optional<NodeImplementation> Workspace::GetNodeImplementationByPackageName(std::string t_packageName) {
-        for (auto& impl : s_nodeImplementations) {
-            if (impl.description.packageName == t_packageName) {
-                return impl;
+        auto indexCandidate = FindNodeImplementation(t_packageName, true);
+        if (indexCandidate.has_value()) return s_nodeImplementations[indexCandidate.value()];
+        return std::nullopt;
+    }
+
+    void Workspace::RegisterNodeImplementation(NodeImplementation t_implementation) {
+        std::lock_guard<std::mutex> lock(s_implementationIndexMutex);
+        s_nodeImplementations.push_back(t_implementation);
+    }
+
+    std::optional<size_t> Workspace::FindNodeImplementation(std::string t_name, bool t_packageNameOnly) {
+        std::lock_guard<std::mutex> lock(s_implementationIndexMutex);
+        // plugins may still append to s_nodeImplementations directly, so index catches up lazily.
+        // first registered implementation wins, same as a linear scan would
+        for (; s_indexedImplementationsCount < s_nodeImplementations.size(); s_indexedImplementationsCount++) {
+            auto& implementation = s_nodeImplementations[s_indexedImplementationsCount];
+            s_libraryNameIndex.emplace(implementation.libraryName, s_indexedImplementationsCount);
+            s_packageNameIndex.emplace(implementation.description.packageName, s_indexedImplementationsCount);
+        }
+
+        std::optional<size_t> result;
+        auto packageIterator = s_packageNameIndex.find(t_name);
+        if (packageIterator != s_packageNameIndex.end()) result = packageIterator->second;
+        if (!t_packageNameOnly) {
+            auto libraryIterator = s_libraryNameIndex.find(t_name);
+            if (libraryIterator != s_libraryNameIndex.end() && (!result.has_value() || libraryIterator->second < result.value())) {
+                result = libraryIterator->second;
             }
         }
-        return std::nullopt;
+        return result;
     }
 
     AbstractNode Workspace::PopulateNode(std::string t_nodeName, AbstractNode node) {
@@ -902,6 +928,13 @@ namespace Raster {
     std::optional<AudioBus*> Workspace::GetAudioBusByID(int t_busID) {
         if (Workspace::IsProjectLoaded()) {
             auto& project = Workspace::GetProject();
+            // audio pass rebuilds the routing index under this mutex
+            RASTER_SYNCHRONIZED(*project.audioBusesMutex);
+            // routing index may be stale if buses were edited since the last audio pass
+            auto indexCandidate = project.audioBusRouting.GetBusIndex(t_busID);
+            if (indexCandidate && *indexCandidate < project.audioBuses.size() && project.audioBuses[*indexCandidate].id == t_busID) {
+                return &project.audioBuses[*indexCandidate];
+            }
             for (auto& bus : project.audioBuses) {
                 if (bus.id == t_busID) {
                     return &bus;
@@ -944,9 +977,20 @@ namespace Raster {
 
     void Workspace::OpenProject(std::string t_path) {
         try {
-            ZIP::Extract(t_path, ".");
+            CollectProjectCompaction();
+            // media stays inside of the archive until something actually reads it
+            ProjectArchive::Close();
+            std::filesystem::remove_all("project/");
+            auto manifestCandidate = ProjectArchive::Open(t_path, "project");
+            if (!manifestCandidate.has_value()) {
+                RASTER_LOG("failed to read archive " << t_path);
+                return;
+            }
+            s_projectManifest = manifestCandidate.value();
+            ProjectArchive::Extract("project/project.json");
             if (std::filesystem::exists("project/project.json")) {
                 Workspace::s_project = Project(ReadJson("project/project.json"));
+                s_projectGeneration++;
                 Workspace::s_project.value().path = "project/";
                 Workspace::s_project.value().packedProjectPath = t_path;
 
@@ -972,11 +1016,53 @@ namespace Raster {
     void Workspace::SaveProject() {
         if (Workspace::IsProjectLoaded()) {
             auto& project = Workspace::GetProject();
+            CollectProjectCompaction();
             WriteFile("project/project.json", project.Serialize().dump());
-            ZIP::Pack(project.packedProjectPath, "project");
+            if (s_projectManifest.archivePath == project.packedProjectPath) {
+                // only entries that changed since the last save get written
+                ProjectArchive::UpdateManifest(s_projectManifest);
+                if (!ZIP::Append("project", s_projectManifest, ProjectArchive::GetArchivedEntries())) {
+                    RASTER_LOG("failed to append to " << project.packedProjectPath);
+                }
+            } else {
+                // saving as a different archive doesn't retarget future saves
+                ProjectArchive::ExtractAll();
+                ZIPManifest manifest;
+                manifest.archivePath = project.packedProjectPath;
+                ZIP::Compact("project", manifest);
+            }
         }
     }
 
+    void Workspace::CompactProject() {
+        if (!Workspace::IsProjectLoaded() || IsProjectCompacting()) return;
+        // UI keeps reading the manifest, so compaction works on a copy which is handed back by CollectProjectCompaction()
+        s_projectCompaction = std::async(std::launch::async, [manifest = s_projectManifest]() mutable -> std::optional<ZIPManifest> {
+            // the rewritten archive replaces the one entries are read from, so nothing may stay virtual
+            // and no handle may stay open on it
+            ProjectArchive::ExtractAll();
+            ProjectArchive::DetachStreams();
+            ProjectArchive::Close();
+            bool compacted = ZIP::Compact("project", manifest);
+            // every entry is on disk by now, reopened archive only serves as the index of what was packed
+            ProjectArchive::Open(manifest.archivePath, "project");
+            if (!compacted) return std::nullopt;
+            return manifest;
+        });
+    }
+
+    bool Workspace::IsProjectCompacting() {
+        if (s_projectCompaction.has_value() && IsFutureReady(s_projectCompaction.value())) CollectProjectCompaction();
+        return s_projectCompaction.has_value();
+    }
+
+    void Workspace::CollectProjectCompaction() {
+        if (!s_projectCompaction.has_value()) return;
+        auto manifestCandidate = s_projectCompaction->get();
+        s_projectCompaction = std::nullopt;
+        if (manifestCandidate.has_value()) s_projectManifest = manifestCandidate.value();
+    }
+
     void Workspace::CreateEmptyProject(Project &t_project, std::string t_projectPath) {
         auto serializedProject = t_project.Serialize();
         if (!std::filesystem::exists("project/")) {
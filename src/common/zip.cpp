@@ -40,4 +40,116 @@ namespace Raster {
         zip_walk(zip, t_inputDirectory.c_str());
         zip_close(zip);
     }
+
+    static std::string GetJournalPath(std::string t_inputDirectory) {
+        return t_inputDirectory + "/.journal.json";
+    }
+
+    std::unordered_map<std::string, ZIPEntryState> ZIP::Scan(std::string t_inputDirectory) {
+        std::unordered_map<std::string, ZIPEntryState> entries;
+        std::error_code error;
+        for (auto& entry : std::filesystem::recursive_directory_iterator(t_inputDirectory, error)) {
+            if (!entry.is_regular_file(error)) continue;
+            // same naming as zip_walk produces
+            auto name = t_inputDirectory + "/" + std::filesystem::relative(entry.path(), t_inputDirectory, error).generic_string();
+            ZIPEntryState state;
+            state.size = entry.file_size(error);
+            state.modificationTime = entry.last_write_time(error).time_since_epoch().count();
+            entries[name] = state;
+        }
+        return entries;
+    }
+
+    bool ZIP::Append(std::string t_inputDirectory, ZIPManifest& t_manifest, const std::set<std::string>& t_archivedEntries) {
+        if (!std::filesystem::exists(t_manifest.archivePath)) return Compact(t_inputDirectory, t_manifest);
+
+        auto journalPath = GetJournalPath(t_inputDirectory);
+        auto currentEntries = Scan(t_inputDirectory);
+        currentEntries.erase(journalPath);
+        for (auto& name : t_archivedEntries) {
+            auto previousState = t_manifest.entries.find(name);
+            if (previousState != t_manifest.entries.end() && currentEntries.find(name) == currentEntries.end()) {
+                currentEntries[name] = previousState->second;
+            }
+        }
+
+        std::vector<std::string> changedEntries;
+        for (auto& [name, state] : currentEntries) {
+            auto previousState = t_manifest.entries.find(name);
+            if (previousState != t_manifest.entries.end() && previousState->second == state) continue;
+            changedEntries.push_back(name);
+        }
+
+        // manifest is only updated once every entry made it into the archive
+        auto removedEntries = t_manifest.removedEntries;
+        auto staleBytes = t_manifest.staleBytes;
+        bool journalChanged = false;
+        for (auto& [name, state] : t_manifest.entries) {
+            if (currentEntries.find(name) != currentEntries.end()) continue;
+            journalChanged = removedEntries.insert(name).second || journalChanged;
+            staleBytes += state.size;
+        }
+        for (auto& name : changedEntries) {
+            journalChanged = removedEntries.erase(name) > 0 || journalChanged;
+        }
+        if (changedEntries.empty() && !journalChanged) return true;
+
+        auto zip = zip_open(t_manifest.archivePath.c_str(), 0, 'a');
+        if (!zip) return false;
+        // failed entries are never closed, so they stay out of the central directory written by zip_close()
+        bool failed = false;
+        for (auto& name : changedEntries) {
+            // extraction goes in archive order, so the appended copy overwrites the stale one
+            if (zip_entry_open(zip, name.c_str()) < 0 || zip_entry_fwrite(zip, name.c_str()) < 0 || zip_entry_close(zip) < 0) {
+                RASTER_LOG("failed to append " << name << " to " << t_manifest.archivePath);
+                failed = true;
+                break;
+            }
+
+            auto previousState = t_manifest.entries.find(name);
+            if (previousState != t_manifest.entries.end()) staleBytes += previousState->second.size;
+        }
+        if (journalChanged && !failed) {
+            Json journal = Json::array();
+            for (auto& name : removedEntries) journal.push_back(name);
+            auto journalDump = journal.dump();
+            if (zip_entry_open(zip, journalPath.c_str()) < 0 || zip_entry_write(zip, journalDump.data(), journalDump.size()) < 0 || zip_entry_close(zip) < 0) {
+                RASTER_LOG("failed to append journal to " << t_manifest.archivePath);
+                failed = true;
+            }
+        }
+        zip_close(zip);
+        // entries appended before the failure are complete and newer than their stale copies,
+        // unchanged manifest only makes the next append write them again
+        if (failed) return false;
+
+        t_manifest.entries = currentEntries;
+        t_manifest.removedEntries = removedEntries;
+        t_manifest.staleBytes = staleBytes;
+        return true;
+    }
+
+    bool ZIP::Compact(std::string t_inputDirectory, ZIPManifest& t_manifest) {
+        // scanning before packing makes files modified during compaction show up as changed on the next append
+        auto currentEntries = Scan(t_inputDirectory);
+        if (std::filesystem::exists(GetJournalPath(t_inputDirectory))) {
+            std::filesystem::remove(GetJournalPath(t_inputDirectory));
+            currentEntries.erase(GetJournalPath(t_inputDirectory));
+        }
+
+        auto temporaryPath = t_manifest.archivePath + ".compact";
+        Pack(temporaryPath, t_inputDirectory);
+        std::error_code error;
+        std::filesystem::rename(temporaryPath, t_manifest.archivePath, error);
+        if (error) {
+            RASTER_LOG("failed to replace " << t_manifest.archivePath << ": " << error.message());
+            std::filesystem::remove(temporaryPath, error);
+            return false;
+        }
+
+        t_manifest.entries = currentEntries;
+        t_manifest.removedEntries.clear();
+        t_manifest.staleBytes = 0;
+        return true;
+    }
 };
\ No newline at end of file
@@ -1,6 +1,12 @@
 #include "compositor/async_rendering.h"
 #include "common/audio_memory_management.h"
 #include "common/rendering.h"
+#include "compositor/resolution_governor.h"
+#include "compositor/domain_of_definition.h"
+#include "compositor/temporal_cache.h"
+#include "compositor/gradient_lut.h"
+#include "compositor/convolution.h"
+#include "common/profiler.h"
 #include <chrono>
 #include <ratio>
 #include <thread>
@@ -22,9 +28,11 @@ namespace Raster {
 
     void AsyncRendering::RenderingLoop() {
         GPU::SetCurrentContext(s_context);
+        Profiler::SetThreadName("Rendering");
         Compositor::Initialize();
         DoubleBufferingIndex::s_index = 0;
         static int s_renderingPassID = 1;
+        static int s_projectGeneration = 0;
         while (m_running) {
             if (Workspace::IsProjectLoaded()) {
                 auto& project = Workspace::GetProject();
@@ -33,40 +41,63 @@ namespace Raster {
                 }
                 if (!m_running) break;
                 if (!Rendering::MustRenderFrame() || !m_allowRendering) continue;
+                if (s_projectGeneration != Workspace::s_projectGeneration) {
+                    // caches of the previous project hold objects of this thread's GPU context
+                    TemporalCache::Clear();
+                    GradientLUT::Clear();
+                    Convolution::Clear();
+                    Compositor::ClearFramebufferPool();
+                    s_projectGeneration = Workspace::s_projectGeneration;
+                }
                 Rendering::CancelRenderFrame();
+                RASTER_PROFILE_ZONE("Frame");
+                bool playing = project.playing;
+                Compositor::previewResolutionScale = ResolutionGovernor::GetScale(playing);
                 Compositor::EnsureResolutionConstraints();
                 GPU::EnableClipping();
                 GPU::SetClipRect(project.roi.upperLeft, project.roi.bottomRight);
                 auto firstTimePoint = std::chrono::system_clock::now();
                 double firstTime = GPU::GetTime();
                 Compositor::s_bundles.Get().clear();
+                DomainOfDefinition::Reset();
                 AudioMemoryManagement::Reset();
-                project.Traverse({
-                    {"RENDERING_PASS", true},
-                    {"INCREMENT_EPF", true},
-                    {"RESET_WORKSPACE_STATE", true},
-                    {"ALLOW_MEDIA_DECODING", true},
-                    {"ONLY_RENDERING_NODES", true},
-                    {"RENDERING_PASS_ID", s_renderingPassID}
-                });
-                project.Traverse({
-                    {"RENDERING_PASS", true},
-                    {"INCREMENT_EPF", true},
-                    {"RESET_WORKSPACE_STATE", false},
-                    {"ALLOW_MEDIA_DECODING", false},
-                    {"ONLY_AUDIO_NODES", true},
-                    {"RENDERING_PASS_ID", s_renderingPassID}
-                });
+                {
+                    RASTER_PROFILE_ZONE("Rendering Traversal");
+                    project.Traverse({
+                        {"RENDERING_PASS", true},
+                        {"INCREMENT_EPF", true},
+                        {"RESET_WORKSPACE_STATE", true},
+                        {"ALLOW_MEDIA_DECODING", true},
+                        {"ONLY_RENDERING_NODES", true},
+                        {"RENDERING_PASS_ID", s_renderingPassID}
+                    });
+                }
+                {
+                    RASTER_PROFILE_ZONE("Audio Traversal");
+                    project.Traverse({
+                        {"RENDERING_PASS", true},
+                        {"INCREMENT_EPF", true},
+                        {"RESET_WORKSPACE_STATE", false},
+                        {"ALLOW_MEDIA_DECODING", false},
+                        {"ONLY_AUDIO_NODES", true},
+                        {"RENDERING_PASS_ID", s_renderingPassID}
+                    });
+                }
                 s_renderingPassID++;
-                auto f = Compositor::PerformComposition();
+                {
+                    ProfilerGPUScope profilerGPUZone("Composition");
+                    Compositor::PerformComposition();
+                }
                 GPU::DisableClipping();
                 GPU::Flush();
+                Profiler::CollectGPUZones();
                 if (Compositor::primaryFramebuffer) s_readyFramebuffer = Compositor::primaryFramebuffer.value().Get();
 
                 double secondTime = GPU::GetTime();
                 double timeDifference = (secondTime - firstTime) * 1000;
                 s_renderTime = timeDifference;
                 double idealTime = (1.0 / (double) project.framerate) * 1000;
+                ResolutionGovernor::ReportRenderTime(timeDifference, idealTime, playing);
                 if (idealTime > timeDifference) {
                     int idealTimeDifference = idealTime - timeDifference;
                 }
@@ -1,4 +1,5 @@
 #include "compositor/blending.h"
+#include "gpu/shader_compiler.h"
 
 namespace Raster {
 
@@ -47,16 +48,24 @@ namespace Raster {
         std::string codeBase = ReadFile(GPU::GetShadersPath() + "compositor/blending_base.frag");
         codeBase = ReplaceString(codeBase, RASTER_BLENDING_PLACEHOLDER, accumulatedCode);
         codeBase = ReplaceString(codeBase, RASTER_BLENDING_FUNCTIONS_PLACEHOLDER, accumulatedFunctions);
-        WriteFile(GPU::GetShadersPath() + "compositor/blending.frag", codeBase);
+        shaderCode = codeBase;
 
-        pipelineCandidate = GPU::GeneratePipeline(
-            GPU::GenerateShader(ShaderType::Vertex, "compositor/blending"),
-            GPU::GenerateShader(ShaderType::Fragment, "compositor/blending")
-        );
+        ShaderCompiler::Request(ShaderType::Vertex, "compositor/blending");
+        ShaderCompiler::RequestSource(ShaderType::Fragment, codeBase, "compositor/blending");
+    }
+
+    bool Blending::IsReady() {
+        if (pipelineCandidate.has_value()) return true;
+        if (!shaderCode.has_value()) return false;
+        auto vertexCandidate = ShaderCompiler::Request(ShaderType::Vertex, "compositor/blending");
+        auto fragmentCandidate = ShaderCompiler::RequestSource(ShaderType::Fragment, shaderCode.value(), "compositor/blending");
+        if (!vertexCandidate.has_value() || !fragmentCandidate.has_value()) return false;
+        pipelineCandidate = GPU::GeneratePipeline(vertexCandidate.value(), fragmentCandidate.value());
+        return true;
     }
 
     Framebuffer Blending::PerformManualBlending(BlendingMode& mode, Texture base, Texture blend, float opacity, glm::vec4 backgroundColor) {
-        if (!pipelineCandidate.has_value()) return Framebuffer{};
+        if (!IsReady()) return Framebuffer{};
         EnsureResolutionConstraints(base);
 
         auto& framebuffer = framebufferCandidate.value();
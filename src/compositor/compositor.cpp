@@ -1,9 +1,14 @@
 #include "compositor/compositor.h"
+#include "compositor/domain_of_definition.h"
 #include "common/composition_mask.h"
 #include "common/thread_unique_value.h"
+#include "common/profiler.h"
 #include "gpu/gpu.h"
 #include "raster.h"
 
+// video memory kept around by recycled framebuffers of each thread
+#define MAX_POOLED_FRAMEBUFFER_BYTES (512ull * 1024 * 1024)
+
 namespace Raster {
     std::optional<DoubleBufferedFramebuffer> Compositor::primaryFramebuffer;
     float Compositor::previewResolutionScale = 1.0f;
@@ -16,6 +21,26 @@ namespace Raster {
 
     static Pipeline s_solidColorPipeline;
 
+    struct PooledFramebuffer {
+        Framebuffer framebuffer;
+        uint64_t lastUsed;
+    };
+
+    // framebuffers of previously used resolutions, so switching preview scale doesn't reallocate everything.
+    // framebuffer objects can't be shared between GPU contexts, so every thread keeps its own pool
+    static thread_local std::vector<PooledFramebuffer> s_framebufferPool;
+    static thread_local size_t s_framebufferPoolBytes = 0;
+    static thread_local uint64_t s_framebufferPoolCounter = 0;
+
+    static size_t GetCompatibleFramebufferBytes(Framebuffer& t_fbo) {
+        size_t bytes = 0;
+        for (auto& attachment : t_fbo.attachments) {
+            size_t bytesPerTexel = attachment.precision == TexturePrecision::Full ? 16 : (attachment.precision == TexturePrecision::Half ? 8 : 4);
+            bytes += (size_t) attachment.width * attachment.height * bytesPerTexel;
+        }
+        return bytes;
+    }
+
     void Compositor::Initialize() {
         s_pipeline = GPU::GeneratePipeline(
             GPU::s_basicShader,
@@ -63,6 +88,7 @@ namespace Raster {
     };
 
     void Compositor::PerformManualComposition(std::vector<CompositorTarget> t_targets, Framebuffer& t_fbo, std::optional<glm::vec4> t_backgroundColor, std::optional<Blending*> t_blending, std::optional<Pipeline> t_pipeline) {
+        RASTER_PROFILE_ZONE("Composition");
         auto& framebuffer = t_fbo;
         auto pipeline = t_pipeline.value_or(s_pipeline);
         GPU::BindFramebuffer(framebuffer);
@@ -149,7 +175,13 @@ namespace Raster {
                 GPU::BindFramebuffer(framebuffer);
                 GPU::BindPipeline(pipeline);
             }
-            if (blendingModeCandidate.has_value()) {
+            // transparent pixels of a target never change the result, so only its domain of definition is blended
+            auto targetRegion = DomainOfDefinition::Get(target.colorAttachment);
+            if (targetRegion && targetRegion->IsEmpty()) continue;
+            bool targetScissored = targetRegion && !targetRegion->Covers(framebuffer.width, framebuffer.height);
+            if (targetScissored) GPU::SetScissorRect(targetRegion->ToScissor());
+            // targets are composited with regular alpha blending until blending shader is compiled
+            if (blendingModeCandidate.has_value() && blending->IsReady()) {
                 auto& blendingMode = blendingModeCandidate.value();
                 auto blendedResult = blending->PerformManualBlending(blendingMode, framebuffer.attachments[0], colorAttachment, target.opacity, bg);
                 GPU::BindFramebuffer(framebuffer);
@@ -167,16 +199,64 @@ namespace Raster {
                 GPU::SetShaderUniform(pipeline.fragment, "uResolution", {framebuffer.width, framebuffer.height});
                 GPU::DrawArrays(3);
             }
+            if (targetScissored) GPU::SetScissorRect(std::nullopt);
         }
     }
 
     void Compositor::ResizePrimaryFramebuffer(glm::vec2 t_resolution) {
         if (primaryFramebuffer.has_value()) {
-            auto& framebuffer = primaryFramebuffer.value();
-            framebuffer.Destroy();
+            RecycleFramebuffer(primaryFramebuffer.value());
         }
 
-        primaryFramebuffer = GenerateCompatibleDoubleBufferedFramebuffer(t_resolution);
+        primaryFramebuffer = AcquireDoubleBufferedFramebuffer(t_resolution);
+    }
+
+    Framebuffer Compositor::AcquireFramebuffer(glm::vec2 t_resolution, std::optional<TexturePrecision> t_precision) {
+        auto precision = t_precision.value_or(s_colorPrecision);
+        for (auto iterator = s_framebufferPool.begin(); iterator != s_framebufferPool.end(); iterator++) {
+            auto& framebuffer = iterator->framebuffer;
+            if (framebuffer.width == (uint32_t) t_resolution.x && framebuffer.height == (uint32_t) t_resolution.y && framebuffer.attachments.size() == 2 && framebuffer.attachments[0].precision == precision) {
+                auto result = framebuffer;
+                s_framebufferPoolBytes -= GetCompatibleFramebufferBytes(result);
+                s_framebufferPool.erase(iterator);
+                return result;
+            }
+        }
+        return GenerateCompatibleFramebuffer(t_resolution, precision);
+    }
+
+    DoubleBufferedFramebuffer Compositor::AcquireDoubleBufferedFramebuffer(glm::vec2 t_resolution, std::optional<TexturePrecision> t_precision) {
+        auto front = AcquireFramebuffer(t_resolution, t_precision);
+        auto back = AcquireFramebuffer(t_resolution, t_precision);
+        return DoubleBufferedFramebuffer(front, back);
+    }
+
+    void Compositor::RecycleFramebuffer(Framebuffer& t_fbo) {
+        if (!t_fbo.handle) return;
+        DomainOfDefinition::Invalidate(t_fbo);
+        s_framebufferPool.push_back(PooledFramebuffer{t_fbo, ++s_framebufferPoolCounter});
+        s_framebufferPoolBytes += GetCompatibleFramebufferBytes(t_fbo);
+        while (s_framebufferPoolBytes > MAX_POOLED_FRAMEBUFFER_BYTES && !s_framebufferPool.empty()) {
+            auto oldest = std::min_element(s_framebufferPool.begin(), s_framebufferPool.end(), [](auto& a, auto& b) { return a.lastUsed < b.lastUsed; });
+            s_framebufferPoolBytes -= GetCompatibleFramebufferBytes(oldest->framebuffer);
+            GPU::DestroyFramebufferWithAttachments(oldest->framebuffer);
+            s_framebufferPool.erase(oldest);
+        }
+        t_fbo = Framebuffer();
+    }
+
+    void Compositor::RecycleFramebuffer(DoubleBufferedFramebuffer& t_fbo) {
+        RecycleFramebuffer(t_fbo.GetWithOffset(0));
+        RecycleFramebuffer(t_fbo.GetWithOffset(1));
+        t_fbo = DoubleBufferedFramebuffer();
+    }
+
+    void Compositor::ClearFramebufferPool() {
+        for (auto& pooled : s_framebufferPool) {
+            GPU::DestroyFramebufferWithAttachments(pooled.framebuffer);
+        }
+        s_framebufferPool.clear();
+        s_framebufferPoolBytes = 0;
     }
 
     void Compositor::EnsureResolutionConstraints() {
@@ -209,24 +289,24 @@ namespace Raster {
     void Compositor::EnsureResolutionConstraintsForFramebuffer(Framebuffer& t_fbo) {
         auto requiredResolution = GetRequiredResolution();
         if (!t_fbo.handle) {
-            t_fbo = GenerateCompatibleFramebuffer(requiredResolution);
+            t_fbo = AcquireFramebuffer(requiredResolution);
             return;
         }
         if (t_fbo.width != requiredResolution.x || t_fbo.height != requiredResolution.y || t_fbo.attachments[0].precision != s_colorPrecision) {
-            GPU::DestroyFramebufferWithAttachments(t_fbo);
-            t_fbo = GenerateCompatibleFramebuffer(requiredResolution);
+            RecycleFramebuffer(t_fbo);
+            t_fbo = AcquireFramebuffer(requiredResolution);
         }
     }
 
     void Compositor::EnsureResolutionConstraintsForFramebuffer(DoubleBufferedFramebuffer& t_fbo) {
         auto requiredResolution = GetRequiredResolution();
         if (!t_fbo.Get().handle) {
-            t_fbo = GenerateCompatibleDoubleBufferedFramebuffer(requiredResolution);
+            t_fbo = AcquireDoubleBufferedFramebuffer(requiredResolution);
             return;
         }
         if (t_fbo.Get().width != requiredResolution.x || t_fbo.Get().height != requiredResolution.y || t_fbo.Get().attachments[0].precision != s_colorPrecision) {
-            t_fbo.Destroy();
-            t_fbo = GenerateCompatibleDoubleBufferedFramebuffer(requiredResolution);
+            RecycleFramebuffer(t_fbo);
+            t_fbo = AcquireDoubleBufferedFramebuffer(requiredResolution);
         }
     }
 
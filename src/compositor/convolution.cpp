@@ -0,0 +1,252 @@
+#include "compositor/convolution.h"
+
+// separable shader keeps 1D weights in a uniform array of this size
+#define MAX_SEPARABLE_TAPS 128
+#define MAX_CONVOLUTION_RANK 8
+// approximate cost of an extra fullscreen pass expressed in kernel taps
+#define CONVOLUTION_PASS_COST 16
+#define MAX_CONVOLUTION_PLANS 64
+
+namespace Raster {
+
+    struct ConvolutionPlan {
+        ConvolutionStrategy strategy;
+        std::vector<SeparableKernelTerm> terms;
+        std::optional<Texture> kernelTexture;
+    };
+
+    struct ConvolutionScratch {
+        uint32_t width, height;
+        TexturePrecision precision;
+        // horizontal pass result and two accumulators for low-rank kernels
+        std::vector<Framebuffer> framebuffers;
+        uint64_t lastUsed;
+    };
+
+    // framebuffers can't be shared between GPU contexts, so rendering thread and UI previews keep separate state
+    static thread_local std::optional<Pipeline> s_directPipeline, s_separablePipeline, s_texturePipeline, s_resamplePipeline;
+    static thread_local std::optional<Framebuffer> s_kernelFramebuffer;
+    static thread_local std::optional<Sampler> s_kernelSampler;
+    static thread_local unordered_dense::map<uint64_t, ConvolutionPlan> s_plans;
+    static thread_local std::vector<ConvolutionScratch> s_scratches;
+    static thread_local uint64_t s_scratchCounter = 0;
+
+    static ConvolutionPlan CreatePlan(const ConvolutionKernel& t_kernel) {
+        ConvolutionPlan plan;
+        plan.strategy = ConvolutionStrategy::Direct;
+        int directCost = t_kernel.width * t_kernel.height;
+        if (t_kernel.width > MAX_SEPARABLE_TAPS || t_kernel.height > MAX_SEPARABLE_TAPS) return plan;
+
+        int termCost = t_kernel.width + t_kernel.height + CONVOLUTION_PASS_COST;
+        int maxRank = std::min(MAX_CONVOLUTION_RANK, (directCost - 1) / termCost);
+        if (maxRank < 1) return plan;
+        auto termsCandidate = t_kernel.Decompose(maxRank);
+        if (!termsCandidate.has_value() || termsCandidate->empty()) return plan;
+
+        plan.terms = *termsCandidate;
+        plan.strategy = plan.terms.size() == 1 ? ConvolutionStrategy::Separable : ConvolutionStrategy::LowRank;
+        return plan;
+    }
+
+    static ConvolutionPlan& GetPlan(const ConvolutionKernel& t_kernel) {
+        auto hash = t_kernel.Hash();
+        if (s_plans.find(hash) != s_plans.end()) return s_plans[hash];
+        if (s_plans.size() >= MAX_CONVOLUTION_PLANS) Convolution::Clear();
+        s_plans[hash] = CreatePlan(t_kernel);
+        return s_plans[hash];
+    }
+
+    static ConvolutionScratch& GetScratch(uint32_t t_width, uint32_t t_height, TexturePrecision t_precision) {
+        s_scratchCounter++;
+        for (auto& scratch : s_scratches) {
+            if (scratch.width == t_width && scratch.height == t_height && scratch.precision == t_precision) {
+                scratch.lastUsed = s_scratchCounter;
+                return scratch;
+            }
+        }
+        // keep scratch buffers for a few distinct resolutions at most
+        if (s_scratches.size() >= 4) {
+            auto oldest = std::min_element(s_scratches.begin(), s_scratches.end(), [](auto& a, auto& b) { return a.lastUsed < b.lastUsed; });
+            for (auto& framebuffer : oldest->framebuffers) GPU::DestroyFramebufferWithAttachments(framebuffer);
+            s_scratches.erase(oldest);
+        }
+        ConvolutionScratch scratch;
+        scratch.width = t_width;
+        scratch.height = t_height;
+        scratch.precision = t_precision;
+        scratch.lastUsed = s_scratchCounter;
+        for (int i = 0; i < 3; i++) {
+            scratch.framebuffers.push_back(GPU::GenerateFramebuffer(t_width, t_height, {GPU::GenerateTexture(t_width, t_height, 4, t_precision)}));
+        }
+        s_scratches.push_back(scratch);
+        return s_scratches.back();
+    }
+
+    static void EnsurePipelines() {
+        if (!s_directPipeline) {
+            s_directPipeline = GPU::GeneratePipeline(GPU::s_basicShader, GPU::GenerateShader(ShaderType::Fragment, "convolve/shader"));
+        }
+        if (!s_separablePipeline) {
+            s_separablePipeline = GPU::GeneratePipeline(GPU::s_basicShader, GPU::GenerateShader(ShaderType::Fragment, "convolve_separable/shader"));
+        }
+        if (!s_texturePipeline) {
+            s_texturePipeline = GPU::GeneratePipeline(GPU::s_basicShader, GPU::GenerateShader(ShaderType::Fragment, "convolve_texture/shader"));
+        }
+        if (!s_resamplePipeline) {
+            s_resamplePipeline = GPU::GeneratePipeline(GPU::s_basicShader, GPU::GenerateShader(ShaderType::Fragment, "texture_convert/shader"));
+        }
+        if (!s_kernelSampler) {
+            s_kernelSampler = GPU::GenerateSampler();
+            GPU::SetSamplerTextureFilteringMode(*s_kernelSampler, TextureFilteringOperation::Minify, TextureFilteringMode::Nearest);
+            GPU::SetSamplerTextureFilteringMode(*s_kernelSampler, TextureFilteringOperation::Magnify, TextureFilteringMode::Nearest);
+        }
+    }
+
+    static void RenderDirect(Framebuffer& t_target, Texture& t_base, const ConvolutionKernel& t_kernel, ConvolutionPlan& t_plan, float t_multiplier, float t_tapSpacing) {
+        if (!t_plan.kernelTexture.has_value()) {
+            auto kernelTexture = GPU::GenerateTexture(t_kernel.width, t_kernel.height, 1, TexturePrecision::Full);
+            GPU::UpdateTexture(kernelTexture, 0, 0, t_kernel.width, t_kernel.height, 1, (void*) t_kernel.values.data());
+            t_plan.kernelTexture = kernelTexture;
+        }
+
+        auto& pipeline = *s_directPipeline;
+        GPU::BindPipeline(pipeline);
+        GPU::BindFramebuffer(t_target);
+        GPU::ClearFramebuffer(0, 0, 0, 0);
+        GPU::SetShaderUniform(pipeline.fragment, "uResolution", glm::vec2(t_target.width, t_target.height));
+        GPU::SetShaderUniform(pipeline.fragment, "uKernelSize", glm::vec2(t_kernel.width, t_kernel.height));
+        GPU::SetShaderUniform(pipeline.fragment, "uMultiplier", t_multiplier);
+        GPU::SetShaderUniform(pipeline.fragment, "uTapSpacing", t_tapSpacing);
+        GPU::BindTextureToShader(pipeline.fragment, "uBase", t_base, 0);
+        GPU::BindTextureToShader(pipeline.fragment, "uKernel", *t_plan.kernelTexture, 1);
+        GPU::BindSampler(*s_kernelSampler, 1);
+        GPU::DrawArrays(3);
+        GPU::BindSampler(std::nullopt, 1);
+    }
+
+    static void RenderSeparablePass(Framebuffer& t_target, Texture& t_base, std::vector<float> t_weights, glm::vec2 t_direction, std::optional<Texture> t_accumulator) {
+        auto& pipeline = *s_separablePipeline;
+        GPU::BindFramebuffer(t_target);
+        GPU::ClearFramebuffer(0, 0, 0, 0);
+        GPU::SetShaderUniform(pipeline.fragment, "uResolution", glm::vec2(t_target.width, t_target.height));
+        GPU::SetShaderUniform(pipeline.fragment, "uWeights", (int) t_weights.size(), t_weights.data());
+        GPU::SetShaderUniform(pipeline.fragment, "uTaps", (int) t_weights.size());
+        GPU::SetShaderUniform(pipeline.fragment, "uDirection", t_direction);
+        GPU::SetShaderUniform(pipeline.fragment, "uAccumulate", t_accumulator.has_value() ? 1 : 0);
+        GPU::BindTextureToShader(pipeline.fragment, "uBase", t_base, 0);
+        if (t_accumulator.has_value()) {
+            GPU::BindTextureToShader(pipeline.fragment, "uAccumulator", *t_accumulator, 1);
+        }
+        GPU::DrawArrays(3);
+    }
+
+    static void RenderSeparable(Framebuffer& t_target, Texture& t_base, ConvolutionPlan& t_plan, float t_multiplier, float t_tapSpacing) {
+        // intermediate results may be negative, so scratch buffers are always floating point
+        auto precision = t_base.precision == TexturePrecision::Full ? TexturePrecision::Full : TexturePrecision::Half;
+        auto& scratch = GetScratch(t_target.width, t_target.height, precision);
+        auto& horizontal = scratch.framebuffers[0];
+
+        GPU::BindPipeline(*s_separablePipeline);
+        std::optional<Texture> accumulator;
+        for (size_t i = 0; i < t_plan.terms.size(); i++) {
+            auto& term = t_plan.terms[i];
+            auto horizontalWeights = term.horizontal;
+            for (auto& weight : horizontalWeights) weight *= t_multiplier;
+
+            // final blended write matches behaviour of a single direct pass
+            bool isLastTerm = i + 1 == t_plan.terms.size();
+            auto& output = isLastTerm ? t_target : scratch.framebuffers[1 + i % 2];
+
+            GPU::DisableBlending();
+            RenderSeparablePass(horizontal, t_base, horizontalWeights, {t_tapSpacing, 0}, std::nullopt);
+            if (isLastTerm) GPU::EnableBlending();
+            RenderSeparablePass(output, horizontal.attachments[0], term.vertical, {0, t_tapSpacing}, accumulator);
+            accumulator = output.attachments[0];
+        }
+        GPU::EnableBlending();
+    }
+
+    ConvolutionStrategy Convolution::Apply(Framebuffer& t_target, Texture& t_base, const ConvolutionKernel& t_kernel, float t_multiplier, float t_tapSpacing) {
+        EnsurePipelines();
+        auto& plan = GetPlan(t_kernel);
+        float multiplier = t_kernel.multiplier * t_multiplier;
+        if (plan.strategy == ConvolutionStrategy::Direct) {
+            RenderDirect(t_target, t_base, t_kernel, plan, multiplier, t_tapSpacing);
+        } else {
+            RenderSeparable(t_target, t_base, plan, multiplier, t_tapSpacing);
+        }
+        return plan.strategy;
+    }
+
+    void Convolution::ApplyTexture(Framebuffer& t_target, Texture& t_base, Texture& t_kernelTexture, int t_width, int t_height, float t_multiplier, bool t_normalize, float t_tapSpacing) {
+        EnsurePipelines();
+        auto& pipeline = *s_texturePipeline;
+        GPU::BindPipeline(pipeline);
+        GPU::BindFramebuffer(t_target);
+        GPU::ClearFramebuffer(0, 0, 0, 0);
+        GPU::SetShaderUniform(pipeline.fragment, "uResolution", glm::vec2(t_target.width, t_target.height));
+        GPU::SetShaderUniform(pipeline.fragment, "uKernelSize", glm::vec2(std::max(t_width, 1), std::max(t_height, 1)));
+        GPU::SetShaderUniform(pipeline.fragment, "uMultiplier", t_multiplier);
+        GPU::SetShaderUniform(pipeline.fragment, "uNormalize", t_normalize ? 1 : 0);
+        GPU::SetShaderUniform(pipeline.fragment, "uTapSpacing", t_tapSpacing);
+        GPU::BindTextureToShader(pipeline.fragment, "uBase", t_base, 0);
+        GPU::BindTextureToShader(pipeline.fragment, "uKernel", t_kernelTexture, 1);
+        GPU::DrawArrays(3);
+    }
+
+    ConvolutionKernel Convolution::ReadTextureKernel(Texture& t_kernelTexture, int t_width, int t_height, bool t_normalize) {
+        EnsurePipelines();
+        int width = std::max(t_width, 1), height = std::max(t_height, 1);
+        if (!s_kernelFramebuffer.has_value() || s_kernelFramebuffer->width != width || s_kernelFramebuffer->height != height) {
+            if (s_kernelFramebuffer.has_value()) GPU::DestroyFramebufferWithAttachments(*s_kernelFramebuffer);
+            s_kernelFramebuffer = GPU::GenerateFramebuffer(width, height, {GPU::GenerateTexture(width, height, 4, TexturePrecision::Full)});
+        }
+
+        // one fragment per tap samples the kernel texture at the same coordinates as convolve_texture shader
+        bool clippingEnabled = GPU::IsClippingEnabled();
+        if (clippingEnabled) GPU::DisableClipping();
+        GPU::DisableBlending();
+        auto& pipeline = *s_resamplePipeline;
+        GPU::BindPipeline(pipeline);
+        GPU::BindFramebuffer(*s_kernelFramebuffer);
+        GPU::ClearFramebuffer(0, 0, 0, 0);
+        GPU::SetShaderUniform(pipeline.fragment, "uResolution", glm::vec2(width, height));
+        GPU::BindTextureToShader(pipeline.fragment, "uTexture", t_kernelTexture, 0);
+        GPU::DrawArrays(3);
+
+        std::vector<glm::vec4> pixels(width * height);
+        GPU::ReadPixels(0, 0, width, height, 4, TexturePrecision::Full, pixels.data());
+        GPU::EnableBlending();
+        if (clippingEnabled) GPU::EnableClipping();
+
+        std::vector<float> values(width * height);
+        float weightSum = 0.0f;
+        for (size_t i = 0; i < values.size(); i++) {
+            values[i] = pixels[i].r;
+            weightSum += values[i];
+        }
+        float multiplier = t_normalize && weightSum != 0.0f ? 1.0f / weightSum : 1.0f;
+        return ConvolutionKernel(multiplier, width, height, values);
+    }
+
+    ConvolutionStrategy Convolution::GetStrategy(const ConvolutionKernel& t_kernel) {
+        return GetPlan(t_kernel).strategy;
+    }
+
+    std::string Convolution::StrategyToString(ConvolutionStrategy t_strategy) {
+        switch (t_strategy) {
+            case ConvolutionStrategy::Separable: return "Separable";
+            case ConvolutionStrategy::LowRank: return "Low Rank";
+            default: return "Direct";
+        }
+    }
+
+    void Convolution::Clear() {
+        for (auto& [hash, plan] : s_plans) {
+            if (plan.kernelTexture.has_value()) GPU::DestroyTexture(*plan.kernelTexture);
+        }
+        s_plans.clear();
+        if (s_kernelFramebuffer.has_value()) GPU::DestroyFramebufferWithAttachments(*s_kernelFramebuffer);
+        s_kernelFramebuffer = std::nullopt;
+    }
+}
@@ -0,0 +1,88 @@
+#include "compositor/domain_of_definition.h"
+
+namespace Raster {
+    // UI previews compose on the main thread, they never see regions and always use whole frames
+    static thread_local unordered_dense::map<void*, PixelRegion> s_regions;
+
+    PixelRegion PixelRegion::Full(uint32_t t_width, uint32_t t_height) {
+        return PixelRegion(0, 0, t_width, t_height);
+    }
+
+    PixelRegion PixelRegion::FromClipSpace(const std::vector<glm::vec4>& t_points, glm::vec2 t_resolution) {
+        if (t_points.empty()) return PixelRegion();
+        glm::vec2 minPoint(std::numeric_limits<float>::max()), maxPoint(std::numeric_limits<float>::lowest());
+        for (auto& point : t_points) {
+            // points behind the camera can't be bounded reliably
+            if (point.w <= 0.0f) return Full(t_resolution.x, t_resolution.y);
+            glm::vec2 screen = (glm::vec2(point) / point.w * 0.5f + 0.5f) * t_resolution;
+            minPoint = glm::vec2(std::min(minPoint.x, screen.x), std::min(minPoint.y, screen.y));
+            maxPoint = glm::vec2(std::max(maxPoint.x, screen.x), std::max(maxPoint.y, screen.y));
+        }
+        return PixelRegion(
+            (int) std::floor(std::max(minPoint.x, -1.0f)) - 1, (int) std::floor(std::max(minPoint.y, -1.0f)) - 1,
+            (int) std::ceil(std::min(maxPoint.x, t_resolution.x + 1)) + 1, (int) std::ceil(std::min(maxPoint.y, t_resolution.y + 1)) + 1
+        ).Clamp(t_resolution.x, t_resolution.y);
+    }
+
+    bool PixelRegion::IsEmpty() const {
+        return x1 <= x0 || y1 <= y0;
+    }
+
+    bool PixelRegion::Covers(uint32_t t_width, uint32_t t_height) const {
+        return x0 <= 0 && y0 <= 0 && x1 >= (int) t_width && y1 >= (int) t_height;
+    }
+
+    PixelRegion PixelRegion::Union(const PixelRegion& t_other) const {
+        if (IsEmpty()) return t_other;
+        if (t_other.IsEmpty()) return *this;
+        return PixelRegion(std::min(x0, t_other.x0), std::min(y0, t_other.y0), std::max(x1, t_other.x1), std::max(y1, t_other.y1));
+    }
+
+    PixelRegion PixelRegion::Intersect(const PixelRegion& t_other) const {
+        return PixelRegion(std::max(x0, t_other.x0), std::max(y0, t_other.y0), std::min(x1, t_other.x1), std::min(y1, t_other.y1));
+    }
+
+    PixelRegion PixelRegion::Expand(int t_x, int t_y) const {
+        if (IsEmpty()) return *this;
+        return PixelRegion(x0 - t_x, y0 - t_y, x1 + t_x, y1 + t_y);
+    }
+
+    PixelRegion PixelRegion::Clamp(uint32_t t_width, uint32_t t_height) const {
+        return Intersect(Full(t_width, t_height));
+    }
+
+    glm::ivec4 PixelRegion::ToScissor() const {
+        return glm::ivec4(x0, y0, std::max(x1 - x0, 0), std::max(y1 - y0, 0));
+    }
+
+    void DomainOfDefinition::Set(Framebuffer& t_framebuffer, PixelRegion t_region) {
+        t_region = t_region.Clamp(t_framebuffer.width, t_framebuffer.height);
+        for (auto& attachment : t_framebuffer.attachments) {
+            s_regions[attachment.handle] = t_region;
+        }
+    }
+
+    std::optional<PixelRegion> DomainOfDefinition::Get(Texture& t_texture) {
+        auto iterator = s_regions.find(t_texture.handle);
+        if (iterator == s_regions.end()) return std::nullopt;
+        return iterator->second;
+    }
+
+    PixelRegion DomainOfDefinition::GetOrFull(Texture& t_texture) {
+        return Get(t_texture).value_or(PixelRegion::Full(t_texture.width, t_texture.height));
+    }
+
+    void DomainOfDefinition::Invalidate(Texture& t_texture) {
+        if (t_texture.handle) s_regions.erase(t_texture.handle);
+    }
+
+    void DomainOfDefinition::Invalidate(Framebuffer& t_framebuffer) {
+        for (auto& attachment : t_framebuffer.attachments) {
+            Invalidate(attachment);
+        }
+    }
+
+    void DomainOfDefinition::Reset() {
+        s_regions.clear();
+    }
+};
@@ -0,0 +1,80 @@
+#include "compositor/gradient_lut.h"
+#include <glm/gtc/packing.hpp>
+
+#define MAX_GRADIENT_TEXTURES 64
+
+namespace Raster {
+
+    struct GradientTexture {
+        Texture texture;
+        uint64_t lastUsed;
+    };
+
+    // every thread evicts only the textures it handed out itself, so a texture stays valid until that thread's next Get()
+    // without locking, no matter what other threads upload meanwhile
+    static thread_local unordered_dense::map<uint64_t, GradientTexture> s_textures;
+    static thread_local std::optional<Sampler> s_sampler;
+    static thread_local uint64_t s_textureCounter = 0;
+
+    static Texture CreateTexture(const std::vector<glm::vec4>& t_lut, TexturePrecision t_precision) {
+        auto texture = GPU::GenerateTexture(t_lut.size(), 1, 4, t_precision);
+        if (t_precision == TexturePrecision::Full) {
+            GPU::UpdateTexture(texture, 0, 0, t_lut.size(), 1, 4, (void*) t_lut.data());
+        } else if (t_precision == TexturePrecision::Half) {
+            std::vector<uint16_t> pixels(t_lut.size() * 4);
+            for (size_t i = 0; i < pixels.size(); i++) pixels[i] = glm::packHalf1x16(t_lut[i / 4][i % 4]);
+            GPU::UpdateTexture(texture, 0, 0, t_lut.size(), 1, 4, pixels.data());
+        } else {
+            std::vector<uint8_t> pixels(t_lut.size() * 4);
+            for (size_t i = 0; i < pixels.size(); i++) pixels[i] = (uint8_t) std::round(glm::clamp(t_lut[i / 4][i % 4], 0.0f, 1.0f) * 255.0f);
+            GPU::UpdateTexture(texture, 0, 0, t_lut.size(), 1, 4, pixels.data());
+        }
+        return texture;
+    }
+
+    Texture GradientLUT::Get(Gradient1D& t_gradient, TexturePrecision t_precision) {
+        int resolution = GetResolution(t_precision);
+        auto key = HashCombine(t_gradient.Hash(), HashValue((int) t_precision));
+        s_textureCounter++;
+        auto iterator = s_textures.find(key);
+        if (iterator != s_textures.end()) {
+            iterator->second.lastUsed = s_textureCounter;
+            return iterator->second.texture;
+        }
+
+        // animated gradients produce a new texture every frame, so least recently used ones are evicted
+        if (s_textures.size() >= MAX_GRADIENT_TEXTURES) {
+            auto oldest = std::min_element(s_textures.begin(), s_textures.end(), [](auto& a, auto& b) { return a.second.lastUsed < b.second.lastUsed; });
+            GPU::DestroyTexture(oldest->second.texture);
+            s_textures.erase(oldest->first);
+        }
+        GradientTexture gradientTexture;
+        gradientTexture.texture = CreateTexture(*t_gradient.GetBaked(resolution), t_precision);
+        gradientTexture.lastUsed = s_textureCounter;
+        s_textures[key] = gradientTexture;
+        return gradientTexture.texture;
+    }
+
+    Sampler GradientLUT::GetSampler() {
+        if (!s_sampler) {
+            s_sampler = GPU::GenerateSampler();
+            GPU::SetSamplerTextureFilteringMode(*s_sampler, TextureFilteringOperation::Minify, TextureFilteringMode::Linear);
+            GPU::SetSamplerTextureFilteringMode(*s_sampler, TextureFilteringOperation::Magnify, TextureFilteringMode::Linear);
+            GPU::SetSamplerTextureWrappingMode(*s_sampler, TextureWrappingAxis::S, TextureWrappingMode::ClampToEdge);
+            GPU::SetSamplerTextureWrappingMode(*s_sampler, TextureWrappingAxis::T, TextureWrappingMode::ClampToEdge);
+        }
+        return *s_sampler;
+    }
+
+    int GradientLUT::GetResolution(TexturePrecision t_precision) {
+        // 8-bit output can't resolve more than 256 steps, floating point targets get finer ramps
+        return t_precision == TexturePrecision::Usual ? GRADIENT_LUT_RESOLUTION : GRADIENT_LUT_RESOLUTION * 4;
+    }
+
+    void GradientLUT::Clear() {
+        for (auto& [key, gradientTexture] : s_textures) {
+            GPU::DestroyTexture(gradientTexture.texture);
+        }
+        s_textures.clear();
+    }
+}
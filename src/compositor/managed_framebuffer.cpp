@@ -1,6 +1,7 @@
 #include "compositor/managed_framebuffer.h"
 #include "compositor/compositor.h"
 #include "gpu/gpu.h"
+#include "common/double_buffering_index.h"
 
 namespace Raster {
     ManagedFramebuffer::ManagedFramebuffer() {
@@ -16,13 +17,26 @@ namespace Raster {
     Framebuffer& ManagedFramebuffer::Get(std::optional<Framebuffer> t_framebuffer) {
         EnsureResolutionConstraints(t_framebuffer);
         auto& internalFramebuffer =  m_internalFramebuffer.Get();
+        auto& writtenRegion = m_writtenRegions[DoubleBufferingIndex::s_index % 2];
         GPU::BindFramebuffer(internalFramebuffer);
-        GPU::ClearFramebuffer(0, 0, 0, 0);
+        // only pixels touched last time need to be cleared
+        if (!writtenRegion.has_value() || writtenRegion->Covers(internalFramebuffer.width, internalFramebuffer.height)) {
+            GPU::ClearFramebuffer(0, 0, 0, 0);
+        } else if (!writtenRegion->IsEmpty()) {
+            GPU::SetScissorRect(writtenRegion->ToScissor());
+            GPU::ClearFramebuffer(0, 0, 0, 0);
+            GPU::SetScissorRect(std::nullopt);
+        }
+        writtenRegion = std::nullopt;
+        m_baseRegion = PixelRegion();
         if (t_framebuffer.has_value() && t_framebuffer.value().handle && t_framebuffer.value().attachments.size() == internalFramebuffer.attachments.size() && t_framebuffer->attachments[0].precision == internalFramebuffer.attachments[0].precision) {
             auto& framebuffer = t_framebuffer.value();
+            m_baseRegion = DomainOfDefinition::GetOrFull(framebuffer.attachments[0]).Clamp(internalFramebuffer.width, internalFramebuffer.height);
             int index = 0;
             for (auto& attachment : framebuffer.attachments) {
-                GPU::BlitTexture(internalFramebuffer.attachments[index++], attachment);
+                if (m_baseRegion.Covers(internalFramebuffer.width, internalFramebuffer.height)) {
+                    GPU::BlitTexture(internalFramebuffer.attachments[index++], attachment);
+                } else GPU::BlitTexture(internalFramebuffer.attachments[index++], attachment, m_baseRegion.ToScissor());
             }
         }
         return internalFramebuffer;
@@ -30,9 +44,21 @@ namespace Raster {
 
     Framebuffer& ManagedFramebuffer::GetWithoutBlitting(std::optional<Framebuffer> t_framebuffer) {
         EnsureResolutionConstraints(t_framebuffer);
+        m_writtenRegions[DoubleBufferingIndex::s_index % 2] = std::nullopt;
         return m_internalFramebuffer.Get();
     }
 
+    PixelRegion ManagedFramebuffer::GetBaseRegion() {
+        return m_baseRegion;
+    }
+
+    void ManagedFramebuffer::SetDomainOfDefinition(PixelRegion t_region) {
+        auto& internalFramebuffer = m_internalFramebuffer.Get();
+        t_region = t_region.Clamp(internalFramebuffer.width, internalFramebuffer.height);
+        m_writtenRegions[DoubleBufferingIndex::s_index % 2] = t_region;
+        DomainOfDefinition::Set(internalFramebuffer, t_region);
+    }
+
     Framebuffer& ManagedFramebuffer::GetReadyFramebuffer() {
         return m_internalFramebuffer.GetFrontFramebuffer();
     }
@@ -57,11 +83,13 @@ namespace Raster {
         if (!m_internalFramebuffer.Get().handle) return;
         m_internalFramebuffer.Destroy();
         m_internalFramebuffer = DoubleBufferedFramebuffer();
+        m_writtenRegions[0] = m_writtenRegions[1] = std::nullopt;
     }
 
     void ManagedFramebuffer::InstantiateInternalFramebuffer(uint32_t width, uint32_t height, TexturePrecision precision) {
         if (m_internalFramebuffer.width == width && m_internalFramebuffer.height == height && (!m_internalFramebuffer.Get().attachments.empty() && m_internalFramebuffer.Get().attachments[0].precision == precision)) return;
-        DestroyInternalFramebuffer();
-        this->m_internalFramebuffer = Compositor::GenerateCompatibleDoubleBufferedFramebuffer({width, height}, precision);
+        if (m_internalFramebuffer.Get().handle) Compositor::RecycleFramebuffer(m_internalFramebuffer);
+        this->m_internalFramebuffer = Compositor::AcquireDoubleBufferedFramebuffer({width, height}, precision);
+        m_writtenRegions[0] = m_writtenRegions[1] = std::nullopt;
     }
 };
\ No newline at end of file
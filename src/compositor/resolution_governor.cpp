@@ -0,0 +1,80 @@
+#include "compositor/resolution_governor.h"
+#include "common/workspace.h"
+#include "common/rendering.h"
+
+// frames to wait after switching before the new scale is judged
+#define GOVERNOR_SETTLE_FRAMES 4
+// frames of headroom required before going back to a higher scale
+#define GOVERNOR_UPSCALE_FRAMES 30
+#define GOVERNOR_DOWNSCALE_THRESHOLD 0.95f
+#define GOVERNOR_UPSCALE_THRESHOLD 0.7f
+
+namespace Raster {
+    bool ResolutionGovernor::s_enabled = false;
+    float ResolutionGovernor::s_maxScale = 1.0f;
+    glm::vec2 ResolutionGovernor::s_viewportSize = glm::vec2(0);
+
+    static std::vector<float> s_scaleSteps = {1.0f, 0.75f, 0.5f, 0.33f, 0.25f};
+    static int s_stepIndex = 0;
+    static int s_framesSinceSwitch = 0;
+    static float s_averageRenderTime = 0.0f;
+    static float s_lastScale = 1.0f;
+    static bool s_wasPlaying = false;
+
+    static float GetScaleLimit() {
+        float limit = std::clamp(ResolutionGovernor::s_maxScale, 0.05f, 1.0f);
+        if (!Workspace::IsProjectLoaded()) return limit;
+        auto resolution = Workspace::GetProject().preferredResolution;
+        auto viewport = ResolutionGovernor::s_viewportSize;
+        if (viewport.x <= 0 || viewport.y <= 0 || resolution.x <= 0 || resolution.y <= 0) return limit;
+        // round up to the nearest step so the preview is never upscaled
+        float viewportScale = std::max(viewport.x / resolution.x, viewport.y / resolution.y);
+        for (int i = s_scaleSteps.size(); i --> 0;) {
+            if (s_scaleSteps[i] >= viewportScale) return std::min(limit, s_scaleSteps[i]);
+        }
+        return limit;
+    }
+
+    float ResolutionGovernor::GetScale(bool t_playing) {
+        if (!s_enabled || !t_playing) {
+            s_lastScale = std::clamp(s_maxScale, 0.05f, 1.0f);
+        } else s_lastScale = std::min(GetScaleLimit(), s_scaleSteps[s_stepIndex]);
+        return s_lastScale;
+    }
+
+    void ResolutionGovernor::ReportRenderTime(float t_renderTime, float t_frameBudget, bool t_playing) {
+        if (!s_enabled || !t_playing || t_frameBudget <= 0) return;
+        s_averageRenderTime = s_averageRenderTime == 0.0f ? t_renderTime : glm::mix(s_averageRenderTime, t_renderTime, 0.2f);
+        s_framesSinceSwitch++;
+        if (s_framesSinceSwitch < GOVERNOR_SETTLE_FRAMES) return;
+
+        int previousStepIndex = s_stepIndex;
+        if (s_averageRenderTime > t_frameBudget * GOVERNOR_DOWNSCALE_THRESHOLD) {
+            // skip steps above the actually used scale, they wouldn't change anything
+            while (s_stepIndex + 1 < s_scaleSteps.size() && s_scaleSteps[s_stepIndex] >= s_lastScale) s_stepIndex++;
+        } else if (s_stepIndex > 0 && s_framesSinceSwitch >= GOVERNOR_UPSCALE_FRAMES && s_scaleSteps[s_stepIndex] <= s_lastScale) {
+            // render time grows roughly with pixel count
+            float current = s_scaleSteps[s_stepIndex], next = s_scaleSteps[s_stepIndex - 1];
+            float predictedRenderTime = s_averageRenderTime * (next * next) / (current * current);
+            if (predictedRenderTime < t_frameBudget * GOVERNOR_UPSCALE_THRESHOLD) s_stepIndex--;
+        }
+        if (s_stepIndex != previousStepIndex) {
+            float current = s_scaleSteps[previousStepIndex], next = s_scaleSteps[s_stepIndex];
+            s_averageRenderTime *= (next * next) / (current * current);
+            s_framesSinceSwitch = 0;
+        }
+    }
+
+    void ResolutionGovernor::UpdatePlaybackState(bool t_playing) {
+        if (s_wasPlaying && !t_playing && s_lastScale < std::clamp(s_maxScale, 0.05f, 1.0f)) {
+            Rendering::ForceRenderFrame();
+        }
+        s_wasPlaying = t_playing;
+    }
+
+    void ResolutionGovernor::Reset() {
+        s_stepIndex = 0;
+        s_framesSinceSwitch = 0;
+        s_averageRenderTime = 0.0f;
+    }
+};
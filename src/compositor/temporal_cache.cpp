@@ -0,0 +1,196 @@
+#include "compositor/temporal_cache.h"
+#include "compositor/compositor.h"
+
+namespace Raster {
+
+    struct TemporalCacheEntry {
+        std::optional<Framebuffer> framebuffer;
+        std::any value;
+        size_t bytes;
+        uint64_t lastUsed;
+    };
+
+    static std::mutex s_temporalMutex;
+    static unordered_dense::map<uint64_t, TemporalCacheEntry> s_entries;
+    static uint64_t s_usageCounter = 0;
+    static uint64_t s_hits = 0, s_misses = 0;
+    static size_t s_usedBytes = 0;
+    static size_t s_budget = TEMPORAL_CACHE_MINIMUM_BUDGET;
+    static size_t s_maximumBudget = TEMPORAL_CACHE_MAXIMUM_BUDGET;
+    // working sets requested by each node, budget grows to fit all of them
+    static unordered_dense::map<int, size_t> s_reservations;
+
+    static size_t GetFramebufferBytes(Framebuffer& t_framebuffer) {
+        size_t bytes = 0;
+        for (auto& attachment : t_framebuffer.attachments) {
+            size_t channelBytes = 1;
+            if (attachment.precision == TexturePrecision::Half) channelBytes = 2;
+            if (attachment.precision == TexturePrecision::Full) channelBytes = 4;
+            bytes += (size_t) attachment.width * attachment.height * attachment.channels * channelBytes;
+        }
+        return bytes;
+    }
+
+    static void EvictEntries(std::optional<uint64_t> t_protectedKey = std::nullopt) {
+        // expects s_temporalMutex to be locked
+        if (s_usedBytes <= s_budget) return;
+        std::vector<std::pair<uint64_t, uint64_t>> candidates;
+        for (auto& [key, entry] : s_entries) {
+            // entry that is just being returned to the caller stays alive even if it alone exceeds the budget
+            if (key == t_protectedKey) continue;
+            candidates.push_back({entry.lastUsed, key});
+        }
+        std::sort(candidates.begin(), candidates.end());
+        for (auto& candidate : candidates) {
+            if (s_usedBytes <= s_budget) break;
+            auto& entry = s_entries[candidate.second];
+            if (entry.framebuffer.has_value()) GPU::DestroyFramebufferWithAttachments(entry.framebuffer.value());
+            s_usedBytes -= entry.bytes;
+            s_entries.erase(candidate.second);
+        }
+    }
+
+    uint64_t TemporalCache::MakeKey(int t_producerPinID, float t_frame, uint64_t t_dependencyHash) {
+        return HashCombine(HashCombine(t_dependencyHash, HashValue(t_producerPinID)), HashValue(t_frame));
+    }
+
+    uint64_t TemporalCache::ComputeDependencyHash(int t_producerPinID) {
+        uint64_t hash = HashValue(Compositor::GetRequiredResolution());
+        hash = HashCombine(hash, HashValue(Compositor::s_colorPrecision));
+
+        std::vector<int> pendingPins = {t_producerPinID};
+        std::set<int> visitedNodes;
+        std::set<int> visitedCompositions;
+        while (!pendingPins.empty()) {
+            auto pinID = pendingPins.back();
+            pendingPins.pop_back();
+            auto nodeCandidate = Workspace::GetNodeByPinID(pinID);
+            if (!nodeCandidate.has_value()) continue;
+            auto& node = nodeCandidate.value();
+            if (!visitedNodes.insert(node->nodeID).second) continue;
+
+            auto serializedNode = node->Serialize().dump();
+            hash = HashCombine(hash, HashBytes(serializedNode.data(), serializedNode.size()));
+            for (auto& inputPin : node->inputPins) {
+                if (inputPin.connectedPinID > 0) pendingPins.push_back(inputPin.connectedPinID);
+            }
+
+            // keyframes of exposed attributes live in the composition, not in the node
+            auto compositionCandidate = Workspace::GetCompositionByNodeID(node->nodeID);
+            if (!compositionCandidate.has_value()) continue;
+            auto& composition = *compositionCandidate.value();
+            if (!visitedCompositions.insert(composition.id).second) continue;
+            hash = HashCombine(hash, HashValue(composition.beginFrame));
+            hash = HashCombine(hash, HashValue(composition.cutTimeOffset));
+            for (auto& attribute : composition.attributes) {
+                auto serializedAttribute = attribute->Serialize().dump();
+                hash = HashCombine(hash, HashBytes(serializedAttribute.data(), serializedAttribute.size()));
+            }
+        }
+        return hash;
+    }
+
+    std::optional<Framebuffer> TemporalCache::GetFramebuffer(uint64_t t_key) {
+        RASTER_SYNCHRONIZED(s_temporalMutex);
+        auto entryIterator = s_entries.find(t_key);
+        if (entryIterator == s_entries.end() || !entryIterator->second.framebuffer.has_value()) {
+            s_misses++;
+            return std::nullopt;
+        }
+        s_hits++;
+        entryIterator->second.lastUsed = ++s_usageCounter;
+        return entryIterator->second.framebuffer;
+    }
+
+    Framebuffer TemporalCache::PutFramebuffer(uint64_t t_key, Framebuffer& t_framebuffer) {
+        RASTER_SYNCHRONIZED(s_temporalMutex);
+        auto entryIterator = s_entries.find(t_key);
+        if (entryIterator != s_entries.end() && entryIterator->second.framebuffer.has_value()) {
+            entryIterator->second.lastUsed = ++s_usageCounter;
+            return entryIterator->second.framebuffer.value();
+        }
+        if (entryIterator != s_entries.end()) s_usedBytes -= entryIterator->second.bytes;
+
+        std::vector<Texture> attachments;
+        for (auto& attachment : t_framebuffer.attachments) {
+            attachments.push_back(GPU::GenerateTexture(attachment.width, attachment.height, attachment.channels, attachment.precision));
+        }
+        auto copy = GPU::GenerateFramebuffer(t_framebuffer.width, t_framebuffer.height, attachments);
+        for (int i = 0; i < t_framebuffer.attachments.size(); i++) {
+            GPU::BlitFramebuffer(copy, t_framebuffer.attachments[i], i);
+        }
+
+        TemporalCacheEntry entry;
+        entry.framebuffer = copy;
+        entry.bytes = GetFramebufferBytes(copy);
+        entry.lastUsed = ++s_usageCounter;
+        s_entries[t_key] = entry;
+        s_usedBytes += entry.bytes;
+        EvictEntries(t_key);
+        return copy;
+    }
+
+    std::optional<std::any> TemporalCache::GetValue(uint64_t t_key) {
+        RASTER_SYNCHRONIZED(s_temporalMutex);
+        auto entryIterator = s_entries.find(t_key);
+        if (entryIterator == s_entries.end() || !entryIterator->second.value.has_value()) {
+            s_misses++;
+            return std::nullopt;
+        }
+        s_hits++;
+        entryIterator->second.lastUsed = ++s_usageCounter;
+        return entryIterator->second.value;
+    }
+
+    void TemporalCache::PutValue(uint64_t t_key, std::any t_value) {
+        RASTER_SYNCHRONIZED(s_temporalMutex);
+        TemporalCacheEntry entry;
+        entry.value = t_value;
+        // rough footprint of a cpu-side value, keeps them evictable
+        entry.bytes = 256;
+        entry.lastUsed = ++s_usageCounter;
+        auto entryIterator = s_entries.find(t_key);
+        if (entryIterator != s_entries.end()) s_usedBytes -= entryIterator->second.bytes;
+        s_entries[t_key] = entry;
+        s_usedBytes += entry.bytes;
+        EvictEntries(t_key);
+    }
+
+    void TemporalCache::Reserve(int t_ownerID, Framebuffer& t_framebuffer, int t_entriesCount) {
+        RASTER_SYNCHRONIZED(s_temporalMutex);
+        s_reservations[t_ownerID] = GetFramebufferBytes(t_framebuffer) * std::max(t_entriesCount, 1);
+        size_t reservedBytes = 0;
+        for (auto& [ownerID, bytes] : s_reservations) reservedBytes += bytes;
+        s_budget = std::clamp(reservedBytes, (size_t) TEMPORAL_CACHE_MINIMUM_BUDGET, std::max(s_maximumBudget, (size_t) TEMPORAL_CACHE_MINIMUM_BUDGET));
+        EvictEntries();
+    }
+
+    TemporalCacheStatistics TemporalCache::GetStatistics() {
+        RASTER_SYNCHRONIZED(s_temporalMutex);
+        TemporalCacheStatistics statistics = {};
+        statistics.hits = s_hits;
+        statistics.misses = s_misses;
+        statistics.entriesCount = s_entries.size();
+        statistics.usedBytes = s_usedBytes;
+        statistics.budgetBytes = s_budget;
+        return statistics;
+    }
+
+    void TemporalCache::SetBudget(size_t t_bytes) {
+        RASTER_SYNCHRONIZED(s_temporalMutex);
+        s_maximumBudget = t_bytes;
+        s_budget = std::min(s_budget, t_bytes);
+        EvictEntries();
+    }
+
+    void TemporalCache::Clear() {
+        RASTER_SYNCHRONIZED(s_temporalMutex);
+        for (auto& [key, entry] : s_entries) {
+            if (entry.framebuffer.has_value()) GPU::DestroyFramebufferWithAttachments(entry.framebuffer.value());
+        }
+        s_entries.clear();
+        s_reservations.clear();
+        s_usedBytes = 0;
+        s_budget = std::min((size_t) TEMPORAL_CACHE_MINIMUM_BUDGET, s_maximumBudget);
+    }
+};
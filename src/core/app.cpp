@@ -5,6 +5,7 @@
 #include "dockspace.h"
 #include "gpu/gpu.h"
 #include "gpu/async_upload.h"
+#include "gpu/shader_compiler.h"
 #include "font/font.h"
 #include "common/common.h"
 #include "build_number.h"
@@ -27,8 +28,13 @@
 #include "common/waveform_manager.h"
 #include "common/dispatchers.h"
 #include "common/audio_memory_management.h"
+#include "common/task_scheduler.h"
+#include "common/composition_index.h"
 #include "common/examples.h"
 #include "common/color_management.h"
+#include "common/profiler.h"
+#include "compositor/gradient_lut.h"
+#include "compositor/convolution.h"
 #include "../ImGui/ImGuizmo.h"
 
 using namespace av;
@@ -63,6 +69,7 @@ namespace Raster {
         GPU::InitializeImGui();
         ColorManagement::Initialize();
         AsyncUpload::Initialize();
+        ShaderCompiler::Initialize();
         AsyncRendering::Initialize();
         GPU::SetRenderingFunction(App::RenderLoop);
         GPU::StartRenderingThread();
@@ -87,6 +94,7 @@ namespace Raster {
         Plugins::WorkspaceInitialize();
 
         AudioMemoryManagement::Initialize(1024 * 1024 * 1);
+        TaskScheduler::Initialize();
         WaveformManager::Initialize();
 
         auto& io = ImGui::GetIO();
@@ -240,6 +248,7 @@ namespace Raster {
         static bool firstFrame = true;
         if (firstFrame) {
             InitializeInternals();
+            Profiler::SetThreadName("User Interface");
             firstFrame = false;
         }
         UIShared::s_timelineAnykeyframeDragged = false;
@@ -287,16 +296,8 @@ namespace Raster {
                     }
                 }
 
-                for (auto& composition : project.compositions) {
-                    if (!IsInBounds(project.currentFrame, composition.GetBeginFrame() - 1, composition.GetEndFrame() + 1) && !composition.identityState) {
-                        composition.identityState = true;
-                        project.SetFakeTime(composition.GetBeginFrame());
-                        composition.OnTimelineSeek();
-                        project.ResetFakeTime();
-                    }
-                    if (IsInBounds(project.currentFrame, composition.GetBeginFrame() - 1, composition.GetEndFrame() + 1)) {
-                        composition.identityState = true;
-                    }
+                for (auto compositionIndex : CompositionIndex::GetLockedCompositions(project)) {
+                    auto& composition = project.compositions[compositionIndex];
                     if (composition.lockedCompositionID < 0) continue;
                     if (composition.lockedCompositionID == composition.id) {
                         composition.lockedCompositionID = -1;
@@ -311,6 +312,19 @@ namespace Raster {
                     composition.beginFrame = lockedComposition->beginFrame;
                     composition.endFrame = lockedComposition->endFrame;
                 }
+
+                // compositions only appear or move on edits, which always rebuild the index
+                if (CompositionIndex::Update(project)) {
+                    for (auto& composition : project.compositions) {
+                        if (composition.identityState) continue;
+                        composition.identityState = true;
+                        if (!IsInBounds(project.currentFrame, composition.GetBeginFrame() - 1, composition.GetEndFrame() + 1)) {
+                            project.SetFakeTime(composition.GetBeginFrame());
+                            composition.OnTimelineSeek();
+                            project.ResetFakeTime();
+                        }
+                    }
+                }
             }
             GPU::BindFramebuffer(std::nullopt);
             if (Workspace::s_project.has_value()) {
@@ -337,6 +351,16 @@ namespace Raster {
             GPU::BindFramebuffer(std::nullopt);
         GPU::EndFrame();
         GPU::Flush();
+        // node previews record GPU zones on this thread too
+        Profiler::CollectGPUZones();
+        // node previews fill this thread's GPU caches as well, they're released with the project they belong to
+        static int s_projectGeneration = 0;
+        if (s_projectGeneration != Workspace::s_projectGeneration) {
+            GradientLUT::Clear();
+            Convolution::Clear();
+            Compositor::ClearFramebufferPool();
+            s_projectGeneration = Workspace::s_projectGeneration;
+        }
         AsyncRendering::AllowRendering();
 
         if (Workspace::IsProjectLoaded()) {
@@ -362,11 +386,13 @@ namespace Raster {
     void App::Terminate() {
         AsyncRendering::Terminate();
         AsyncUpload::Terminate();
+        ShaderCompiler::Terminate();
         if (Workspace::s_project.has_value()) {
             Workspace::GetProject().compositions.clear();
         }
         GPU::Terminate();
         Audio::Terminate();
+        TaskScheduler::Terminate();
         AudioMemoryManagement::Terminate();
         WaveformManager::Terminate();
         s_writerThreadRunning = false;
@@ -17,6 +17,7 @@
 #include "../ImGui/imgui_stdlib.h"
 #include "common/layouts.h"
 #include "common/waveform_manager.h"
+#include "common/profiler.h"
 
 #define LAYOUT_DRAG_DROP_PAYLOAD "LAYOUT_DRAG_DROP_PAYLOAD"
 
@@ -167,6 +168,12 @@ namespace Raster {
                 if (ImGui::MenuItem(saveProject.c_str(), "Ctrl+S", nullptr, Workspace::IsProjectLoaded() && Workspace::GetProject().packedProjectPath.find(".raster_example") == std::string::npos)) {
                     Workspace::SaveProject();
                 }
+                auto compactProjectText = Workspace::IsProjectCompacting() ?
+                                            FormatString("%s %s", ICON_FA_SPINNER, Localization::GetString("COMPACT_PROJECT").c_str()) :
+                                            FormatString("%s %s (%i MB)", ICON_FA_BOX_ARCHIVE, Localization::GetString("COMPACT_PROJECT").c_str(), (int) (Workspace::s_projectManifest.staleBytes / (1024 * 1024)));
+                if (ImGui::MenuItem(compactProjectText.c_str(), nullptr, false, Workspace::IsProjectLoaded() && !Workspace::IsProjectCompacting() && Workspace::s_projectManifest.staleBytes > 0)) {
+                    Workspace::CompactProject();
+                }
                 auto saveProjectAsText = Workspace::IsProjectLoaded() ? 
                                             FormatString(Localization::GetString("SAVE_PROJECT_AS_FORMAT").c_str(), Workspace::GetProject().name.c_str()) :
                                             Localization::GetString("SAVE_PROJECT_AS");
@@ -235,6 +242,28 @@ namespace Raster {
                         WaveformManager::RequestWaveformRefresh(composition.id);
                     }
                 }
+                ImGui::Separator();
+                bool profilerEnabled = Profiler::s_enabled;
+                if (ImGui::MenuItem(FormatString("%s %s", ICON_FA_STOPWATCH, Localization::GetString("ENABLE_PROFILER").c_str()).c_str(), nullptr, profilerEnabled)) {
+                    Profiler::SetEnabled(!profilerEnabled);
+                }
+                if (ImGui::MenuItem(FormatString("%s %s", ICON_FA_TRASH_CAN, Localization::GetString("CLEAR_PROFILER_DATA").c_str()).c_str())) {
+                    Profiler::Clear();
+                }
+                if (ImGui::MenuItem(FormatString("%s %s", ICON_FA_FILE_EXPORT, Localization::GetString("EXPORT_CHROME_TRACE").c_str()).c_str())) {
+                    NFD::UniquePath path;
+                    static nfdfilteritem_t s_traceFilters[] = {
+                        {"Chrome Trace", "json"}
+                    };
+                    nfdresult_t result = NFD::SaveDialog(path, s_traceFilters, 1, GetHomePath().c_str());
+                    if (result == NFD_OKAY) {
+                        std::string tracePath = path.get();
+                        if (!StringEndsWith(tracePath, ".json")) {
+                            tracePath += ".json";
+                        }
+                        Profiler::ExportChromeTrace(tracePath);
+                    }
+                }
                 ImGui::EndMenu();
             }
 
@@ -60,6 +60,24 @@ namespace Raster {
     }
 
     float BezierEasing::Get(float t_percentage) {
+        EnsureCompiled();
+        return SolveCompiled(t_percentage);
+    }
+
+    void BezierEasing::Evaluate(const std::vector<float>& t_percentages, std::vector<float>& t_values) {
+        EnsureCompiled();
+        t_values.resize(t_percentages.size());
+        for (size_t i = 0; i < t_percentages.size(); i++) {
+            t_values[i] = SolveCompiled(t_percentages[i]);
+        }
+    }
+
+    void BezierEasing::EnsureCompiled() {
+        // control points are edited in place by the UI, so they are compared against compiled ones
+        if (!m_compiledPoints.has_value() || *m_compiledPoints != m_points) Compile();
+    }
+
+    void BezierEasing::Compile() {
         float p1x = m_points[0];
         float p1y = m_points[1];
         float p2x = m_points[2];
@@ -73,7 +91,45 @@ namespace Raster {
         this->m_by = 3.0 * (p2y - p1y) - m_cy;
         this->m_ay = 1.0 - m_cy - m_by;
 
-        return Solve(t_percentage, EPSILON);
+        this->m_linear = p1x == p1y && p2x == p2y;
+        this->m_monotonic = IsInBounds(p1x, 0.0f, 1.0f) && IsInBounds(p2x, 0.0f, 1.0f);
+        for (int i = 0; i < BEZIER_SAMPLES_COUNT; i++) {
+            m_samplesX[i] = SampleCurveX((double) i / (BEZIER_SAMPLES_COUNT - 1));
+        }
+        this->m_compiledPoints = m_points;
+    }
+
+    float BezierEasing::SolveCompiled(float x) {
+        if (m_linear) return x;
+        if (!m_monotonic || x <= 0.0f || x >= 1.0f) return Solve(x, EPSILON);
+
+        // initial guess is interpolated from the sampled table
+        auto upper = std::upper_bound(m_samplesX.begin() + 1, m_samplesX.end() - 1, x);
+        int index = upper - m_samplesX.begin() - 1;
+        float step = 1.0f / (BEZIER_SAMPLES_COUNT - 1);
+        float sampleWidth = m_samplesX[index + 1] - m_samplesX[index];
+        float t0 = index * step, t1 = t0 + step;
+        float t = t0 + (sampleWidth > 0 ? (x - m_samplesX[index]) / sampleWidth : 0.0f) * step;
+
+        // guess is already close, so a couple of Newton steps are enough where curve isn't flat
+        float slope = SampleCurveDerivativeX(t);
+        if (slope >= 1e-3f) {
+            for (int i = 0; i < 2; i++) {
+                float error = SampleCurveX(t) - x;
+                if (glm::abs(error) < EPSILON) break;
+                t -= error / SampleCurveDerivativeX(t);
+            }
+            return SampleCurveY(glm::clamp(t, t0, t1));
+        }
+
+        // flat parts of the curve fall back to bisection within the sample interval,
+        // x barely changes there, so interval is narrowed down in t instead of stopping at small x error
+        for (int i = 0; i < 20; i++) {
+            t = (t0 + t1) * 0.5f;
+            if (SampleCurveX(t) < x) t0 = t;
+            else t1 = t;
+        }
+        return SampleCurveY((t0 + t1) * 0.5f);
     }
 
     void BezierEasing::AbstractLoad(Json t_data) {
@@ -4,6 +4,8 @@
 #include "common/easings.h"
 
 #define EPSILON 1e-6
+// amount of x(t) samples used to find initial guess for the solver
+#define BEZIER_SAMPLES_COUNT 33
 
 namespace Raster {
 
@@ -22,6 +24,7 @@ namespace Raster {
         BezierEasing();
 
         float Get(float t_percentage);
+        void Evaluate(const std::vector<float>& t_percentages, std::vector<float>& t_values);
 
         void AbstractRenderDetails();
 
@@ -30,6 +33,11 @@ namespace Raster {
 
     private:
 
+        // recomputes coefficients and sampled x(t) table, called when control points change
+        void Compile();
+        void EnsureCompiled();
+        float SolveCompiled(float x);
+
         float SampleCurveX(double t);
         float SampleCurveY(double t);
         float SampleCurveDerivativeX(double t);
@@ -39,6 +47,12 @@ namespace Raster {
 
         float m_cx, m_bx, m_ax, m_cy, m_by, m_ay;
 
+        std::optional<glm::vec4> m_compiledPoints;
+        std::array<float, BEZIER_SAMPLES_COUNT> m_samplesX;
+        // x(t) is monotonic when both control points stay within [0; 1] horizontally, so sampled table can be searched
+        bool m_monotonic;
+        bool m_linear;
+
         glm::vec4 m_points;
         bool m_constrained;
     };
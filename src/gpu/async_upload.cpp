@@ -1,4 +1,5 @@
 #include "gpu/async_upload.h"
+#include "common/profiler.h"
 
 namespace Raster {
     std::mutex AsyncUpload::m_infoMutex;
@@ -11,6 +12,7 @@ namespace Raster {
     AsyncUploadInfo::AsyncUploadInfo() {
         this->ready = false;
         this->executed = false;
+        this->streamLevel = 0;
     }
 
     void AsyncUpload::Initialize() {
@@ -38,6 +40,19 @@ namespace Raster {
         return uploadID;
     }
 
+    AsyncUploadInfoID AsyncUpload::GenerateTextureFromImagePath(std::string t_path, int t_level) {
+        int uploadID = ++s_uploadIdCache;
+        AsyncUploadInfo info;
+        info.streamPath = t_path;
+        info.streamLevel = t_level;
+        info.ready = false;
+        info.texture = Texture();
+
+        SyncPutAsyncUploadInfo(uploadID, info);
+
+        return uploadID;
+    }
+
     void AsyncUpload::DestroyTexture(Texture texture) {
         AsyncUploadInfo info;
         info.deleteTexture = texture;
@@ -65,17 +80,16 @@ namespace Raster {
 
     void AsyncUpload::UploaderLogic() {
         GPU::SetCurrentContext(m_context);
+        Profiler::SetThreadName("Async Upload");
 
-        std::vector<int> skipID;
         while (m_running) {
-            if (SyncIsInfosEmpty()) {
+            auto pairCandidate = SyncGetFirstAsyncUploadInfo();
+            if (!pairCandidate) {
                 std::this_thread::sleep_for(std::chrono::milliseconds(100));
                 continue;
             }
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
-            auto pair = SyncGetFirstAsyncUploadInfo();
+            auto& pair = *pairCandidate;
             auto& info = pair.second;
-            if (info.executed) continue;
 
             info.executed = true;
             if (info.deleteTexture.handle) {
@@ -84,6 +98,16 @@ namespace Raster {
                 continue;
             }
 
+            if (info.streamPath) {
+                RASTER_PROFILE_ZONE("Texture Stream");
+                auto textureCandidate = StreamTexture(*info.streamPath, info.streamLevel, info.colorSpace);
+                if (textureCandidate) info.texture = *textureCandidate;
+                info.ready = true;
+                SyncPutAsyncUploadInfo(pair.first, info);
+                continue;
+            }
+
+            RASTER_PROFILE_ZONE("Texture Upload");
             TexturePrecision precision = TexturePrecision::Usual;
             if (info.image->precision == ImagePrecision::Half) precision = TexturePrecision::Half;
             if (info.image->precision == ImagePrecision::Full) precision = TexturePrecision::Full;
@@ -101,6 +125,34 @@ namespace Raster {
         }
     }
 
+    std::optional<Texture> AsyncUpload::StreamTexture(std::string t_path, int t_level, std::string& t_colorSpace) {
+        static constexpr uint32_t s_bandRows = 256;
+
+        auto descriptionCandidate = ImageLoader::Describe(t_path);
+        if (!descriptionCandidate) return std::nullopt;
+        auto& description = *descriptionCandidate;
+        t_colorSpace = description.colorSpace;
+
+        TexturePrecision precision = TexturePrecision::Usual;
+        if (description.precision == ImagePrecision::Half) precision = TexturePrecision::Half;
+        if (description.precision == ImagePrecision::Full) precision = TexturePrecision::Full;
+
+        auto size = ImageLoader::GetLevelSize(description, t_level);
+        auto texture = GPU::GenerateTexture(size.x, size.y, description.channels, precision, true);
+        for (uint32_t y = 0; y < size.y && m_running; y += s_bandRows) {
+            auto bandCandidate = ImageLoader::LoadRegion(t_path, t_level, y, s_bandRows);
+            if (!bandCandidate) {
+                GPU::DestroyTexture(texture);
+                return std::nullopt;
+            }
+            auto& band = *bandCandidate;
+            GPU::UpdateTexture(texture, 0, y, band.width, band.height, band.channels, band.data.data());
+        }
+        GPU::GenerateMipmaps(texture);
+        GPU::Flush();
+        return texture;
+    }
+
     void AsyncUpload::SyncDestroyAsyncUploadInfo(AsyncUploadInfoID t_id) {
         std::lock_guard<std::mutex> lg(m_infoMutex);
         m_infos.erase(t_id);
@@ -127,9 +179,12 @@ namespace Raster {
         return true;
     }
 
-    std::pair<int, AsyncUploadInfo> AsyncUpload::SyncGetFirstAsyncUploadInfo() {
+    std::optional<std::pair<int, AsyncUploadInfo>> AsyncUpload::SyncGetFirstAsyncUploadInfo() {
         std::lock_guard<std::mutex> lg(m_infoMutex); 
-        return *m_infos.begin();
+        for (auto& info : m_infos) {
+            if (!info.second.executed) return info;
+        }
+        return std::nullopt;
     }
 
     bool AsyncUpload::SyncAsyncUploadInfoExists(AsyncUploadInfoID t_id) {
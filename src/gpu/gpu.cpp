@@ -21,17 +21,21 @@
 #include "nfd/nfd_glfw3.h"
 #include "common/synchronized_value.h"
 #include "common/thread_unique_value.h"
+#include "compositor/domain_of_definition.h"
 
 #define HANDLE_TO_GLUINT(x) ((uint32_t) (uint64_t) (x))
 #define GLUINT_TO_HANDLE(x) ((void*) (uint64_t) (x))
 
+#ifndef GL_TIME_ELAPSED_EXT
+    #define GL_TIME_ELAPSED_EXT 0x88BF
+#endif
+
 namespace Raster {
 
 
     GPUInfo GPU::info{};
     Shader GPU::s_basicShader;
     Texture GPU::s_imageConvolutionPreviewTexture;
-    Pipeline GPU::s_kernelPreviewPipeline;
 
 
    void MessageCallback(GLenum source, GLenum type, GLuint id, GLenum severity, GLsizei length, GLchar const* message, void const* user_param)
@@ -222,6 +226,9 @@ namespace Raster {
 
     static SynchronizedValue<std::vector<std::string>> s_dragDropPaths;
     static ThreadUniqueValue<std::optional<glm::vec4>> s_clipRect;
+    static thread_local bool s_clippingEnabled = false;
+    static thread_local std::optional<glm::ivec4> s_scissorRect;
+    static thread_local glm::vec2 s_boundResolution = glm::vec2(0);
 
     void GPU::Initialize() {
         s_mainThreadID = std::this_thread::get_id();
@@ -290,6 +297,15 @@ namespace Raster {
         info.maxViewportX = maxViewportDims[0];
         info.maxViewportY = maxViewportDims[1];
 
+        info.timerQueriesSupported = false;
+        GLint extensionsCount;
+        glGetIntegerv(GL_NUM_EXTENSIONS, &extensionsCount);
+        for (GLint i = 0; i < extensionsCount; i++) {
+            if (std::string((const char*) glGetStringi(GL_EXTENSIONS, i)) == "GL_EXT_disjoint_timer_query") {
+                info.timerQueriesSupported = true;
+            }
+        }
+
         GLint maxUniformComponents;
         glGetIntegerv(GL_MAX_FRAGMENT_UNIFORM_COMPONENTS, &maxUniformComponents);
         DUMP_VAR(maxUniformComponents);
@@ -297,6 +313,7 @@ namespace Raster {
         DUMP_VAR(info.maxTextureSize);
         DUMP_VAR(info.maxViewportX);
         DUMP_VAR(info.maxViewportY);
+        DUMP_VAR(info.timerQueriesSupported);
 
         std::cout << info.version << std::endl;
         std::cout << info.renderer << std::endl;
@@ -309,7 +326,6 @@ namespace Raster {
             auto previewTexture = GPU::GenerateTexture(image.width, image.height, 3);
             GPU::UpdateTexture(previewTexture, 0, 0, previewTexture.width, previewTexture.height, 3, image.data.data());
             s_imageConvolutionPreviewTexture = previewTexture;
-            s_kernelPreviewPipeline = GPU::GeneratePipeline(GPU::s_basicShader, GPU::GenerateShader(ShaderType::Fragment, "kernel_preview/shader"));
         } else {
             RASTER_LOG("failed to load image_convolution_pipeline.jpg");
             RASTER_LOG("convolution kernel previews will not be available");
@@ -329,11 +345,25 @@ namespace Raster {
     }
 
     void GPU::EnableClipping() {
+        s_clippingEnabled = true;
         glEnable(GL_SCISSOR_TEST);
     }
 
     void GPU::DisableClipping() {
-        glDisable(GL_SCISSOR_TEST);
+        s_clippingEnabled = false;
+        if (!s_scissorRect) glDisable(GL_SCISSOR_TEST);
+    }
+
+    bool GPU::IsClippingEnabled() {
+        return s_clippingEnabled;
+    }
+
+    void GPU::EnableBlending() {
+        glEnable(GL_BLEND);
+    }
+
+    void GPU::DisableBlending() {
+        glDisable(GL_BLEND);
     }
 
     void GPU::SetClipRect(glm::vec2 upperLeft, glm::vec2 bottomRight) {
@@ -341,6 +371,43 @@ namespace Raster {
         clipRect = glm::vec4(upperLeft, bottomRight);
     }
 
+    static void ApplyScissor() {
+        auto& clipRectCandidate = s_clipRect.Get();
+        std::optional<glm::ivec4> scissor;
+        if (clipRectCandidate) {
+            auto clipRect = *clipRectCandidate;
+            auto targetResolution = s_boundResolution;
+            auto aspectRatio = targetResolution.x / targetResolution.y;
+            auto processedClipRect = clipRect;
+            processedClipRect.x /= aspectRatio;
+            processedClipRect.z /= aspectRatio;
+            auto upperLeft = glm::vec2(processedClipRect[0], processedClipRect[1]);
+            auto bottomRight = glm::vec2(processedClipRect[2], processedClipRect[3]);
+            upperLeft = NDCToScreen(upperLeft, targetResolution);
+            bottomRight = NDCToScreen(bottomRight, targetResolution);
+            auto size = glm::abs(bottomRight - upperLeft);
+            scissor = glm::ivec4(upperLeft.x - size.x, upperLeft.y - size.y, size.x, size.y);
+        }
+        if (s_scissorRect) {
+            auto rect = *s_scissorRect;
+            if (scissor && s_clippingEnabled) {
+                auto clip = *scissor;
+                int x0 = glm::max(rect.x, clip.x), y0 = glm::max(rect.y, clip.y);
+                int x1 = glm::min(rect.x + rect.z, clip.x + clip.z), y1 = glm::min(rect.y + rect.w, clip.y + clip.w);
+                scissor = glm::ivec4(x0, y0, glm::max(x1 - x0, 0), glm::max(y1 - y0, 0));
+            } else scissor = rect;
+            glEnable(GL_SCISSOR_TEST);
+        } else if (!s_clippingEnabled) {
+            glDisable(GL_SCISSOR_TEST);
+        }
+        if (scissor) glScissor(scissor->x, scissor->y, scissor->z, scissor->w);
+    }
+
+    void GPU::SetScissorRect(std::optional<glm::ivec4> t_rect) {
+        s_scissorRect = t_rect;
+        ApplyScissor();
+    }
+
     void GPU::StartRenderingThread() {
         static int s_viewportWidth = 0, s_viewportHeight = 0;
         s_running = true;
@@ -518,6 +585,7 @@ namespace Raster {
 
     void GPU::DestroyTexture(Texture texture) {
         if (!texture.handle) return;
+        DomainOfDefinition::Invalidate(texture);
         GLuint textureHandle = (uint32_t) (uint64_t) texture.handle;
         glDeleteTextures(1, &textureHandle);
     }
@@ -528,6 +596,12 @@ namespace Raster {
         SetShaderUniform(shader, name, unit);
     }
 
+    void GPU::BindTextureToShader(Shader shader, int location, Texture texture, int unit) {
+        glActiveTexture(GL_TEXTURE0 + unit);
+        glBindTexture(InterpretTextureDimensions(texture.dimensions), HANDLE_TO_GLUINT(texture.handle));
+        SetShaderUniform(shader, location, unit);
+    }
+
     // TODO: return std::optional<Framebuffer> instead of Framebuffer
     Framebuffer GPU::GenerateFramebuffer(uint32_t width, uint32_t height, std::vector<Texture> attachments) {
         // RASTER_LOG("generating framebuffer with " << width << "x" << height << " with " << attachments.size() << " attachments");
@@ -591,7 +665,6 @@ namespace Raster {
     }
 
     void GPU::BindFramebuffer(std::optional<Framebuffer> fbo) {
-        auto& clipRectCandidate = s_clipRect.Get();
         if (fbo.has_value()) {
             glBindFramebuffer(GL_FRAMEBUFFER, (GLuint) (uint64_t) fbo.value().handle);
             glViewport(0, 0, fbo.value().width, fbo.value().height);
@@ -599,22 +672,8 @@ namespace Raster {
             glBindFramebuffer(GL_FRAMEBUFFER, 0);
             glViewport(0, 0, s_width, s_height);
         }
-        if (clipRectCandidate) {
-            auto clipRect = *clipRectCandidate;
-            // print(clipRect.x << ' ' << clipRect.y << ' ' << clipRect.z << ' ' << clipRect.w);
-            auto targetResolution = fbo.has_value() ? glm::vec2(fbo->width, fbo->height) : glm::vec2(s_width, s_height);
-            auto aspectRatio = targetResolution.x / targetResolution.y;
-            auto processedClipRect = clipRect;
-            processedClipRect.x /= aspectRatio;
-            processedClipRect.z /= aspectRatio;
-            auto upperLeft = glm::vec2(processedClipRect[0], processedClipRect[1]);
-            auto bottomRight = glm::vec2(processedClipRect[2], processedClipRect[3]);
-            upperLeft = NDCToScreen(upperLeft, targetResolution);
-            bottomRight = NDCToScreen(bottomRight, targetResolution);
-            auto size = glm::abs(bottomRight - upperLeft);
-            glScissor(upperLeft.x - size.x, upperLeft.y - size.y, size.x, size.y);
-            // print(upperLeft.x << " " << upperLeft.y << " " << glm::abs(bottomRight - upperLeft).x << " " << glm::abs(bottomRight - upperLeft).y);
-        }
+        s_boundResolution = fbo.has_value() ? glm::vec2(fbo->width, fbo->height) : glm::vec2(s_width, s_height);
+        ApplyScissor();
     }
 
     ArrayBuffer GPU::GenerateBuffer(size_t size, ArrayBufferType type, ArrayBufferUsage usage) {
@@ -647,23 +706,33 @@ namespace Raster {
         glBindBufferBase(InterpretArrayBufferType(buffer.type), binding, HANDLE_TO_GLUINT(buffer.handle));
     }
 
+    static std::string GetShaderExtension(ShaderType type) {
+        switch (type) {
+            case ShaderType::Vertex: return ".vert";
+            case ShaderType::Fragment: return ".frag";
+            case ShaderType::Compute: return ".compute";
+        }
+        return "";
+    }
+
     Shader GPU::GenerateShader(ShaderType type, std::string name, bool useBinaryCache) {
+        return GenerateShaderFromSource(type, ReadFile("shaders/gl/" + name + GetShaderExtension(type)), name, useBinaryCache);
+    }
+
+    Shader GPU::GenerateShaderFromSource(ShaderType type, std::string code, std::string name, bool useBinaryCache) {
         GLenum enumType = 0;
-        std::string extension = "";
+        std::string extension = GetShaderExtension(type);
         switch (type) {
             case ShaderType::Vertex: {
                 enumType = GL_VERTEX_SHADER;
-                extension = ".vert";
                 break;
             }
             case ShaderType::Fragment: {
                 enumType = GL_FRAGMENT_SHADER;
-                extension = ".frag";
                 break;
             }
             case ShaderType::Compute: {
                 enumType = GL_COMPUTE_SHADER;
-                extension = ".compute";
                 break;
             }
         }
@@ -685,7 +754,6 @@ namespace Raster {
             std::filesystem::create_directory(shaderCachePath + "gl/" + vendorCache + "/");
         }
 
-        std::string code = ReadFile("shaders/gl/" + name + extension);
         std::string codeHash = std::to_string(RSHash(code));
 
         std::string shaderNameHash = std::to_string(RSHash(name + extension));
@@ -785,11 +853,13 @@ namespace Raster {
         glDeleteProgram(HANDLE_TO_GLUINT(shader.handle));
     }
 
-    void GPU::DestroyPipeline(Pipeline pipeline) {
+    void GPU::DestroyPipeline(Pipeline pipeline, bool destroyShaders) {
         if (!pipeline.handle) return;
-        if (pipeline.vertex.handle != s_basicShader.handle) DestroyShader(pipeline.vertex);
-        DestroyShader(pipeline.fragment);
-        DestroyShader(pipeline.compute);
+        if (destroyShaders) {
+            if (pipeline.vertex.handle != s_basicShader.handle) DestroyShader(pipeline.vertex);
+            DestroyShader(pipeline.fragment);
+            DestroyShader(pipeline.compute);
+        }
         GLuint handle = HANDLE_TO_GLUINT(pipeline.handle);
         glDeleteProgramPipelines(1, &handle);
     }
@@ -866,6 +936,31 @@ namespace Raster {
         glProgramUniform1iv(HANDLE_TO_GLUINT(shader.handle), location, size, i);
     }
 
+    void GPU::SetShaderUniform(Shader shader, int location, int i) {
+        if (location < 0) return;
+        glProgramUniform1iv(HANDLE_TO_GLUINT(shader.handle), location, 1, &i);
+    }
+
+    void GPU::SetShaderUniform(Shader shader, int location, glm::vec4 vec) {
+        if (location < 0) return;
+        glProgramUniform4fv(HANDLE_TO_GLUINT(shader.handle), location, 1, glm::value_ptr(vec));
+    }
+
+    void GPU::SetShaderUniform(Shader shader, int location, glm::vec3 vec) {
+        if (location < 0) return;
+        glProgramUniform3fv(HANDLE_TO_GLUINT(shader.handle), location, 1, glm::value_ptr(vec));
+    }
+
+    void GPU::SetShaderUniform(Shader shader, int location, glm::vec2 vec) {
+        if (location < 0) return;
+        glProgramUniform2fv(HANDLE_TO_GLUINT(shader.handle), location, 1, glm::value_ptr(vec));
+    }
+
+    void GPU::SetShaderUniform(Shader shader, int location, float f) {
+        if (location < 0) return;
+        glProgramUniform1fv(HANDLE_TO_GLUINT(shader.handle), location, 1, &f);
+    }
+
     void GPU::BindPipeline(Pipeline pipeline) {
         // glUseProgram(0);
         glBindProgramPipeline(HANDLE_TO_GLUINT(pipeline.handle));
@@ -886,6 +981,14 @@ namespace Raster {
                            HANDLE_TO_GLUINT(base.handle), GL_TEXTURE_2D, 0, 0, 0, 0, base.width, base.height, 1);
     }
 
+    void GPU::BlitTexture(Texture base, Texture blit, glm::ivec4 t_region) {
+        int x0 = glm::clamp(t_region.x, 0, (int) base.width), y0 = glm::clamp(t_region.y, 0, (int) base.height);
+        int x1 = glm::clamp(t_region.x + t_region.z, x0, (int) base.width), y1 = glm::clamp(t_region.y + t_region.w, y0, (int) base.height);
+        if (x1 == x0 || y1 == y0) return;
+        glCopyImageSubData(HANDLE_TO_GLUINT(blit.handle), GL_TEXTURE_2D, 0, x0, y0, 0,
+                           HANDLE_TO_GLUINT(base.handle), GL_TEXTURE_2D, 0, x0, y0, 0, x1 - x0, y1 - y0, 1);
+    }
+
     Sampler GPU::GenerateSampler() {
         GLuint sampler;
         glGenSamplers(1, &sampler);
@@ -932,15 +1035,39 @@ namespace Raster {
         sampler = Sampler();
     }
 
+    void* GPU::GenerateTimerQuery() {
+        GLuint query;
+        glGenQueries(1, &query);
+        return GLUINT_TO_HANDLE(query);
+    }
+
+    void GPU::BeginTimerQuery(void* query) {
+        glBeginQuery(GL_TIME_ELAPSED_EXT, HANDLE_TO_GLUINT(query));
+    }
+
+    void GPU::EndTimerQuery() {
+        glEndQuery(GL_TIME_ELAPSED_EXT);
+    }
+
+    std::optional<uint64_t> GPU::GetTimerQueryResult(void* query) {
+        GLuint available = GL_FALSE;
+        glGetQueryObjectuiv(HANDLE_TO_GLUINT(query), GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available) return std::nullopt;
+        // 32-bit result is enough for anything shorter than four seconds
+        GLuint elapsed = 0;
+        glGetQueryObjectuiv(HANDLE_TO_GLUINT(query), GL_QUERY_RESULT, &elapsed);
+        return elapsed;
+    }
+
+    void GPU::DestroyTimerQuery(void* query) {
+        GLuint handle = HANDLE_TO_GLUINT(query);
+        glDeleteQueries(1, &handle);
+    }
+
     void GPU::DrawArrays(int count) {
         glDrawArrays(GL_TRIANGLES, 0, count);
     }
 
-    struct LinesContext {
-        ArrayBuffer pointsBuffer;
-        Pipeline pipeline;
-    };
-
     struct LineVertex {
         glm::vec3 point;
         float width;
@@ -949,42 +1076,64 @@ namespace Raster {
         LineVertex() : point(glm::vec3(0)), width(1), color(glm::vec4(1)) {}
     };
 
-    void GPU::DrawLines(std::vector<glm::vec2> points, std::vector<glm::vec4> colors, float width, glm::vec2 viewportSize, float antialiasing) {
-        static ThreadUniqueValue<LinesContext> s_lineContext;
-        auto& lineContext = s_lineContext.Get();
-        if (!lineContext.pointsBuffer.handle) {
-            lineContext.pointsBuffer = GPU::GenerateBuffer(sizeof(LineVertex) * points.size() * 2, ArrayBufferType::ShaderStorageBuffer, ArrayBufferUsage::Dynamic);
+    // program pipelines are not shared between contexts, so every rendering thread gets its own
+    static Pipeline GetLinesPipeline() {
+        static ThreadUniqueValue<Pipeline> s_pipeline;
+        auto& pipeline = s_pipeline.Get();
+        if (!pipeline.handle) {
+            pipeline = GPU::GeneratePipeline(
+                GPU::GenerateShader(ShaderType::Vertex, "lines/shader"), 
+                GPU::GenerateShader(ShaderType::Fragment, "lines/shader"));
+        }
+        return pipeline;
+    }
+
+    void GPU::UpdateLineMesh(LineMesh& mesh, const std::vector<glm::vec2>& points, const std::vector<glm::vec4>& colors, float width) {
+        size_t requiredSize = sizeof(LineVertex) * std::max((size_t) 1, points.size());
+        if (mesh.vertices.handle && mesh.vertices.size < requiredSize) {
+            GPU::DestroyBuffer(mesh.vertices);
+            mesh.vertices = ArrayBuffer();
         }
-        if (lineContext.pointsBuffer.handle && lineContext.pointsBuffer.size < sizeof(LineVertex) * points.size() * 2) {
-            GPU::DestroyBuffer(lineContext.pointsBuffer);
-            lineContext.pointsBuffer = GPU::GenerateBuffer(sizeof(LineVertex) * points.size() * 2, ArrayBufferType::ShaderStorageBuffer, ArrayBufferUsage::Dynamic);
+        if (!mesh.vertices.handle) {
+            mesh.vertices = GPU::GenerateBuffer(requiredSize, ArrayBufferType::ShaderStorageBuffer, ArrayBufferUsage::Dynamic);
         }
 
-        std::vector<LineVertex> meshVertices;
+        std::vector<LineVertex> meshVertices(points.size());
         for (int i = 0; i < points.size(); i++) {
-            auto& point = points[i];
-            auto& color = colors[i];
-
-            LineVertex meshVertex;
-            meshVertex.color = color;
-            meshVertex.point = glm::vec3(point.x, point.y, 0);
+            auto& meshVertex = meshVertices[i];
+            meshVertex.color = colors[i];
+            meshVertex.point = glm::vec3(points[i].x, points[i].y, 0);
             meshVertex.width = width;
-            meshVertices.push_back(meshVertex);
         }
 
-        GPU::FillBuffer(lineContext.pointsBuffer, 0, sizeof(LineVertex) * meshVertices.size(), meshVertices.data());
+        if (!meshVertices.empty()) {
+            GPU::FillBuffer(mesh.vertices, 0, sizeof(LineVertex) * meshVertices.size(), meshVertices.data());
+        }
+        mesh.pointsCount = points.size();
+    }
+
+    void GPU::DrawLineMesh(LineMesh& mesh, glm::vec2 viewportSize, float antialiasing) {
+        if (!mesh.vertices.handle || mesh.pointsCount == 0) return;
+        auto pipeline = GetLinesPipeline();
+        GPU::BindPipeline(pipeline);
+        GPU::BindBufferBase(mesh.vertices, 0);
+        GPU::SetShaderUniform(pipeline.vertex, "u_viewport_size", viewportSize);
+        GPU::SetShaderUniform(pipeline.vertex, "u_aa_radius", glm::vec2(antialiasing));
+        GPU::DrawArrays(3 * mesh.pointsCount);
+    }
 
-        if (!lineContext.pipeline.handle) {
-            lineContext.pipeline = GPU::GeneratePipeline(
-                GPU::GenerateShader(ShaderType::Vertex, "lines/shader"), 
-                GPU::GenerateShader(ShaderType::Fragment, "lines/shader"));
+    void GPU::DestroyLineMesh(LineMesh& mesh) {
+        if (mesh.vertices.handle) {
+            GPU::DestroyBuffer(mesh.vertices);
         }
+        mesh = LineMesh();
+    }
 
-        GPU::BindPipeline(lineContext.pipeline);
-        GPU::BindBufferBase(lineContext.pointsBuffer, 0);
-        GPU::SetShaderUniform(lineContext.pipeline.vertex, "u_viewport_size", viewportSize);
-        GPU::SetShaderUniform(lineContext.pipeline.vertex, "u_aa_radius", glm::vec2(antialiasing));
-        GPU::DrawArrays(3 * points.size());
+    void GPU::DrawLines(const std::vector<glm::vec2>& points, const std::vector<glm::vec4>& colors, float width, glm::vec2 viewportSize, float antialiasing) {
+        static ThreadUniqueValue<LineMesh> s_lineMesh;
+        auto& lineMesh = s_lineMesh.Get();
+        UpdateLineMesh(lineMesh, points, colors, width);
+        DrawLineMesh(lineMesh, viewportSize, antialiasing);
     }
 
     void GPU::ReadPixels(int x, int y, int w, int h, int channels, TexturePrecision texturePrecision, void* data) {
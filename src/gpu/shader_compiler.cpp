@@ -0,0 +1,138 @@
+#include "gpu/shader_compiler.h"
+#include "common/profiler.h"
+#include <deque>
+
+namespace Raster {
+
+    struct ShaderCompilation {
+        ShaderType type;
+        // compiled from shaders/gl/ when code is empty
+        std::string name, code;
+        bool useBinaryCache;
+
+        bool ready;
+        std::optional<Shader> shader;
+        std::optional<std::string> error;
+    };
+
+    static std::mutex s_mutex;
+    static std::condition_variable s_condition;
+    static unordered_dense::map<uint64_t, std::shared_ptr<ShaderCompilation>> s_compilations;
+    static std::deque<std::shared_ptr<ShaderCompilation>> s_queue;
+    static std::thread s_compiler;
+    static bool s_running = false;
+    static int s_pendingCount = 0;
+    static void* s_context = nullptr;
+
+    static void Compile(ShaderCompilation& t_compilation) {
+        RASTER_PROFILE_ZONE("Shader Compilation");
+        try {
+            if (t_compilation.code.empty()) {
+                t_compilation.shader = GPU::GenerateShader(t_compilation.type, t_compilation.name, t_compilation.useBinaryCache);
+            } else {
+                t_compilation.shader = GPU::GenerateShaderFromSource(t_compilation.type, t_compilation.code, t_compilation.name, t_compilation.useBinaryCache);
+            }
+        } catch (std::exception& ex) {
+            t_compilation.error = ex.what();
+        }
+        t_compilation.code.clear();
+    }
+
+    static void CompilerLogic() {
+        GPU::SetCurrentContext(s_context);
+        Profiler::SetThreadName("Shader Compiler");
+
+        while (true) {
+            std::shared_ptr<ShaderCompilation> compilation;
+            {
+                std::unique_lock<std::mutex> lock(s_mutex);
+                s_condition.wait(lock, [] { return !s_running || !s_queue.empty(); });
+                if (!s_running) break;
+                compilation = s_queue.front();
+                s_queue.pop_front();
+            }
+
+            ShaderCompilation result = *compilation;
+            Compile(result);
+            // other contexts may only use the program once driver has finished linking it
+            GPU::Flush();
+
+            std::lock_guard<std::mutex> lock(s_mutex);
+            *compilation = result;
+            compilation->ready = true;
+            s_pendingCount--;
+        }
+    }
+
+    void ShaderCompiler::Initialize() {
+        RASTER_LOG("booting up shader compiler");
+        s_context = GPU::ReserveContext();
+        if (!s_context) return;
+        s_running = true;
+        s_compiler = std::thread(CompilerLogic);
+    }
+
+    void ShaderCompiler::Terminate() {
+        if (!s_running) return;
+        {
+            std::lock_guard<std::mutex> lock(s_mutex);
+            s_running = false;
+        }
+        s_condition.notify_all();
+        s_compiler.join();
+        GPU::DestroyContext(s_context);
+    }
+
+    static std::optional<Shader> Enqueue(uint64_t t_key, ShaderCompilation t_compilation) {
+        std::unique_lock<std::mutex> lock(s_mutex);
+        auto iterator = s_compilations.find(t_key);
+        if (iterator == s_compilations.end()) {
+            if (!s_running) {
+                // no background context, compile on the calling thread
+                lock.unlock();
+                Compile(t_compilation);
+                t_compilation.ready = true;
+                lock.lock();
+                iterator = s_compilations.insert({t_key, std::make_shared<ShaderCompilation>(t_compilation)}).first;
+            } else {
+                t_compilation.ready = false;
+                auto compilation = std::make_shared<ShaderCompilation>(t_compilation);
+                s_compilations[t_key] = compilation;
+                s_queue.push_back(compilation);
+                s_pendingCount++;
+                lock.unlock();
+                s_condition.notify_one();
+                return std::nullopt;
+            }
+        }
+
+        auto& compilation = *iterator->second;
+        if (!compilation.ready) return std::nullopt;
+        if (compilation.error) throw std::runtime_error(*compilation.error);
+        return compilation.shader;
+    }
+
+    std::optional<Shader> ShaderCompiler::Request(ShaderType t_type, std::string t_name, bool t_useBinaryCache) {
+        auto key = HashCombine(HashValue(t_type), HashCombine(HashBytes(t_name.data(), t_name.size()), HashValue(t_useBinaryCache)));
+        ShaderCompilation compilation;
+        compilation.type = t_type;
+        compilation.name = t_name;
+        compilation.useBinaryCache = t_useBinaryCache;
+        return Enqueue(key, compilation);
+    }
+
+    std::optional<Shader> ShaderCompiler::RequestSource(ShaderType t_type, std::string t_code, std::string t_cacheName) {
+        auto key = HashCombine(HashValue(t_type), HashCombine(HashBytes(t_code.data(), t_code.size()), HashBytes(t_cacheName.data(), t_cacheName.size())));
+        ShaderCompilation compilation;
+        compilation.type = t_type;
+        compilation.name = t_cacheName;
+        compilation.code = t_code;
+        compilation.useBinaryCache = !t_cacheName.empty();
+        return Enqueue(key, compilation);
+    }
+
+    int ShaderCompiler::GetPendingCount() {
+        std::lock_guard<std::mutex> lock(s_mutex);
+        return s_pendingCount;
+    }
+};
@@ -0,0 +1,199 @@
+#include "gpu/texture_cache.h"
+
+namespace Raster {
+
+    struct TextureCacheEntry {
+        std::optional<Texture> texture;
+        AsyncUploadInfoID uploadID;
+        TextureCacheTransform transform;
+        std::string colorSpace;
+        bool failed;
+        int references;
+        uint64_t lastUsed;
+        size_t bytes;
+
+        TextureCacheEntry() : uploadID(0), transform(TextureCacheTransform::None), failed(false), references(0), lastUsed(0), bytes(0) {}
+    };
+
+    static std::mutex s_cacheMutex;
+    static std::unordered_map<std::string, TextureCacheEntry> s_entries;
+    static uint64_t s_usageCounter = 0;
+    static uint64_t s_hits = 0, s_misses = 0, s_deduplicatedLoads = 0;
+    static size_t s_budget = 512 * 1024 * 1024;
+    // PollUploads() runs on both UI and rendering threads, program pipelines are not shared between their GPU contexts
+    static thread_local std::optional<Pipeline> s_gammaPipeline;
+
+    static size_t GetTextureBytes(Texture& t_texture) {
+        size_t channelBytes = 1;
+        if (t_texture.precision == TexturePrecision::Half) channelBytes = 2;
+        if (t_texture.precision == TexturePrecision::Full) channelBytes = 4;
+        // a third on top for mipmaps
+        return (size_t) t_texture.width * t_texture.height * t_texture.channels * channelBytes * 4 / 3;
+    }
+
+    TextureCacheHandle::~TextureCacheHandle() {
+        TextureCache::Release(key);
+    }
+
+    SharedTextureHandle TextureCache::Acquire(std::string t_path, int t_level, TextureCacheTransform t_transform) {
+        std::error_code error;
+        auto canonicalPath = std::filesystem::weakly_canonical(t_path, error);
+        if (error || !std::filesystem::is_regular_file(canonicalPath, error)) return nullptr;
+        auto modificationTime = std::filesystem::last_write_time(canonicalPath, error).time_since_epoch().count();
+        if (error) return nullptr;
+        auto fileSize = std::filesystem::file_size(canonicalPath, error);
+        if (error) return nullptr;
+
+        auto key = FormatString("%s|%lli|%llu|%i|%i", canonicalPath.string().c_str(), (long long) modificationTime, (unsigned long long) fileSize, t_level, static_cast<int>(t_transform));
+
+        RASTER_SYNCHRONIZED(s_cacheMutex);
+        auto entryIterator = s_entries.find(key);
+        if (entryIterator != s_entries.end()) {
+            auto& entry = entryIterator->second;
+            if (entry.texture) s_hits++;
+            else s_deduplicatedLoads++;
+            entry.references++;
+            entry.lastUsed = ++s_usageCounter;
+            return std::make_shared<TextureCacheHandle>(key);
+        }
+
+        s_misses++;
+        TextureCacheEntry entry;
+        entry.uploadID = AsyncUpload::GenerateTextureFromImagePath(canonicalPath.string(), t_level);
+        entry.transform = t_transform;
+        entry.references = 1;
+        entry.lastUsed = ++s_usageCounter;
+        s_entries[key] = entry;
+        return std::make_shared<TextureCacheHandle>(key);
+    }
+
+    std::optional<Texture> TextureCache::GetTexture(const SharedTextureHandle& t_handle) {
+        if (!t_handle) return std::nullopt;
+        PollUploads();
+        RASTER_SYNCHRONIZED(s_cacheMutex);
+        auto entryIterator = s_entries.find(t_handle->key);
+        if (entryIterator == s_entries.end()) return std::nullopt;
+        entryIterator->second.lastUsed = ++s_usageCounter;
+        return entryIterator->second.texture;
+    }
+
+    std::optional<std::string> TextureCache::GetColorSpace(const SharedTextureHandle& t_handle) {
+        if (!t_handle) return std::nullopt;
+        RASTER_SYNCHRONIZED(s_cacheMutex);
+        auto entryIterator = s_entries.find(t_handle->key);
+        if (entryIterator == s_entries.end() || !entryIterator->second.texture) return std::nullopt;
+        return entryIterator->second.colorSpace;
+    }
+
+    bool TextureCache::IsLoading(const SharedTextureHandle& t_handle) {
+        if (!t_handle) return false;
+        RASTER_SYNCHRONIZED(s_cacheMutex);
+        auto entryIterator = s_entries.find(t_handle->key);
+        if (entryIterator == s_entries.end()) return false;
+        return !entryIterator->second.texture && !entryIterator->second.failed;
+    }
+
+    void TextureCache::PollUploads() {
+        RASTER_SYNCHRONIZED(s_cacheMutex);
+        bool anyCompleted = false;
+        for (auto& pair : s_entries) {
+            auto& entry = pair.second;
+            if (!entry.uploadID || !AsyncUpload::IsUploadReady(entry.uploadID)) continue;
+            auto info = AsyncUpload::GetUpload(entry.uploadID);
+            AsyncUpload::DestroyUpload(entry.uploadID);
+            if (!info.texture.handle) {
+                entry.failed = true;
+                continue;
+            }
+            entry.texture = ApplyTransform(info.texture, entry.transform);
+            entry.colorSpace = info.colorSpace;
+            entry.bytes = GetTextureBytes(*entry.texture);
+            anyCompleted = true;
+        }
+        if (anyCompleted) EvictReleasedEntries();
+    }
+
+    void TextureCache::Release(const std::string& t_key) {
+        RASTER_SYNCHRONIZED(s_cacheMutex);
+        auto entryIterator = s_entries.find(t_key);
+        if (entryIterator == s_entries.end()) return;
+        auto& entry = entryIterator->second;
+        entry.references--;
+        if (entry.references <= 0 && entry.failed) {
+            s_entries.erase(entryIterator);
+            return;
+        }
+        EvictReleasedEntries();
+    }
+
+    void TextureCache::EvictReleasedEntries() {
+        // expects s_cacheMutex to be locked
+        size_t releasedBytes = 0;
+        std::vector<std::pair<uint64_t, std::string>> candidates;
+        for (auto& pair : s_entries) {
+            if (pair.second.references > 0 || !pair.second.texture) continue;
+            releasedBytes += pair.second.bytes;
+            candidates.push_back({pair.second.lastUsed, pair.first});
+        }
+        if (releasedBytes <= s_budget) return;
+
+        std::sort(candidates.begin(), candidates.end());
+        for (auto& candidate : candidates) {
+            if (releasedBytes <= s_budget) break;
+            auto& entry = s_entries[candidate.second];
+            releasedBytes -= entry.bytes;
+            // handles can be released from any thread, so destruction goes through the uploader's context
+            AsyncUpload::DestroyTexture(*entry.texture);
+            s_entries.erase(candidate.second);
+        }
+    }
+
+    TextureCacheStatistics TextureCache::GetStatistics() {
+        RASTER_SYNCHRONIZED(s_cacheMutex);
+        TextureCacheStatistics statistics = {};
+        statistics.hits = s_hits;
+        statistics.misses = s_misses;
+        statistics.deduplicatedLoads = s_deduplicatedLoads;
+        statistics.entriesCount = s_entries.size();
+        statistics.budgetBytes = s_budget;
+        for (auto& pair : s_entries) {
+            if (pair.second.references > 0) statistics.referencedBytes += pair.second.bytes;
+            else statistics.releasedBytes += pair.second.bytes;
+        }
+        return statistics;
+    }
+
+    void TextureCache::SetBudget(size_t t_bytes) {
+        RASTER_SYNCHRONIZED(s_cacheMutex);
+        s_budget = t_bytes;
+        EvictReleasedEntries();
+    }
+
+    Texture TextureCache::ApplyTransform(Texture t_texture, TextureCacheTransform t_transform) {
+        if (t_transform != TextureCacheTransform::ExrGammaCorrection) return t_texture;
+        if (!s_gammaPipeline.has_value()) {
+            s_gammaPipeline = GPU::GeneratePipeline(
+                GPU::s_basicShader,
+                GPU::GenerateShader(ShaderType::Fragment, "exr_gamma_correction/shader")
+            );
+        }
+
+        auto& pipeline = s_gammaPipeline.value();
+        Texture gammaTexture = GPU::GenerateTexture(t_texture.width, t_texture.height, t_texture.channels, t_texture.precision);
+        Framebuffer gammaFbo = GPU::GenerateFramebuffer(t_texture.width, t_texture.height, {gammaTexture});
+
+        GPU::BindFramebuffer(gammaFbo);
+        GPU::BindPipeline(pipeline);
+        GPU::ClearFramebuffer(0, 0, 0, 0);
+
+        GPU::SetShaderUniform(pipeline.fragment, "uResolution", glm::vec2(t_texture.width, t_texture.height));
+        GPU::BindTextureToShader(pipeline.fragment, "uTexture", t_texture, 0);
+
+        GPU::DrawArrays(3);
+
+        GPU::BindFramebuffer(std::nullopt);
+        GPU::DestroyTexture(t_texture);
+        GPU::DestroyFramebuffer(gammaFbo);
+        return gammaTexture;
+    }
+};
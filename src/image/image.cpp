@@ -1,6 +1,7 @@
 #define OIIO_STATIC_BUILD
 
 #include <OpenImageIO/imageio.h>
+#include <OpenImageIO/imagecache.h>
 #include "image/image.h"
 
 #include <OpenColorIO/OpenColorIO.h>
@@ -10,6 +11,7 @@ namespace Raster {
     Image::Image() {
         this->width = this->height = 0;
         this->channels = 0;
+        this->level = 0;
         this->precision = ImagePrecision::Usual;
     }
 
@@ -23,6 +25,31 @@ namespace Raster {
         }
     }
 
+    static OIIO::TypeDesc GetTargetTypeDesc(const OIIO::ImageSpec& t_spec) {
+        OIIO::TypeDesc targetTypeDesc = OIIO::TypeDesc::UINT8;
+        if (t_spec.format.elementsize() == 2) targetTypeDesc = OIIO::TypeDesc::HALF;
+        if (t_spec.format.elementsize() == 4) targetTypeDesc = OIIO::TypeDesc::FLOAT;
+        return targetTypeDesc;
+    }
+
+    static ImagePrecision GetImagePrecision(OIIO::TypeDesc t_typeDesc) {
+        if (t_typeDesc == OIIO::TypeDesc::HALF) return ImagePrecision::Half;
+        if (t_typeDesc == OIIO::TypeDesc::FLOAT) return ImagePrecision::Full;
+        return ImagePrecision::Usual;
+    }
+
+    // shared between all loaders, keeps decoded tiles of recently used files within a fixed memory budget
+    static auto GetImageCache() {
+        static auto s_cache = []() {
+            auto cache = OIIO::ImageCache::create(true);
+            cache->attribute("max_memory_MB", 512.0f);
+            cache->attribute("autotile", 256);
+            cache->attribute("autoscanline", 1);
+            return cache;
+        }();
+        return s_cache;
+    }
+
     std::optional<Image> ImageLoader::Load(std::string t_path) {
         auto input = OIIO::ImageInput::open(t_path);
         if (!input) {
@@ -31,25 +58,16 @@ namespace Raster {
         }
         const OIIO::ImageSpec& spec = input->spec();
 
-        OIIO::TypeDesc targetTypeDesc = OIIO::TypeDesc::UINT8;
-        if (spec.format.elementsize() == 2) targetTypeDesc = OIIO::TypeDesc::HALF;
-        if (spec.format.elementsize() == 4) targetTypeDesc = OIIO::TypeDesc::FLOAT;
+        OIIO::TypeDesc targetTypeDesc = GetTargetTypeDesc(spec);
         std::vector<uint8_t> data(spec.width * spec.height * spec.nchannels * targetTypeDesc.elementsize());
         input->read_image(0, 0, 0, spec.nchannels, targetTypeDesc, data.data());
 
         Image result;
-        result.precision = ImagePrecision::Usual;
-        if (targetTypeDesc == OIIO::TypeDesc::UINT8) {
-            result.precision = ImagePrecision::Usual;
-        } else if (targetTypeDesc == OIIO::TypeDesc::HALF) {
-            result.precision = ImagePrecision::Half;
-        } else if (targetTypeDesc == OIIO::TypeDesc::FLOAT) {
-            result.precision = ImagePrecision::Full;
-        }
+        result.precision = GetImagePrecision(targetTypeDesc);
         result.channels = spec.nchannels;
         result.width = spec.width;
         result.height = spec.height;
-        result.data = data;
+        result.data = std::move(data);
         result.colorSpace = GetColorSpaceFromFile(t_path);
         if (result.colorSpace.empty()) {
             result.colorSpace = spec.extra_attribs.get_string("oiio:ColorSpace", "scene_linear");
@@ -59,6 +77,126 @@ namespace Raster {
         return result;
     }
 
+    std::optional<ImageDescription> ImageLoader::Describe(std::string t_path) {
+        auto cache = GetImageCache();
+        OIIO::ustring path(t_path);
+        const OIIO::ImageSpec* spec = cache->imagespec(path, 0, 0);
+        if (!spec) {
+            RASTER_LOG(cache->geterror());
+            return std::nullopt;
+        }
+
+        ImageDescription description;
+        description.precision = GetImagePrecision(GetTargetTypeDesc(*spec));
+        description.width = spec->width;
+        description.height = spec->height;
+        description.channels = spec->nchannels;
+        description.mipLevels = 1;
+        cache->get_image_info(path, 0, 0, OIIO::ustring("miplevels"), OIIO::TypeInt, &description.mipLevels);
+        description.mipLevels = std::max(description.mipLevels, 1);
+        description.colorSpace = GetColorSpaceFromFile(t_path);
+        if (description.colorSpace.empty()) {
+            description.colorSpace = spec->extra_attribs.get_string("oiio:ColorSpace", "scene_linear");
+        }
+        return description;
+    }
+
+    std::optional<Image> ImageLoader::LoadRegion(std::string t_path, int t_level, uint32_t t_y, uint32_t t_rows) {
+        auto descriptionCandidate = Describe(t_path);
+        if (!descriptionCandidate) return std::nullopt;
+        auto& description = *descriptionCandidate;
+
+        auto cache = GetImageCache();
+        OIIO::ustring path(t_path);
+        int baseLevel = std::clamp(t_level, 0, description.mipLevels - 1);
+        const OIIO::ImageSpec* spec = cache->imagespec(path, 0, baseLevel);
+        if (!spec) {
+            RASTER_LOG(cache->geterror());
+            return std::nullopt;
+        }
+
+        auto levelSize = GetLevelSize(description, t_level);
+        if (t_y >= levelSize.y) return std::nullopt;
+        uint32_t rows = std::min(t_rows, levelSize.y - t_y);
+        int channels = spec->nchannels;
+        OIIO::TypeDesc targetTypeDesc = GetTargetTypeDesc(*spec);
+
+        Image result;
+        result.precision = GetImagePrecision(targetTypeDesc);
+        result.channels = channels;
+        result.width = levelSize.x;
+        result.height = rows;
+        result.level = t_level;
+        result.colorSpace = description.colorSpace;
+        result.data.resize((size_t) levelSize.x * rows * channels * targetTypeDesc.elementsize());
+
+        int factor = 1 << (t_level - baseLevel);
+        if (factor == 1) {
+            if (!cache->get_pixels(path, 0, baseLevel, spec->x, spec->x + spec->width, spec->y + t_y, spec->y + t_y + rows, spec->z, spec->z + 1, targetTypeDesc, result.data.data())) {
+                RASTER_LOG(cache->geterror());
+                return std::nullopt;
+            }
+            return result;
+        }
+
+        // box filtering factor x factor blocks of the closest stored level, one output row at a time
+        std::vector<float> band((size_t) spec->width * factor * channels);
+        std::vector<float> filtered((size_t) levelSize.x * rows * channels, 0.0f);
+        for (uint32_t row = 0; row < rows; row++) {
+            int bandBegin = (t_y + row) * factor;
+            int bandEnd = std::min(bandBegin + factor, spec->height);
+            if (bandBegin >= bandEnd) continue;
+            if (!cache->get_pixels(path, 0, baseLevel, spec->x, spec->x + spec->width, spec->y + bandBegin, spec->y + bandEnd, spec->z, spec->z + 1, OIIO::TypeDesc::FLOAT, band.data())) {
+                RASTER_LOG(cache->geterror());
+                return std::nullopt;
+            }
+            float* target = filtered.data() + (size_t) row * levelSize.x * channels;
+            for (uint32_t x = 0; x < levelSize.x; x++) {
+                int blockBegin = x * factor;
+                int blockEnd = std::min(blockBegin + factor, spec->width);
+                int samplesCount = std::max((blockEnd - blockBegin) * (bandEnd - bandBegin), 1);
+                for (int by = 0; by < bandEnd - bandBegin; by++) {
+                    const float* source = band.data() + ((size_t) by * spec->width + blockBegin) * channels;
+                    for (int bx = blockBegin; bx < blockEnd; bx++) {
+                        for (int c = 0; c < channels; c++) {
+                            target[x * channels + c] += *source++;
+                        }
+                    }
+                }
+                for (int c = 0; c < channels; c++) {
+                    target[x * channels + c] /= samplesCount;
+                }
+            }
+        }
+        OIIO::convert_pixel_values(OIIO::TypeDesc::FLOAT, filtered.data(), targetTypeDesc, result.data.data(), filtered.size());
+        return result;
+    }
+
+    std::optional<Image> ImageLoader::LoadLevel(std::string t_path, int t_level) {
+        return LoadRegion(t_path, t_level, 0, UINT32_MAX);
+    }
+
+    int ImageLoader::GetLevelForDimension(const ImageDescription& t_description, uint32_t t_maxDimension) {
+        uint32_t largestSide = std::max(t_description.width, t_description.height);
+        int level = 0;
+        while (level < 16 && (largestSide >> (level + 1)) >= std::max(t_maxDimension, 1u)) {
+            level++;
+        }
+        return level;
+    }
+
+    glm::uvec2 ImageLoader::GetLevelSize(const ImageDescription& t_description, int t_level) {
+        return glm::uvec2(std::max(t_description.width >> t_level, 1u), std::max(t_description.height >> t_level, 1u));
+    }
+
+    void ImageLoader::SetCacheMemoryBudget(float t_megabytes) {
+        GetImageCache()->attribute("max_memory_MB", t_megabytes);
+    }
+
+    void ImageLoader::ReleaseFile(std::string t_path) {
+        GetImageCache()->invalidate(OIIO::ustring(t_path));
+    }
+
     static std::optional<std::string> s_imageWriterError = std::nullopt;
 
     bool ImageWriter::Write(std::string t_path, Image& t_image) {
@@ -146,6 +284,17 @@ namespace Raster {
         this->m_initialized = true;
     }
 
+    AsyncImageLoader::AsyncImageLoader(std::string t_path, uint32_t t_maxDimension) {
+        this->m_future = std::async(std::launch::async, [t_path, t_maxDimension] {
+            auto descriptionCandidate = ImageLoader::Describe(t_path);
+            if (!descriptionCandidate) return std::optional<std::shared_ptr<Image>>(std::nullopt);
+            auto candidate = ImageLoader::LoadLevel(t_path, ImageLoader::GetLevelForDimension(*descriptionCandidate, t_maxDimension));
+            if (!candidate.has_value()) return std::optional<std::shared_ptr<Image>>(std::nullopt);
+            return std::optional(std::make_shared<Image>(std::move(*candidate)));
+        });
+        this->m_initialized = true;
+    }
+
     std::optional<std::shared_ptr<Image>> AsyncImageLoader::Get() {
         return m_future.get();
     }
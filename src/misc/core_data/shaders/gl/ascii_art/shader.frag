@@ -7,6 +7,7 @@ precision highp float;
 layout(location = 0) out vec4 gColor;
 
 uniform vec2 uResolution;
+uniform float uPreviewScale;
 
 uniform bool uGrayscale;
 uniform sampler2D uColor;
@@ -26,8 +27,10 @@ float character(int n, vec2 p)
 }
 
 void main()  {
+	// character cells are 8 pixels wide at full resolution
+	float cellSize = 8.0 * uPreviewScale;
 	vec2 pix = gl_FragCoord.xy;
-	vec3 col = texture(uColor, floor(pix/8.0)*8.0/uResolution.xy).rgb;	
+	vec3 col = texture(uColor, floor(pix/cellSize)*cellSize/uResolution.xy).rgb;	
 	
 	float gray = 0.3 * col.r + 0.59 * col.g + 0.11 * col.b;
 	    
@@ -42,7 +45,7 @@ void main()  {
 	if (gray > 0.7) n = 13195790; // @
 	if (gray > 0.8) n = 11512810; // #
     
-	vec2 p = mod(pix/4.0, 2.0) - vec2(1.0);
+	vec2 p = mod(pix/(cellSize/2.0), 2.0) - vec2(1.0);
     
 	if (uGrayscale)	col = vec3(character(n, p));
 	else col = col*character(n, p);
@@ -8,7 +8,12 @@ layout(location = 0) out vec4 gColor;
 
 uniform vec2 uResolution;
 
-uniform mat3 uKernel;
+// R32F texture, one texel per kernel value
+uniform sampler2D uKernel;
+uniform vec2 uKernelSize;
+uniform float uMultiplier;
+// distance between taps in pixels, below 1 when rendering in reduced preview resolution
+uniform float uTapSpacing;
 uniform sampler2D uBase;
 
 void main()
@@ -17,15 +22,18 @@ void main()
     vec2 uv = gl_FragCoord.xy / uResolution.xy;
 
     vec4 color = vec4(0);
-    
-    const float direction[3] = float[3](-1.0, 0.0, 1.0);    
-    for (int x = 0; x < 3; x++)
+
+    ivec2 kernelSize = ivec2(uKernelSize);
+    ivec2 center = kernelSize / 2;
+    for (int y = 0; y < kernelSize.y; y++)
     {
-        for (int y = 0; y < 3; y++)
+        for (int x = 0; x < kernelSize.x; x++)
         {
-            vec2 offset = vec2(direction[x], direction[y]) / uResolution.xy;
-            color += texture(uBase, uv+offset) * uKernel[x][y];
+            float weight = texelFetch(uKernel, ivec2(x, y), 0).r;
+            if (weight == 0.0) continue;
+            vec2 offset = vec2(ivec2(x, y) - center) * uTapSpacing / uResolution.xy;
+            color += texture(uBase, uv + offset) * weight;
         }
     }
-    gColor = color;
-}
\ No newline at end of file
+    gColor = color * uMultiplier;
+}
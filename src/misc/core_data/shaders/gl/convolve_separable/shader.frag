@@ -0,0 +1,39 @@
+#version 310 es
+
+#ifdef GL_ES
+precision highp float;
+#endif
+
+#define MAX_TAPS 128
+
+layout(location = 0) out vec4 gColor;
+
+uniform vec2 uResolution;
+
+uniform float uWeights[MAX_TAPS];
+uniform int uTaps;
+// (1, 0) for horizontal pass, (0, 1) for vertical pass, scaled by tap spacing in reduced preview resolution
+uniform vec2 uDirection;
+uniform sampler2D uBase;
+
+// result of previous rank-1 terms, added to this pass if uAccumulate is set
+uniform sampler2D uAccumulator;
+uniform int uAccumulate;
+
+void main()
+{
+    // Normalized pixel coordinates (from 0 to 1)
+    vec2 uv = gl_FragCoord.xy / uResolution.xy;
+
+    vec4 color = vec4(0);
+
+    int center = uTaps / 2;
+    for (int i = 0; i < uTaps; i++)
+    {
+        if (uWeights[i] == 0.0) continue;
+        vec2 offset = uDirection * float(i - center) / uResolution.xy;
+        color += texture(uBase, uv + offset) * uWeights[i];
+    }
+    if (uAccumulate != 0) color += texelFetch(uAccumulator, ivec2(gl_FragCoord.xy), 0);
+    gColor = color;
+}
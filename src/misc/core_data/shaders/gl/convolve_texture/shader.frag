@@ -0,0 +1,43 @@
+#version 310 es
+
+#ifdef GL_ES
+precision highp float;
+#endif
+
+layout(location = 0) out vec4 gColor;
+
+uniform vec2 uResolution;
+
+// red channel of uKernel is resampled into uKernelSize taps
+uniform sampler2D uKernel;
+uniform vec2 uKernelSize;
+uniform float uMultiplier;
+// distance between taps in pixels, below 1 when rendering in reduced preview resolution
+uniform float uTapSpacing;
+uniform int uNormalize;
+uniform sampler2D uBase;
+
+void main()
+{
+    // Normalized pixel coordinates (from 0 to 1)
+    vec2 uv = gl_FragCoord.xy / uResolution.xy;
+
+    vec4 color = vec4(0);
+    float weightSum = 0.0;
+
+    ivec2 kernelSize = ivec2(uKernelSize);
+    ivec2 center = kernelSize / 2;
+    for (int y = 0; y < kernelSize.y; y++)
+    {
+        for (int x = 0; x < kernelSize.x; x++)
+        {
+            float weight = texture(uKernel, (vec2(x, y) + 0.5) / uKernelSize).r;
+            if (weight == 0.0) continue;
+            vec2 offset = vec2(ivec2(x, y) - center) * uTapSpacing / uResolution.xy;
+            color += texture(uBase, uv + offset) * weight;
+            weightSum += weight;
+        }
+    }
+    if (uNormalize != 0 && weightSum != 0.0) color /= weightSum;
+    gColor = color * uMultiplier;
+}
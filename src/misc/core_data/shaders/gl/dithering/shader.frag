@@ -9,6 +9,7 @@ layout(location = 1) out vec4 gUV;
 
 uniform vec2 uResolution;
 uniform float uSize;
+uniform float uPreviewScale;
 uniform sampler2D uColor;
 uniform bool uDitherTextureAvailable;
 uniform sampler2D uDitherTexture;
@@ -38,11 +39,13 @@ void main() {
     
     // get some noise
     float noise = 0.0;
+    // dither pattern cells are 8 pixels wide at full resolution
+    vec2 cellPosition = gl_FragCoord.xy / (8.0 * uPreviewScale);
 
     if (uDitherTextureAvailable) {
-        noise = texture(uDitherTexture, gl_FragCoord.xy / 8.0).r;
+        noise = texture(uDitherTexture, cellPosition).r;
     } else {
-        noise = GetBayerFromCoordLevel(gl_FragCoord.xy / 8.0);
+        noise = GetBayerFromCoordLevel(cellPosition);
     }
 
     col += (noise-0.5)/uSize*2.0;
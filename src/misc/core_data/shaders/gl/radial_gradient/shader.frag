@@ -4,8 +4,6 @@
 precision highp float;
 #endif
 
-#define MAGIC_SMOOTHER 0.0618
-
 // This shader was taken from https://www.shadertoy.com/view/NtScz1
 // And modified in order to be compatible with Raster
 // Many thanks to https://www.shadertoy.com/user/zsjasper !
@@ -24,32 +22,12 @@ uniform sampler2D uColorTexture;
 uniform sampler2D uUVTexture;
 uniform bool uScreenSpaceRendering;
 
-struct GradientStop {
-    float percentage;
-    vec4 color;
-};
-
-layout(std430, binding = 0) readonly buffer GradientSSBO {
-    float gradientData[];
-};
-
-GradientStop getStop(int index) {
-    GradientStop result;
-    int gradientIndex = 1 + index * 5;
-    result.percentage = gradientData[gradientIndex];
-    result.color = vec4(gradientData[gradientIndex + 1], gradientData[gradientIndex + 2], gradientData[gradientIndex + 3], gradientData[gradientIndex + 4]);
-    return result;
-}
+uniform sampler2D uGradient;
 
 vec4 createGradient(in float y) {
-    vec4 color = getStop(0).color;
-    int iGradientsCount = int(gradientData[0]);
-    for (int i = 1; i < iGradientsCount; i++) {
-        GradientStop currentStop = getStop(i);
-        GradientStop previousStop = getStop(i - 1);
-        color = mix(color, currentStop.color, smoothstep(previousStop.percentage, currentStop.percentage + MAGIC_SMOOTHER, y + MAGIC_SMOOTHER)); 
-    }
-    return color;
+    // baked gradient, texel centers hold colors at evenly spaced percentages
+    float resolution = float(textureSize(uGradient, 0).x);
+    return texture(uGradient, vec2((clamp(y, 0.0, 1.0) * (resolution - 1.0) + 0.5) / resolution, 0.5));
 }
 
 void main() {
@@ -53,11 +53,10 @@ namespace Raster {
             if (!RASTER_GET_CONTEXT_VALUE(t_contextData, "WAVEFORM_PASS", bool)) {
                 if (busCandidate.has_value()) {
                     auto& bus = busCandidate.value();
+                    // compositions may be mixed concurrently by the task scheduler
+                    RASTER_SYNCHRONIZED(*project.audioBusesMutex);
                     bus->ValidateBuffers();
-                    auto rawSamples = samples.samples;
-                    for (int i = 0; i < AudioInfo::s_periodSize * AudioInfo::s_channels; i++) {
-                        bus->samples[i] += rawSamples[i];
-                    }
+                    AudioBus::AccumulateSamples(bus->samples.data(), samples.samples, AudioInfo::s_periodSize * AudioInfo::s_channels);
                 }
             } else if (samples.samples) {
                 WaveformManager::PushWaveformSamples(std::make_shared<std::vector<float>>(samples.samples, samples.samples + AudioInfo::s_periodSize * AudioInfo::s_channels));
@@ -21,6 +21,10 @@
    #include <cmath>
 #endif
 #include <algorithm>
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+   #include <xmmintrin.h>
+   #define REVERB_COMBS_SSE
+#endif
 using std::min;
 using std::max;
 
@@ -41,6 +45,7 @@ using std::max;
 #define lsx_zalloc(var, n) var = (float *)calloc(n, sizeof(*var))
 #define filter_advance(p) if (--(p)->ptr < (p)->buffer) (p)->ptr += (p)->size
 #define filter_delete(p) free((p)->buffer)
+#define REVERB_SMOOTHING_MS 20
 
 typedef struct {
    char * data;
@@ -244,16 +249,46 @@ static void filter_array_create(filter_array_t * p, double rate,
    }
 }
 
+// feedback, hf_damping and gain move linearly by their *_step values after every sample
 static void filter_array_process(filter_array_t * p,
       size_t length, float const * input, float * output,
-      float const * feedback, float const * hf_damping, float const * gain)
+      float feedback, float hf_damping, float gain,
+      float feedback_step, float hf_damping_step, float gain_step)
 {
+#ifdef REVERB_COMBS_SSE
+   /* the 8 parallel combs run as two 4-wide vectors, only their delay line
+    * reads and writes stay scalar. stores live in registers for the whole block */
+   static_assert(array_length(comb_lengths) == 8, "comb bank is processed as two SSE vectors");
+   float combs[8];
+   size_t c;
+   for (c = 0; c < 8; ++c) combs[c] = p->comb[c].store;
+   __m128 store_lo = _mm_loadu_ps(combs), store_hi = _mm_loadu_ps(combs + 4);
+#endif
    while (length--) {
       float out = 0, in = *input++;
-
-      size_t i = array_length(comb_lengths) - 1;
-      do out += comb_process(p->comb + i, &in, feedback, hf_damping);
+      size_t i;
+
+#ifdef REVERB_COMBS_SSE
+      for (c = 0; c < 8; ++c) combs[c] = *p->comb[c].ptr;
+      __m128 output_lo = _mm_loadu_ps(combs), output_hi = _mm_loadu_ps(combs + 4);
+      __m128 damping = _mm_set1_ps(hf_damping), gain_feedback = _mm_set1_ps(feedback), in_vector = _mm_set1_ps(in);
+      store_lo = _mm_add_ps(output_lo, _mm_mul_ps(_mm_sub_ps(store_lo, output_lo), damping));
+      store_hi = _mm_add_ps(output_hi, _mm_mul_ps(_mm_sub_ps(store_hi, output_hi), damping));
+      _mm_storeu_ps(combs, _mm_add_ps(in_vector, _mm_mul_ps(store_lo, gain_feedback)));
+      _mm_storeu_ps(combs + 4, _mm_add_ps(in_vector, _mm_mul_ps(store_hi, gain_feedback)));
+      for (c = 0; c < 8; ++c) {
+         *p->comb[c].ptr = combs[c];
+         filter_advance(p->comb + c);
+      }
+      __m128 sum = _mm_add_ps(output_lo, output_hi);
+      sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+      sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 1));
+      out = _mm_cvtss_f32(sum);
+#else
+      i = array_length(comb_lengths) - 1;
+      do out += comb_process(p->comb + i, &in, &feedback, &hf_damping);
       while (i--);
+#endif
 
       i = array_length(allpass_lengths) - 1;
       do out = allpass_process(p->allpass + i, &out);
@@ -261,8 +296,17 @@ static void filter_array_process(filter_array_t * p,
 
       out = one_pole_process(&p->one_pole[0], out);
       out = one_pole_process(&p->one_pole[1], out);
-      *output++ = out * *gain;
+      *output++ = out * gain;
+
+      feedback += feedback_step;
+      hf_damping += hf_damping_step;
+      gain += gain_step;
    }
+#ifdef REVERB_COMBS_SSE
+   _mm_storeu_ps(combs, store_lo);
+   _mm_storeu_ps(combs + 4, store_hi);
+   for (c = 0; c < 8; ++c) p->comb[c].store = combs[c];
+#endif
 }
 
 static void filter_array_delete(filter_array_t * p)
@@ -279,6 +323,13 @@ typedef struct {
    float feedback;
    float hf_damping;
    float gain;
+   /* values reached after ramp_remaining samples */
+   float feedback_target;
+   float hf_damping_target;
+   float gain_target;
+   size_t ramp_remaining;
+   size_t ramp_length;
+   size_t pre_delay;
    fifo_t input_fifo;
    filter_array_t chan[2];
    float * out[2];
@@ -415,6 +466,8 @@ static void reverb_allocate(reverb_t* p, double sample_rate_Hz, size_t buffer_si
 
 // Some of the params can be set without having to re-init the input fifo
 // or the comb/allpass filters.
+// feedback, damping and gain are not applied immediately, they are ramped
+// over REVERB_SMOOTHING_MS so automated parameters don't produce zipper noise.
 static void reverb_set_simple_params
 (
    reverb_t* p,
@@ -430,9 +483,11 @@ static void reverb_set_simple_params
    double a = -1 / log(1 - /**/.3 /**/);           /* Set minimum feedback */
    double b = 100 / (log(1 - /**/.98/**/) * a + 1);  /* Set maximum feedback */
 
-   p->feedback = 1 - exp((reverberance - b) / (a * b));
-   p->hf_damping = hf_damping / 100 * .3 + .2;
-   p->gain = dB_to_linear(wet_gain_dB) * .015;
+   p->feedback_target = 1 - exp((reverberance - b) / (a * b));
+   p->hf_damping_target = hf_damping / 100 * .3 + .2;
+   p->gain_target = dB_to_linear(wet_gain_dB) * .015;
+   p->ramp_length = (size_t)(REVERB_SMOOTHING_MS / 1000. * sample_rate_Hz + .5);
+   p->ramp_remaining = p->ramp_length;
 
 
    // LP-HP Filters
@@ -475,6 +530,37 @@ static void reverb_init
    // Remember if stereo depth was set to 0, so we do not have to process twice
    p->initializedWithZeroDepth = (stereo_depth == 0.0);
 
+   p->pre_delay = delay;
+
+   // nothing to smooth right after initialization
+   p->feedback = p->feedback_target;
+   p->hf_damping = p->hf_damping_target;
+   p->gain = p->gain_target;
+   p->ramp_remaining = 0;
+}
+
+// Changes pre-delay keeping the comb/allpass filters and the pending input.
+// Longer delays insert silence after pending input, shorter delays drop the oldest samples.
+static void reverb_set_pre_delay(reverb_t* p, double sample_rate_Hz, double pre_delay_ms)
+{
+   size_t delay = pre_delay_ms / 1000 * sample_rate_Hz + .5;
+   if (delay > p->pre_delay)
+      memset(fifo_write(&p->input_fifo, delay - p->pre_delay, 0), 0, (delay - p->pre_delay) * sizeof(float));
+   else if (delay < p->pre_delay)
+      fifo_read(&p->input_fifo, p->pre_delay - delay, NULL);
+   p->pre_delay = delay;
+}
+
+// Room scale and stereo depth define delay lengths, so only these touch filter buffers.
+static void reverb_set_room(reverb_t* p, double sample_rate_Hz, double room_scale, double stereo_depth)
+{
+   double scale = room_scale / 100 * .9 + .1;
+   double depth = stereo_depth / 100;
+   for (size_t i = 0; i <= ceil(depth); ++i)
+   {
+      filter_array_init(p->chan + i, sample_rate_Hz, scale, i * depth);
+   }
+   p->initializedWithZeroDepth = (stereo_depth == 0.0);
 }
 
 
@@ -495,12 +581,36 @@ static void reverb_create(reverb_t * p, double sample_rate_Hz,
    reverb_init(p, sample_rate_Hz, wet_gain_dB, room_scale, reverberance, hf_damping, pre_delay_ms, stereo_depth, tone_low, tone_high);
 }
 
-static void reverb_process(reverb_t * p, size_t length)
+static void reverb_process_segment(reverb_t * p, size_t offset, size_t length,
+      float feedback_step, float hf_damping_step, float gain_step)
 {
-   filter_array_process(p->chan, length, (float *) fifo_read_ptr(&p->input_fifo), p->out[0], &p->feedback, &p->hf_damping, &p->gain);
+   float * input = (float *) fifo_read_ptr(&p->input_fifo) + offset;
+   filter_array_process(p->chan, length, input, p->out[0] + offset, p->feedback, p->hf_damping, p->gain, feedback_step, hf_damping_step, gain_step);
 
    if (!p->initializedWithZeroDepth)
-      filter_array_process(p->chan + 1, length, (float*)fifo_read_ptr(&p->input_fifo), p->out[1], &p->feedback, &p->hf_damping, &p->gain);
+      filter_array_process(p->chan + 1, length, input, p->out[1] + offset, p->feedback, p->hf_damping, p->gain, feedback_step, hf_damping_step, gain_step);
+
+   p->feedback += feedback_step * length;
+   p->hf_damping += hf_damping_step * length;
+   p->gain += gain_step * length;
+}
+
+static void reverb_process(reverb_t * p, size_t length)
+{
+   size_t ramped = min(length, p->ramp_remaining);
+   if (ramped > 0) {
+      float n = (float) p->ramp_remaining;
+      reverb_process_segment(p, 0, ramped,
+         (p->feedback_target - p->feedback) / n, (p->hf_damping_target - p->hf_damping) / n, (p->gain_target - p->gain) / n);
+      p->ramp_remaining -= ramped;
+      if (p->ramp_remaining == 0) {
+         p->feedback = p->feedback_target;
+         p->hf_damping = p->hf_damping_target;
+         p->gain = p->gain_target;
+      }
+   }
+   if (ramped < length)
+      reverb_process_segment(p, ramped, length - ramped, 0, 0, 0);
 
    fifo_read(&p->input_fifo, length, NULL);
 }
@@ -5,8 +5,52 @@
 
 #define REVERB_BLOCK_SIZE 16384
 
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+    #include <xmmintrin.h>
+    #define RASTER_REVERB_SSE
+#endif
+
 namespace Raster {
 
+    static void DeinterleaveStereo(const float* t_input, float* t_left, float* t_right, int t_frames) {
+        int i = 0;
+#ifdef RASTER_REVERB_SSE
+        for (; i + 4 <= t_frames; i += 4) {
+            __m128 a = _mm_loadu_ps(t_input + i * 2);
+            __m128 b = _mm_loadu_ps(t_input + i * 2 + 4);
+            _mm_storeu_ps(t_left + i, _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0)));
+            _mm_storeu_ps(t_right + i, _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1)));
+        }
+#endif
+        for (; i < t_frames; i++) {
+            t_left[i] = t_input[i * 2];
+            t_right[i] = t_input[i * 2 + 1];
+        }
+    }
+
+    // both mono reverbs produce a stereo pair, each output channel gets the average of matching wet signals
+    static void MixStereo(float* t_output, const float* t_dryLeft, const float* t_dryRight,
+                          const float* t_wetLeft0, const float* t_wetRight0, const float* t_wetLeft1, const float* t_wetRight1,
+                          float t_dryMultiplier, int t_frames) {
+        int i = 0;
+#ifdef RASTER_REVERB_SSE
+        __m128 dry = _mm_set1_ps(t_dryMultiplier);
+        __m128 half = _mm_set1_ps(0.5f);
+        for (; i + 4 <= t_frames; i += 4) {
+            __m128 left = _mm_add_ps(_mm_mul_ps(dry, _mm_loadu_ps(t_dryLeft + i)),
+                _mm_mul_ps(half, _mm_add_ps(_mm_loadu_ps(t_wetLeft0 + i), _mm_loadu_ps(t_wetRight0 + i))));
+            __m128 right = _mm_add_ps(_mm_mul_ps(dry, _mm_loadu_ps(t_dryRight + i)),
+                _mm_mul_ps(half, _mm_add_ps(_mm_loadu_ps(t_wetLeft1 + i), _mm_loadu_ps(t_wetRight1 + i))));
+            _mm_storeu_ps(t_output + i * 2, _mm_unpacklo_ps(left, right));
+            _mm_storeu_ps(t_output + i * 2 + 4, _mm_unpackhi_ps(left, right));
+        }
+#endif
+        for (; i < t_frames; i++) {
+            t_output[i * 2] = t_dryMultiplier * t_dryLeft[i] + 0.5f * (t_wetLeft0[i] + t_wetRight0[i]);
+            t_output[i * 2 + 1] = t_dryMultiplier * t_dryRight[i] + 0.5f * (t_wetLeft1[i] + t_wetRight1[i]);
+        }
+    }
+
     ReverbPrivate::ReverbPrivate() {
         this->initialized = false;
         this->wet = std::vector<float*>(2);
@@ -100,63 +144,72 @@ namespace Raster {
                 }
             }
 
-            // making sure reverbs are up-to-date
+            // making sure reverbs are up-to-date.
+            // gains, damping and tone are smoothed inside the reverb, only delay lengths touch filter state
             for (int channel = 0; channel < AudioInfo::s_channels; channel++) {
                 auto& reverb = reverbBuffer.m_reverbs[channel];
-                if (reverb->initialized) {
-                    auto& r = reverb->reverb;
-                    if (  reverb->wetGain != wetGain || reverb->roomSize != roomSize
-                       || reverb->reverberance != reverberance || reverb->hfDamping != hfDamping
-                       || reverb->preDelay != preDelay || reverb->stereoWidth != stereoWidth
-                       || reverb->toneLow != toneLow || reverb->toneHigh != toneHigh) {
-                        reverb_init(&r, AudioInfo::s_sampleRate, wetGain, roomSize, reverberance, hfDamping, preDelay, stereoWidth, toneLow, toneHigh);
-                        
-                        reverb->wetGain = wetGain; reverb->roomSize = roomSize;
-                        reverb->reverberance = reverberance; reverb->hfDamping = hfDamping;
-                        reverb->preDelay = preDelay; reverb->stereoWidth = stereoWidth;
-                        reverb->toneLow = toneLow; reverb->toneHigh = toneHigh;
-                    }
+                if (!reverb->initialized) continue;
+                auto& r = reverb->reverb;
+                if (  reverb->wetGain != wetGain || reverb->reverberance != reverberance
+                   || reverb->hfDamping != hfDamping || reverb->toneLow != toneLow || reverb->toneHigh != toneHigh) {
+                    reverb_set_simple_params(&r, AudioInfo::s_sampleRate, wetGain, reverberance, hfDamping, toneLow, toneHigh);
+                    reverb->wetGain = wetGain; reverb->reverberance = reverberance;
+                    reverb->hfDamping = hfDamping; reverb->toneLow = toneLow; reverb->toneHigh = toneHigh;
+                }
+                if (reverb->preDelay != preDelay) {
+                    reverb_set_pre_delay(&r, AudioInfo::s_sampleRate, preDelay);
+                    reverb->preDelay = preDelay;
+                }
+                if (reverb->roomSize != roomSize || reverb->stereoWidth != stereoWidth) {
+                    reverb_set_room(&r, AudioInfo::s_sampleRate, roomSize, stereoWidth);
+                    reverb->roomSize = roomSize; reverb->stereoWidth = stereoWidth;
                 }
             }
 
-            std::vector<float*> ichans(AudioInfo::s_channels);
-            std::vector<float*> ochans(AudioInfo::s_channels);
-
             SharedRawAudioSamples outputSamples = AudioInfo::MakeRawAudioSamples();
-            for (int i = 0; i < AudioInfo::s_channels; i++) {
-                ichans[i] = samples.samples + i;
-                ochans[i] = outputSamples + i;
-            }
+            float* input = samples.samples;
+            float* output = outputSamples;
 
             float dryMult = wetOnly ? 0 : DecibelToLinear(dryGain);
-            int remaining = AudioInfo::s_periodSize * AudioInfo::s_channels;
+            int channels = AudioInfo::s_channels;
+            int remaining = AudioInfo::s_periodSize;
             while (remaining > 0) {
                 int len = std::min(remaining, REVERB_BLOCK_SIZE);
-                for (int c = 0; c < AudioInfo::s_channels; c++) {
+
+                // deinterleave straight into input fifos of the reverbs
+                for (int c = 0; c < channels; c++) {
                     auto& reverb = reverbBuffer.m_reverbs[c];
-                    reverb->dry = (float*) fifo_write(&reverb->reverb.input_fifo, len, ichans[c]);
-                    reverb_process(&reverb->reverb, len);
+                    reverb->dry = (float*) fifo_write(&reverb->reverb.input_fifo, len, nullptr);
                 }
-
-                if (AudioInfo::s_channels == 2) {
-                    for (int i = 0; i < len; i++) {
-                        for (int w = 0; w < 2; w++) {
-                            auto& reverb = reverbBuffer.m_reverbs[w];
-                            ochans[w][i] = dryMult * reverb->dry[i] + 0.5 * (reverbBuffer.m_reverbs[0]->wet[w][i] + reverbBuffer.m_reverbs[1]->wet[w][i]);
-                        }
-                    }
+                if (channels == 2) {
+                    DeinterleaveStereo(input, reverbBuffer.m_reverbs[0]->dry, reverbBuffer.m_reverbs[1]->dry, len);
                 } else {
-                    for (int i = 0; i < len; i++) {
-                        ochans[0][i] = dryMult * reverbBuffer.m_reverbs[0]->dry[i] + reverbBuffer.m_reverbs[0]->wet[0][i];
+                    for (int c = 0; c < channels; c++) {
+                        auto dry = reverbBuffer.m_reverbs[c]->dry;
+                        for (int i = 0; i < len; i++) dry[i] = input[i * channels + c];
                     }
                 }
 
-                remaining -= len;
+                for (int c = 0; c < channels; c++) {
+                    reverb_process(&reverbBuffer.m_reverbs[c]->reverb, len);
+                }
 
-                for (int c = 0; c < AudioInfo::s_channels; c++) {
-                    ichans[c] += len;
-                    ochans[c] += len;
+                if (channels == 2) {
+                    auto& left = reverbBuffer.m_reverbs[0];
+                    auto& right = reverbBuffer.m_reverbs[1];
+                    MixStereo(output, left->dry, right->dry, left->wet[0], right->wet[0], left->wet[1], right->wet[1], dryMult, len);
+                } else {
+                    for (int c = 0; c < channels; c++) {
+                        auto& reverb = reverbBuffer.m_reverbs[c];
+                        for (int i = 0; i < len; i++) {
+                            output[i * channels + c] = dryMult * reverb->dry[i] + reverb->wet[0][i];
+                        }
+                    }
                 }
+
+                remaining -= len;
+                input += len * channels;
+                output += len * channels;
             }
 
             AudioSamples reverbSamples = samples;
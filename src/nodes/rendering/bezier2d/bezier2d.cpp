@@ -23,12 +23,17 @@ namespace Raster {
         SetupAttribute("Antialiasing", 1);
     }
 
+    Bezier2D::~Bezier2D() {
+        GPU::DestroyLineMesh(m_lineMesh);
+    }
+
     AbstractPinMap Bezier2D::AbstractExecute(ContextData& t_contextData) {
         AbstractPinMap result = {};
 
         auto& project = Workspace::s_project.value();
 
         auto& framebuffer = m_managedFramebuffer.Get(GetAttribute<Framebuffer>("Base", t_contextData));
+        m_managedFramebuffer.SetDomainOfDefinition(m_managedFramebuffer.GetBaseRegion());
         auto bezierCandidate = GetAttribute<BezierCurve>("Bezier", t_contextData);
         auto gradientCandidate = GetAttribute<Gradient1D>("Gradient", t_contextData);
         auto antialiasingCandidate = GetAttribute<int>("Antialiasing", t_contextData);
@@ -42,30 +47,48 @@ namespace Raster {
         }
 
         if (bezierCandidate.has_value() && gradientCandidate.has_value() && antialiasingCandidate && widthCandidate && qualityCandidate) {
-            auto bezier = *bezierCandidate;
+            auto& bezier = *bezierCandidate;
             auto& gradient = gradientCandidate.value();
             auto& antialiasing = *antialiasingCandidate;
             auto width = *widthCandidate * Compositor::previewResolutionScale;
             auto& quality = *qualityCandidate;
-            auto iterations = std::pow(2, quality);
+            auto viewportSize = glm::vec2(framebuffer.width, framebuffer.height);
+
+            uint64_t lineMeshKey = HashCombine(bezier.Hash(), gradient.Hash());
+            lineMeshKey = HashCombine(lineMeshKey, HashValue(projectionMatrix));
+            lineMeshKey = HashCombine(lineMeshKey, HashValue(viewportSize));
+            lineMeshKey = HashCombine(lineMeshKey, HashValue(width));
+            lineMeshKey = HashCombine(lineMeshKey, HashValue(quality));
+
+            if (!m_lineMeshKey || *m_lineMeshKey != lineMeshKey) {
+                std::vector<float> parameters;
+                std::vector<glm::vec2> vertices;
+                bezier.Tessellate(projectionMatrix, viewportSize, std::clamp(quality, 1, 12), 0.25f, parameters, vertices);
+
+                auto gradientLUT = gradient.GetBaked(GradientLUT::GetResolution(Compositor::s_colorPrecision));
+                int segmentsCount = std::max((int) vertices.size() - 1, 0);
+                std::vector<glm::vec2> points(segmentsCount * 2);
+                std::vector<glm::vec4> colors(segmentsCount * 2);
+                for (int i = 0; i < segmentsCount; i++) {
+                    points[i * 2] = vertices[i];
+                    points[i * 2 + 1] = vertices[i + 1];
+                    colors[i * 2] = Gradient1D::SampleBaked(*gradientLUT, parameters[i]);
+                    colors[i * 2 + 1] = Gradient1D::SampleBaked(*gradientLUT, parameters[i + 1]);
+                }
+
+                GPU::UpdateLineMesh(m_lineMesh, points, colors, width);
+                m_lineMeshKey = lineMeshKey;
+
+                m_lineMeshPoints.clear();
+                for (auto& vertex : vertices) m_lineMeshPoints.push_back(glm::vec4(vertex, 0, 1));
+            }
 
             GPU::BindFramebuffer(framebuffer);
+            GPU::DrawLineMesh(m_lineMesh, viewportSize, antialiasing);
 
-            std::vector<glm::vec2> points;
-            for (auto& point : bezier.points) {
-                auto point4 = projectionMatrix * glm::vec4(point.x, point.y, 0, 1);
-                point = glm::vec2(point4.x, point4.y);
-            }
-            for (int i = 0; i < iterations; i++) {
-                points.push_back(bezier.Get((float) i / (float) iterations));
-                points.push_back(bezier.Get((float) (i + 1) / (float) iterations));
-            }
-            std::vector<glm::vec4> colors;
-            for (int i = 0; i < iterations; i++) {
-                colors.push_back(gradient.Get((float) i / (float) iterations));
-                colors.push_back(gradient.Get((float) (i + 1) / (float) iterations));
-            }
-            GPU::DrawLines(points, colors, width, glm::vec2(framebuffer.width, framebuffer.height), antialiasing);
+            int lineExtent = (int) std::ceil(width / 2.0f) + antialiasing + 1;
+            auto curveRegion = PixelRegion::FromClipSpace(m_lineMeshPoints, viewportSize);
+            m_managedFramebuffer.SetDomainOfDefinition(m_managedFramebuffer.GetBaseRegion().Union(curveRegion.Expand(lineExtent, lineExtent)));
 
             TryAppendAbstractPinMap(result, "Framebuffer", framebuffer);
         }
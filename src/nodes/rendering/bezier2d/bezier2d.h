@@ -5,6 +5,7 @@
 #include "compositor/compositor.h"
 #include "compositor/managed_framebuffer.h"
 #include "compositor/texture_interoperability.h"
+#include "compositor/gradient_lut.h"
 #include "common/transform2d.h"
 #include "raster.h"
 
@@ -12,6 +13,7 @@ namespace Raster {
     struct Bezier2D : public NodeBase {
     public:
         Bezier2D();
+        ~Bezier2D();
         
         AbstractPinMap AbstractExecute(ContextData& t_contextData);
         void AbstractRenderProperties();
@@ -26,5 +28,11 @@ namespace Raster {
 
     private:
         ManagedFramebuffer m_managedFramebuffer;
+
+        // tessellated geometry of the last drawn curve, rebuilt only when its key changes
+        LineMesh m_lineMesh;
+        std::optional<uint64_t> m_lineMeshKey;
+        // tessellated vertices in clip space, used for domain of definition
+        std::vector<glm::vec4> m_lineMeshPoints;
     };
 };
\ No newline at end of file
@@ -6,22 +6,25 @@
 #include "../../../ImGui/imgui.h"
 #include "common/dispatchers.h"
 #include "compositor/texture_interoperability.h"
+#include "compositor/convolution.h"
 #include "font/IconsFontAwesome5.h"
 
 
 
 namespace Raster {
-    std::optional<Pipeline> Convolve::s_pipeline;
-
     Convolve::Convolve() {
         NodeBase::Initialize();
 
         AddInputPin("Base");
+        AddInputPin("KernelTexture");
         AddOutputPin("Framebuffer");
 
         SetupAttribute("Base", Framebuffer());
         SetupAttribute("Kernel", ConvolutionKernel());
         SetupAttribute("Multiplier", 1.0f);
+        SetupAttribute("KernelTexture", Framebuffer());
+        SetupAttribute("KernelTextureSize", glm::vec2(15, 15));
+        SetupAttribute("NormalizeKernelTexture", true);
     }
 
     AbstractPinMap Convolve::AbstractExecute(ContextData& t_contextData) {
@@ -33,27 +36,37 @@ namespace Raster {
         auto baseCandidate = TextureInteroperability::GetTexture(GetDynamicAttribute("Base", t_contextData));
         auto kernelCandidate = GetAttribute<ConvolutionKernel>("Kernel", t_contextData);
         auto multiplierCandidate = GetAttribute<float>("Multiplier", t_contextData);
+        auto kernelTextureCandidate = TextureInteroperability::GetTexture(GetDynamicAttribute("KernelTexture", t_contextData));
+        auto kernelTextureSizeCandidate = GetAttribute<glm::vec2>("KernelTextureSize", t_contextData);
+        auto normalizeKernelTextureCandidate = GetAttribute<bool>("NormalizeKernelTexture", t_contextData);
 
         if (!RASTER_GET_CONTEXT_VALUE(t_contextData, "RENDERING_PASS", bool)) {
             return {};
         }
-        if (!s_pipeline) {
-            s_pipeline = GPU::GeneratePipeline(GPU::s_basicShader, GPU::GenerateShader(ShaderType::Fragment, "convolve/shader"));
-        }
 
-        if (s_pipeline && baseCandidate && kernelCandidate && multiplierCandidate) {
-            auto& pipeline = *s_pipeline;
-            auto& base = *baseCandidate;
-            auto& kernel = *kernelCandidate;
-            auto& multiplier = *multiplierCandidate;
+        if (baseCandidate && multiplierCandidate && kernelTextureCandidate && kernelTextureCandidate->handle && kernelTextureSizeCandidate && normalizeKernelTextureCandidate) {
+            int kernelWidth = (int) kernelTextureSizeCandidate->x, kernelHeight = (int) kernelTextureSizeCandidate->y;
+            if (kernelWidth * kernelHeight > MAX_DIRECT_TEXTURE_KERNEL_TAPS) {
+                // read back before the kernel region is scissored, plans of read back kernels are cached by their values
+                auto kernel = Convolution::ReadTextureKernel(*kernelTextureCandidate, kernelWidth, kernelHeight, *normalizeKernelTextureCandidate);
+                BeginKernelRegion(framebuffer, *baseCandidate, kernelWidth, kernelHeight);
+                auto strategy = Convolution::Apply(framebuffer, *baseCandidate, kernel, *multiplierCandidate, Compositor::previewResolutionScale);
+                EndKernelRegion();
+                m_lastStrategy = FormatString("Texture %s %ix%i", Convolution::StrategyToString(strategy).c_str(), kernelWidth, kernelHeight);
+            } else {
+                BeginKernelRegion(framebuffer, *baseCandidate, kernelWidth, kernelHeight);
+                Convolution::ApplyTexture(framebuffer, *baseCandidate, *kernelTextureCandidate, kernelWidth, kernelHeight, *multiplierCandidate, *normalizeKernelTextureCandidate, Compositor::previewResolutionScale);
+                EndKernelRegion();
+                m_lastStrategy = FormatString("Texture %ix%i", kernelWidth, kernelHeight);
+            }
 
-            GPU::BindPipeline(pipeline);
-            GPU::BindFramebuffer(framebuffer);
-            GPU::ClearFramebuffer(0, 0, 0, 0);
-            GPU::SetShaderUniform(pipeline.fragment, "uResolution", glm::vec2(framebuffer.width, framebuffer.height));
-            GPU::SetShaderUniform(pipeline.fragment, "uKernel", kernel.kernel * (kernel.multiplier * multiplier));
-            GPU::BindTextureToShader(pipeline.fragment, "uBase", base, 0);
-            GPU::DrawArrays(3);
+            TryAppendAbstractPinMap(result, "Framebuffer", framebuffer);
+        } else if (baseCandidate && kernelCandidate && multiplierCandidate) {
+            auto& kernel = *kernelCandidate;
+            BeginKernelRegion(framebuffer, *baseCandidate, kernel.width, kernel.height);
+            auto strategy = Convolution::Apply(framebuffer, *baseCandidate, kernel, *multiplierCandidate, Compositor::previewResolutionScale);
+            EndKernelRegion();
+            m_lastStrategy = FormatString("%s %ix%i", Convolution::StrategyToString(strategy).c_str(), kernel.width, kernel.height);
 
             TryAppendAbstractPinMap(result, "Framebuffer", framebuffer);
         }
@@ -61,6 +74,23 @@ namespace Raster {
         return result;
     }
 
+    void Convolve::BeginKernelRegion(Framebuffer& t_framebuffer, Texture& t_base, int t_kernelWidth, int t_kernelHeight) {
+        // convolution of transparent pixels is transparent, so output can only grow by kernel radius
+        auto baseRegion = DomainOfDefinition::GetOrFull(t_base);
+        int radiusX = (int) std::ceil(t_kernelWidth / 2 * Compositor::previewResolutionScale) + 1;
+        int radiusY = (int) std::ceil(t_kernelHeight / 2 * Compositor::previewResolutionScale) + 1;
+        m_managedFramebuffer.SetDomainOfDefinition(baseRegion.Expand(radiusX, radiusY));
+        // separable passes read intermediate results one more radius away
+        auto passRegion = baseRegion.Expand(radiusX * 2, radiusY * 2).Clamp(t_framebuffer.width, t_framebuffer.height);
+        m_kernelRegionScissored = !passRegion.Covers(t_framebuffer.width, t_framebuffer.height);
+        if (m_kernelRegionScissored) GPU::SetScissorRect(passRegion.ToScissor());
+    }
+
+    void Convolve::EndKernelRegion() {
+        if (m_kernelRegionScissored) GPU::SetScissorRect(std::nullopt);
+        m_kernelRegionScissored = false;
+    }
+
     void Convolve::AbstractLoadSerialized(Json t_data) {
         DeserializeAllAttributes(t_data);
     }
@@ -77,6 +107,13 @@ namespace Raster {
             SliderStepMetadata(0.1f),
             IconMetadata(ICON_FA_GEARS)
         });
+        RenderAttributeProperty("KernelTextureSize", {
+            SliderStepMetadata(1.0f),
+            IconMetadata(ICON_FA_UP_RIGHT_AND_DOWN_LEFT_FROM_CENTER)
+        });
+        RenderAttributeProperty("NormalizeKernelTexture", {
+            IconMetadata(ICON_FA_DIVIDE)
+        });
     }
 
     bool Convolve::AbstractDetailsAvailable() {
@@ -92,7 +129,8 @@ namespace Raster {
     }
 
     std::optional<std::string> Convolve::Footer() {
-        return std::nullopt;
+        if (!m_lastStrategy.has_value()) return std::nullopt;
+        return FormatString("%s %s", ICON_FA_IMAGE, m_lastStrategy->c_str());
     }
 }
 
@@ -25,7 +25,12 @@ namespace Raster {
         Json AbstractSerialize();
 
     private:
+        // reports domain of definition and scissors convolution passes to the region kernel can reach
+        void BeginKernelRegion(Framebuffer& t_framebuffer, Texture& t_base, int t_kernelWidth, int t_kernelHeight);
+        void EndKernelRegion();
+
         ManagedFramebuffer m_managedFramebuffer;
-        static std::optional<Pipeline> s_pipeline;
+        std::optional<std::string> m_lastStrategy;
+        bool m_kernelRegionScissored = false;
     };
 };
\ No newline at end of file
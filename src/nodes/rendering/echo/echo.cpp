@@ -47,38 +47,53 @@ namespace Raster {
             auto& frameStep = frameStepCandidate.value();
             float opacityStep = 1.0f / ((float) steps + 1);
 
-            project.TimeTravel(-steps * frameStep);
-
             auto& pipeline = s_echoPipeline.value();
-            int timeOffsetsCount = 1;
 
+            // results of the upstream graph are shared between frames through the temporal cache
+            auto basePinCandidate = GetAttributePin("Base");
+            std::optional<uint64_t> dependencyHash;
+            if (basePinCandidate.has_value() && basePinCandidate->connectedPinID > 0) {
+                dependencyHash = TemporalCache::ComputeDependencyHash(basePinCandidate->connectedPinID);
+            }
+
+            float currentTime = project.GetCorrectCurrentTime();
             for (int i = 0; i < steps + 1; i++) {
-                auto baseCandidate = GetAttribute<Framebuffer>("Base", t_contextData);
-                if (baseCandidate.has_value()) {
-                    if (project.GetCorrectCurrentTime() < 0) {
-                        project.TimeTravel(frameStep);
-                        continue;
-                    }
-                    auto& base = baseCandidate.value();
-                    if (base.attachments.size() <= 2 || !base.handle) {
-                        GPU::BindPipeline(pipeline);
-                        GPU::BindFramebuffer(framebuffer);
-                        GPU::SetShaderUniform(pipeline.fragment, "uResolution", requiredResolution);
-                        GPU::SetShaderUniform(pipeline.fragment, "uOpacity", std::clamp(opacityStep * (i + 1), 0.0f, 1.0f));
-                        GPU::BindTextureToShader(pipeline.fragment, "uColorTexture", base.attachments.at(0), 0);
-                        GPU::BindTextureToShader(pipeline.fragment, "uUVTexture", base.attachments.at(1), 1);
-
-                        GPU::DrawArrays(3);
+                int offset = (steps - i) * frameStep;
+                // earlier echoes are sampled on whole frames, so consecutive frames of playback ask for the same times
+                float targetTime = offset == 0 ? currentTime : std::floor(currentTime) - offset;
+                if (targetTime < 0) continue;
+
+                std::optional<uint64_t> cacheKey;
+                std::optional<Framebuffer> baseCandidate;
+                if (dependencyHash.has_value()) {
+                    cacheKey = TemporalCache::MakeKey(basePinCandidate->connectedPinID, targetTime, dependencyHash.value());
+                    baseCandidate = TemporalCache::GetFramebuffer(cacheKey.value());
+                }
+                if (!baseCandidate.has_value()) {
+                    project.TimeTravel(targetTime - currentTime);
+                    baseCandidate = GetAttribute<Framebuffer>("Base", t_contextData);
+                    project.ResetTimeTravel();
+                    if (baseCandidate.has_value() && baseCandidate->handle && cacheKey.has_value()) {
+                        // all echoes of a frame have to fit at once, otherwise linear playback never hits the cache
+                        TemporalCache::Reserve(nodeID, baseCandidate.value(), steps + 1);
+                        baseCandidate = TemporalCache::PutFramebuffer(cacheKey.value(), baseCandidate.value());
                     }
-
-                    project.TimeTravel(frameStep);
-                    timeOffsetsCount++;
+                }
+                if (!baseCandidate.has_value()) continue;
+
+                auto& base = baseCandidate.value();
+                if (base.attachments.size() >= 2) {
+                    GPU::BindPipeline(pipeline);
+                    GPU::BindFramebuffer(framebuffer);
+                    GPU::SetShaderUniform(pipeline.fragment, "uResolution", requiredResolution);
+                    GPU::SetShaderUniform(pipeline.fragment, "uOpacity", std::clamp(opacityStep * (i + 1), 0.0f, 1.0f));
+                    GPU::BindTextureToShader(pipeline.fragment, "uColorTexture", base.attachments.at(0), 0);
+                    GPU::BindTextureToShader(pipeline.fragment, "uUVTexture", base.attachments.at(1), 1);
+
+                    GPU::DrawArrays(3);
                 }
             }
             TryAppendAbstractPinMap(result, "Framebuffer", framebuffer);
-            for (int i = 0; i < timeOffsetsCount; i++) {
-                project.ResetTimeTravel();
-            }
         }
 
 
@@ -111,7 +126,9 @@ namespace Raster {
     }
 
     std::optional<std::string> Echo::Footer() {
-        return std::nullopt;
+        auto statistics = TemporalCache::GetStatistics();
+        return FormatString("%s Temporal Cache: %i hits / %i misses, %i MB", ICON_FA_CLOCK_ROTATE_LEFT,
+            (int) statistics.hits, (int) statistics.misses, (int) (statistics.usedBytes / (1024 * 1024)));
     }
 }
 
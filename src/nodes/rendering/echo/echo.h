@@ -3,6 +3,7 @@
 #include "common/common.h"
 #include "gpu/gpu.h"
 #include "compositor/compositor.h"
+#include "compositor/temporal_cache.h"
 
 namespace Raster {
     struct Echo : public NodeBase {
@@ -5,6 +5,7 @@
 #include "../../../ImGui/imgui.h"
 #include "../../../ImGui/imgui_stripes.h"
 #include "common/dispatchers.h"
+#include "gpu/shader_compiler.h"
 #include "raster.h"
 
 #define UNIFORM_CLAUSE(t_uniform, t_type) \
@@ -31,6 +32,11 @@ namespace Raster {
         SetupAttribute("AspectRatioCorrection", false);
 
         this->m_sampler = GPU::GenerateSampler();
+        this->m_compilingShaders = false;
+
+        // shape-specific shaders are only known after evaluating the graph, so only the common ones are warmed up
+        ShaderCompiler::Request(ShaderType::Vertex, "layer2d/shader");
+        ShaderCompiler::RequestSource(ShaderType::Fragment, GenerateShapeCode(SDFShape()));
     }
 
     Layer2D::~Layer2D() {
@@ -39,13 +45,16 @@ namespace Raster {
 
     AbstractPinMap Layer2D::AbstractExecute(ContextData& t_contextData) {
         AbstractPinMap result = {};
+        m_compilingShaders = false;
         if (!s_nullShapePipeline.has_value()) {
-            s_nullShapePipeline = GeneratePipelineFromShape(SDFShape()).pipeline;
+            auto nullShapePipelineCandidate = GeneratePipelineFromShape(SDFShape());
+            if (nullShapePipelineCandidate.has_value()) s_nullShapePipeline = nullShapePipelineCandidate.value().pipeline;
         }
 
         auto& project = Workspace::GetProject();
 
         auto& framebuffer = m_managedFramebuffer.Get(GetAttribute<Framebuffer>("Base", t_contextData));
+        m_managedFramebuffer.SetDomainOfDefinition(m_managedFramebuffer.GetBaseRegion());
         auto transformCandidate = GetAttribute<Transform2D>("Transform", t_contextData);
         auto colorCandidate = GetAttribute<glm::vec4>("Color", t_contextData);
         auto textureCandidate = TextureInteroperability::GetTexture(GetDynamicAttribute("Texture", t_contextData));
@@ -82,7 +91,8 @@ namespace Raster {
 
             float aspect = (float) framebuffer.width / (float) framebuffer.height;
             auto projectionMatrix = glm::ortho(-aspect, aspect, 1.0f, -1.0f, -1.0f, 1.0f);
-            GPU::SetShaderUniform(pipeline.vertex, "uMatrix", projectionMatrix * transform.GetTransformationMatrix());
+            auto layerMatrix = projectionMatrix * transform.GetTransformationMatrix();
+            GPU::SetShaderUniform(pipeline.vertex, "uMatrix", layerMatrix);
 
             GPU::SetShaderUniform(pipeline.fragment, "uAspectRatioCorrection", aspectRatioCorrection);
             glm::vec2 decomposedSize = transform.DecomposeSize();
@@ -112,8 +122,19 @@ namespace Raster {
 
             GPU::BindSampler(std::nullopt);
 
+            // shape is rasterized inside of the transformed quad only
+            auto layerRegion = PixelRegion::FromClipSpace({
+                layerMatrix * glm::vec4(-1, -1, 0, 1), layerMatrix * glm::vec4(1, -1, 0, 1),
+                layerMatrix * glm::vec4(-1, 1, 0, 1), layerMatrix * glm::vec4(1, 1, 0, 1)
+            }, glm::vec2(framebuffer.width, framebuffer.height));
+            m_managedFramebuffer.SetDomainOfDefinition(m_managedFramebuffer.GetBaseRegion().Union(layerRegion));
+
             TryAppendAbstractPinMap(result, "Framebuffer", framebuffer);
             TryAppendAbstractPinMap(result, "Center", transform.DecomposePosition());
+        } else if (m_compilingShaders) {
+            // base is passed through until shape shader is compiled
+            TryAppendAbstractPinMap(result, "Framebuffer", framebuffer);
+            if (transformCandidate.has_value()) TryAppendAbstractPinMap(result, "Center", transformCandidate.value().DecomposePosition());
         }
 
         return result;
@@ -170,27 +191,27 @@ namespace Raster {
         auto shapeCandidate = GetShape(t_contextData);
         if (!shapeCandidate.has_value()) return std::nullopt;
         auto& shape = shapeCandidate.value();
+        // shaders are owned by ShaderCompiler and may be shared with other layers
         if (shape.uniforms.empty()) {
             if (m_pipeline.has_value()) {
-                GPU::DestroyPipeline(m_pipeline.value().pipeline);
+                GPU::DestroyPipeline(m_pipeline.value().pipeline, false);
                 m_pipeline = std::nullopt;
             }
             return s_nullShapePipeline;
         }
-        if (!m_pipeline.has_value()) {
-            m_pipeline = GeneratePipelineFromShape(shape);
+        if (m_pipeline.has_value() && m_pipeline.value().shape.id != shape.id) {
+            GPU::DestroyPipeline(m_pipeline.value().pipeline, false);
+            m_pipeline = std::nullopt;
         }
-
-        auto& pipeline = m_pipeline.value();
-        if (pipeline.shape.id != shape.id) {
-            GPU::DestroyPipeline(pipeline.pipeline);
+        if (!m_pipeline.has_value()) {
             m_pipeline = GeneratePipelineFromShape(shape);
         }
+        if (!m_pipeline.has_value()) return std::nullopt;
 
         return m_pipeline.value().pipeline;
     }
 
-    SDFShapePipeline Layer2D::GeneratePipelineFromShape(SDFShape t_shape) {
+    std::string Layer2D::GenerateShapeCode(SDFShape t_shape) {
         std::string uniformsResult = "";
         for (auto& uniform : t_shape.uniforms) {
             uniformsResult += "uniform " + uniform.type + " " + uniform.name + ";\n";
@@ -204,22 +225,22 @@ namespace Raster {
         shaderBase = ReplaceString(shaderBase, "SDF_UNIFORMS_PLACEHOLDER", uniformsResult);
         shaderBase = ReplaceString(shaderBase, "SDF_DISTANCE_FUNCTION_PLACEHOLDER", t_shape.distanceFunctionName);
         shaderBase = ReplaceString(shaderBase, "SDF_DISTANCE_FUNCTIONS_PLACEHOLDER", t_shape.distanceFunctionCode);
+        return shaderBase;
+    }
 
-        std::string clearShaderFile = "layer2d/generated_shape_pipeline" + std::to_string(nodeID);
-        std::string shaderFile = GPU::GetShadersPath() + clearShaderFile + ".frag";
-        WriteFile(shaderFile, shaderBase);
-
-        Pipeline generatedPipeline = GPU::GeneratePipeline(
-            GPU::GenerateShader(ShaderType::Vertex, "layer2d/shader"),
-            GPU::GenerateShader(ShaderType::Fragment, clearShaderFile, false)
-        );
-
-        std::filesystem::remove(shaderFile);
+    std::optional<SDFShapePipeline> Layer2D::GeneratePipelineFromShape(SDFShape t_shape) {
+        std::string shaderCode = GenerateShapeCode(t_shape);
+        auto vertexCandidate = ShaderCompiler::Request(ShaderType::Vertex, "layer2d/shader");
+        auto fragmentCandidate = ShaderCompiler::RequestSource(ShaderType::Fragment, shaderCode);
+        if (!vertexCandidate.has_value() || !fragmentCandidate.has_value()) {
+            m_compilingShaders = true;
+            return std::nullopt;
+        }
 
         return SDFShapePipeline{
             .shape = t_shape,
-            .pipeline = generatedPipeline,
-            .shaderCode = shaderBase
+            .pipeline = GPU::GeneratePipeline(vertexCandidate.value(), fragmentCandidate.value()),
+            .shaderCode = shaderCode
         };
     }
 
@@ -244,6 +265,8 @@ namespace Raster {
     }
 
     std::optional<std::string> Layer2D::Footer() {
+        // queue is shared by all nodes, so the count tells how long this node may still wait
+        if (m_compilingShaders) return FormatString("%s %s (%i)", ICON_FA_SPINNER, "Compiling Shaders", ShaderCompiler::GetPendingCount());
         return std::nullopt;
     }
 }
@@ -257,7 +280,7 @@ extern "C" {
         return (Raster::AbstractNode) std::make_shared<Raster::Layer2D>();
     }
 
-    SDFShapePipeline GeneratePipelineFromShape(SDFShape t_shape) {
+    std::optional<SDFShapePipeline> GeneratePipelineFromShape(SDFShape t_shape) {
         std::string uniformsResult = "";
         for (auto& uniform : t_shape.uniforms) {
             uniformsResult += "uniform " + uniform.type + " " + uniform.name + ";\n";
@@ -272,21 +295,12 @@ extern "C" {
         shaderBase = ReplaceString(shaderBase, "SDF_DISTANCE_FUNCTION_PLACEHOLDER", t_shape.distanceFunctionName);
         shaderBase = ReplaceString(shaderBase, "SDF_DISTANCE_FUNCTIONS_PLACEHOLDER", t_shape.distanceFunctionCode);
 
-        std::string clearShaderFile = "shape_previewer/generated_shape_pipeline" + std::to_string(t_shape.id);
-        std::string shaderFile = GPU::GetShadersPath() + clearShaderFile + ".frag";
-        WriteFile(shaderFile, shaderBase);
-
-
-        Pipeline generatedPipeline = GPU::GeneratePipeline(
-            GPU::s_basicShader,
-            GPU::GenerateShader(ShaderType::Fragment, clearShaderFile, false)
-        );
-
-        std::filesystem::remove(shaderFile);
+        auto fragmentCandidate = ShaderCompiler::RequestSource(ShaderType::Fragment, shaderBase);
+        if (!fragmentCandidate.has_value()) return std::nullopt;
 
         return SDFShapePipeline{
             .shape = t_shape,
-            .pipeline = generatedPipeline,
+            .pipeline = GPU::GeneratePipeline(GPU::s_basicShader, fragmentCandidate.value()),
             .shaderCode = shaderBase
         };
     }
@@ -294,20 +308,19 @@ extern "C" {
     std::optional<Pipeline> GetPipeline(SDFShape shape, std::optional<SDFShapePipeline>& m_pipeline) {
         if (shape.uniforms.empty()) {
             if (m_pipeline.has_value()) {
-                GPU::DestroyPipeline(m_pipeline.value().pipeline);
+                GPU::DestroyPipeline(m_pipeline.value().pipeline, false);
                 m_pipeline = std::nullopt;
             }
             return s_nullShapePipeline;
         }
-        if (!m_pipeline.has_value()) {
-            m_pipeline = GeneratePipelineFromShape(shape);
+        if (m_pipeline.has_value() && m_pipeline.value().shape.id != shape.id) {
+            GPU::DestroyPipeline(m_pipeline.value().pipeline, false);
+            m_pipeline = std::nullopt;
         }
-
-        auto& pipeline = m_pipeline.value();
-        if (pipeline.shape.id != shape.id) {
-            GPU::DestroyPipeline(pipeline.pipeline);
+        if (!m_pipeline.has_value()) {
             m_pipeline = GeneratePipelineFromShape(shape);
         }
+        if (!m_pipeline.has_value()) return std::nullopt;
 
         return m_pipeline.value().pipeline;
     }
@@ -67,13 +67,16 @@ namespace Raster {
         std::optional<SDFShape> GetShape(ContextData& t_contextData);
         std::optional<Pipeline> GetPipeline(ContextData& t_contextData);
 
-        SDFShapePipeline GeneratePipelineFromShape(SDFShape t_shape);
+        // returns std::nullopt while shape shader is compiled in background
+        std::optional<SDFShapePipeline> GeneratePipelineFromShape(SDFShape t_shape);
+        static std::string GenerateShapeCode(SDFShape t_shape);
 
         void SetShapeUniforms(SDFShape t_shape, Pipeline pipeline);
 
         Sampler m_sampler;
         ManagedFramebuffer m_managedFramebuffer;
         std::optional<SDFShapePipeline> m_pipeline;
+        std::atomic<bool> m_compilingShaders;
 
         static std::optional<Pipeline> s_nullShapePipeline;
     };
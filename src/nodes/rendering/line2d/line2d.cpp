@@ -21,12 +21,17 @@ namespace Raster {
         SetupAttribute("Antialiasing", 1);
     }
 
+    Line2DNode::~Line2DNode() {
+        GPU::DestroyLineMesh(m_lineMesh);
+    }
+
     AbstractPinMap Line2DNode::AbstractExecute(ContextData& t_contextData) {
         AbstractPinMap result = {};
 
         auto& project = Workspace::s_project.value();
 
         auto& framebuffer = m_managedFramebuffer.Get(GetAttribute<Framebuffer>("Base", t_contextData));
+        m_managedFramebuffer.SetDomainOfDefinition(m_managedFramebuffer.GetBaseRegion());
         auto lineCandidate = GetAttribute<Line2D>("Line", t_contextData);
         auto colorCandidate = GetAttribute<glm::vec4>("Color", t_contextData);
         auto antialiasingCandidate = GetAttribute<int>("Antialiasing", t_contextData);
@@ -38,24 +43,39 @@ namespace Raster {
             return {};
         }
 
-        if (lineCandidate.has_value() && colorCandidate.has_value()) {
+        if (lineCandidate.has_value() && colorCandidate.has_value() && antialiasingCandidate && widthCandidate) {
             auto& line = *lineCandidate;
             auto& color = colorCandidate.value();
             auto& antialiasing = *antialiasingCandidate;
             auto width = *widthCandidate * Compositor::previewResolutionScale;
+            auto viewportSize = glm::vec2(framebuffer.width, framebuffer.height);
+
+            uint64_t lineMeshKey = HashCombine(HashValue(line.begin), HashValue(line.end));
+            lineMeshKey = HashCombine(lineMeshKey, HashValue(line.beginColor * color));
+            lineMeshKey = HashCombine(lineMeshKey, HashValue(line.endColor * color));
+            lineMeshKey = HashCombine(lineMeshKey, HashValue(projectionMatrix));
+            lineMeshKey = HashCombine(lineMeshKey, HashValue(width));
+
+            if (!m_lineMeshKey || *m_lineMeshKey != lineMeshKey) {
+                auto transformedBegin = (projectionMatrix * glm::vec4(line.begin, 0, 1));
+                auto transformedEnd = (projectionMatrix * glm::vec4(line.end, 0, 1));
+
+                std::vector<glm::vec2> points = {
+                    glm::vec2(transformedBegin.x, transformedBegin.y), glm::vec2(transformedEnd.x, transformedEnd.y)
+                };
+                std::vector<glm::vec4> colors = {
+                    line.beginColor * color, line.endColor * color
+                };
+                GPU::UpdateLineMesh(m_lineMesh, points, colors, width);
+                m_lineMeshKey = lineMeshKey;
+            }
 
             GPU::BindFramebuffer(framebuffer);
+            GPU::DrawLineMesh(m_lineMesh, viewportSize, antialiasing);
 
-            auto transformedBegin = (projectionMatrix * glm::vec4(line.begin, 0, 1));
-            auto transformedEnd = (projectionMatrix * glm::vec4(line.end, 0, 1));
-
-            std::vector<glm::vec2> points = {
-                glm::vec2(transformedBegin.x, transformedBegin.y), glm::vec2(transformedEnd.x, transformedEnd.y)
-            };
-            std::vector<glm::vec4> colors = {
-                line.beginColor * color, line.endColor * color
-            };
-            GPU::DrawLines(points, colors, width, glm::vec2(framebuffer.width, framebuffer.height), antialiasing);
+            int lineExtent = (int) std::ceil(width / 2.0f) + antialiasing + 1;
+            auto lineRegion = PixelRegion::FromClipSpace({projectionMatrix * glm::vec4(line.begin, 0, 1), projectionMatrix * glm::vec4(line.end, 0, 1)}, viewportSize);
+            m_managedFramebuffer.SetDomainOfDefinition(m_managedFramebuffer.GetBaseRegion().Union(lineRegion.Expand(lineExtent, lineExtent)));
 
             TryAppendAbstractPinMap(result, "Framebuffer", framebuffer);
         }
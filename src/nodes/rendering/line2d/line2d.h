@@ -12,6 +12,7 @@ namespace Raster {
     struct Line2DNode : public NodeBase {
     public:
         Line2DNode();
+        ~Line2DNode();
         
         AbstractPinMap AbstractExecute(ContextData& t_contextData);
         void AbstractRenderProperties();
@@ -26,5 +27,8 @@ namespace Raster {
 
     private:
         ManagedFramebuffer m_managedFramebuffer;
+
+        LineMesh m_lineMesh;
+        std::optional<uint64_t> m_lineMeshKey;
     };
 };
\ No newline at end of file
@@ -52,6 +52,7 @@ namespace Raster {
                 .compositionID = -1
             });
             Compositor::PerformManualComposition(targets, framebuffer, glm::vec4(0));
+            m_framebuffer.SetDomainOfDefinition(DomainOfDefinition::GetOrFull(a.attachments[0]).Union(DomainOfDefinition::GetOrFull(b.attachments[0])));
 
             TryAppendAbstractPinMap(result, "Output", framebuffer);
         }
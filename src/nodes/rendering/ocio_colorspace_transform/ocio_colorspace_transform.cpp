@@ -33,6 +33,7 @@ namespace Raster {
         SetupAttribute("DestinationColorspace", Colorspace());
         SetupAttribute("Direction", Choice(std::vector<std::string>{"Forward", "Inverse"}));
         SetupAttribute("Bypass", false);
+        SetupAttribute("BakeLUT", Choice(std::vector<std::string>{"Off", "33x33x33", "65x65x65"}));
     }
 
     AbstractPinMap OCIOColorSpaceTransform::AbstractExecute(ContextData& t_contextData) {
@@ -45,21 +46,22 @@ namespace Raster {
         auto dstCandidate = GetAttribute<std::string>("DestinationColorspace", t_contextData);
         auto directionCandidate = GetAttribute<int>("Direction", t_contextData);
         auto bypassCandidate = GetAttribute<bool>("Bypass", t_contextData);
+        auto bakeLUTCandidate = GetAttribute<int>("BakeLUT", t_contextData);
 
         if (!RASTER_GET_CONTEXT_VALUE(t_contextData, "RENDERING_PASS", bool)) {
             return {};
         }
-        if (framebuffer.handle && srcCandidate && dstCandidate && directionCandidate && bypassCandidate) {
+        if (framebuffer.handle && srcCandidate && dstCandidate && directionCandidate && bypassCandidate && bakeLUTCandidate) {
             auto& src = *srcCandidate;
             auto& dst = *dstCandidate;
             auto& direction = *directionCandidate;
             auto& bypass = *bypassCandidate;
-            if (!m_context || (m_context && (m_context->src != src || m_context->dst != dst || m_context->bypass != bypass || m_context->direction != (direction == 0 ? OCIO::TransformDirection::TRANSFORM_DIR_FORWARD : OCIO::TransformDirection::TRANSFORM_DIR_INVERSE)))) {
-                if (m_context) m_context->Destroy();
-                m_context = OCIOColorSpaceTransformContext(direction == 0 ? OCIO::TransformDirection::TRANSFORM_DIR_FORWARD : OCIO::TransformDirection::TRANSFORM_DIR_INVERSE, src, dst, bypass);
+            auto bakeMode = static_cast<OCIOBakeMode>(std::clamp(*bakeLUTCandidate, 0, 2));
+            if (!m_context || (m_context && (m_context->src != src || m_context->dst != dst || m_context->bypass != bypass || m_context->bakeMode != bakeMode || m_context->direction != (direction == 0 ? OCIO::TransformDirection::TRANSFORM_DIR_FORWARD : OCIO::TransformDirection::TRANSFORM_DIR_INVERSE)))) {
+                m_context = OCIOColorSpaceTransformContext(direction == 0 ? OCIO::TransformDirection::TRANSFORM_DIR_FORWARD : OCIO::TransformDirection::TRANSFORM_DIR_INVERSE, src, dst, bypass, bakeMode);
             }
             if (!m_context || !m_context->valid) return {};
-            auto& ocio = m_context->pipeline;
+            auto& ocio = *m_context->pipeline;
             GPU::BindFramebuffer(framebuffer);
             GPU::BindPipeline(ocio.pipeline);
             GPU::SetShaderUniform(ocio.pipeline.fragment, "uResolution", glm::vec2(framebuffer.width, framebuffer.height));
@@ -75,19 +77,20 @@ namespace Raster {
         return result;
     }
 
-    OCIOColorSpaceTransformContext::OCIOColorSpaceTransformContext(OCIO::TransformDirection t_direction, std::string t_src, std::string t_dst, bool t_bypass) {
+    OCIOColorSpaceTransformContext::OCIOColorSpaceTransformContext(OCIO::TransformDirection t_direction, std::string t_src, std::string t_dst, bool t_bypass, OCIOBakeMode t_bakeMode) {
         try {
             this->src = t_src;
             this->dst = t_dst;
             this->bypass = t_bypass;
             this->direction = t_direction;
+            this->bakeMode = t_bakeMode;
             this->gp = OCIO::ColorSpaceTransform::Create();
             gp->setDirection(direction);
             gp->setSrc(src.c_str());
             gp->setDst(dst.c_str());
             gp->setDataBypass(bypass);
-            pipeline = OCIOPipeline(gp);
-            this->valid = true; 
+            pipeline = OCIOPipelineCache::Acquire(gp, bakeMode);
+            this->valid = pipeline != nullptr;
         } catch (const OCIO::Exception& ex) {
             RASTER_LOG("failed to generate OCIOColorSpaceTransformContext");
             RASTER_LOG(ex.what());
@@ -98,11 +101,6 @@ namespace Raster {
         } 
     }
 
-    void OCIOColorSpaceTransformContext::Destroy() {
-        if (!this->valid) return;
-        pipeline.Destroy();
-    }
-
     void OCIOColorSpaceTransform::AbstractLoadSerialized(Json t_data) {
         DeserializeAllAttributes(t_data);
     }
@@ -124,6 +122,9 @@ namespace Raster {
         RenderAttributeProperty("Bypass", {
             IconMetadata(ICON_FA_ROUTE)
         });
+        RenderAttributeProperty("BakeLUT", {
+            IconMetadata(ICON_FA_CUBE)
+        });
     }
 
     bool OCIOColorSpaceTransform::AbstractDetailsAvailable() {
@@ -139,7 +140,9 @@ namespace Raster {
     }
 
     std::optional<std::string> OCIOColorSpaceTransform::Footer() {
-        return std::nullopt;
+        if (!m_context || !m_context->valid || !m_context->pipeline->bakeStatistics) return std::nullopt;
+        auto& statistics = *m_context->pipeline->bakeStatistics;
+        return FormatString("%s %i^3 LUT: max error %.5f, avg error %.5f, baked in %.1f ms", ICON_FA_CUBE, statistics.edgeLength, statistics.maxError, statistics.averageError, statistics.bakeMilliseconds);
     }
 }
 
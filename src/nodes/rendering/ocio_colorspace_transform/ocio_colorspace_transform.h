@@ -12,6 +12,7 @@
 #include <OpenColorIO/OpenColorTypes.h>
 #include <memory>
 #include "ocio_pipeline.h"
+#include "common/ocio_pipeline_cache.h"
 
 namespace Raster {
 
@@ -20,12 +21,11 @@ namespace Raster {
         std::string src, dst;
         bool bypass;
         OCIO::TransformDirection direction;
-        OCIOPipeline pipeline;
+        OCIOBakeMode bakeMode;
+        std::shared_ptr<OCIOPipeline> pipeline;
         bool valid;
 
-        OCIOColorSpaceTransformContext(OCIO::TransformDirection t_direction, std::string t_src, std::string t_dst, bool t_bypass);
-        
-        void Destroy();
+        OCIOColorSpaceTransformContext(OCIO::TransformDirection t_direction, std::string t_src, std::string t_dst, bool t_bypass, OCIOBakeMode t_bakeMode);
     };
 
     struct OCIOColorSpaceTransform : public NodeBase {
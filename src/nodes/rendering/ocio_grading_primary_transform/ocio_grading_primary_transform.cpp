@@ -19,9 +19,6 @@
 
 namespace Raster {
 
-    std::shared_ptr<OCIOGradingPrimaryTransformContext> OCIOGradingPrimaryTransform::m_context;
-    std::shared_ptr<OCIOGradingPrimaryTransformContext> OCIOGradingPrimaryTransform::m_inverseContext;
-
     OCIOGradingPrimaryTransform::OCIOGradingPrimaryTransform() {
         NodeBase::Initialize();
 
@@ -89,8 +86,8 @@ namespace Raster {
             auto& pWhite = *pWhiteCandidate;
 
             auto& context = direction == 0 ? m_context : m_inverseContext;
-            if (!context->pipeline.valid) return {};
-            auto& ocio = context->pipeline;
+            if (!context->pipeline) return {};
+            auto& ocio = *context->pipeline;
 
             OCIO::GradingPrimary data(OCIO::GradingStyle::GRADING_LIN);
             data.m_brightness = {brightness.r, brightness.g, brightness.b, brightness.a};
@@ -125,11 +122,7 @@ namespace Raster {
         this->gp = OCIO::GradingPrimaryTransform::Create(OCIO::GradingStyle::GRADING_LIN);
         gp->makeDynamic();
         gp->setDirection(t_direction);
-        this->pipeline = OCIOPipeline(gp);
-    }
-
-    OCIOGradingPrimaryTransformContext::~OCIOGradingPrimaryTransformContext() {
-        pipeline.Destroy();
+        this->pipeline = OCIOPipelineCache::Acquire(gp);
     }
 
     void OCIOGradingPrimaryTransform::AbstractLoadSerialized(Json t_data) {
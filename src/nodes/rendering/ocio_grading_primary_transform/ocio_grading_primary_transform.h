@@ -11,15 +11,15 @@
 #include <OpenColorIO/OpenColorTransforms.h>
 #include <OpenColorIO/OpenColorTypes.h>
 #include "ocio_pipeline.h"
+#include "common/ocio_pipeline_cache.h"
 
 namespace Raster {
 
     struct OCIOGradingPrimaryTransformContext {
         OCIO::GradingPrimaryTransformRcPtr gp;
-        OCIOPipeline pipeline;
+        std::shared_ptr<OCIOPipeline> pipeline;
 
         OCIOGradingPrimaryTransformContext(OCIO::TransformDirection t_direction);
-        ~OCIOGradingPrimaryTransformContext();
     };
 
     struct OCIOGradingPrimaryTransform : public NodeBase {
@@ -38,7 +38,7 @@ namespace Raster {
         Json AbstractSerialize();
 
     private:
-        static std::shared_ptr<OCIOGradingPrimaryTransformContext> m_context, m_inverseContext;
+        std::shared_ptr<OCIOGradingPrimaryTransformContext> m_context, m_inverseContext;
         ManagedFramebuffer m_managedFramebuffer;
     };
 };
\ No newline at end of file
@@ -60,9 +60,7 @@ namespace Raster {
             auto& sampler = s_sampler.value();
             auto& samples = samplesCandidate.value();
             
-            project.TimeTravel(-1);
-            
-            auto previousTransformCandidate = GetAttribute<Transform2D>("Transform", t_contextData);
+            auto previousTransformCandidate = GetPreviousTransform(baseTransform, t_contextData);
             if (previousTransformCandidate.has_value()) {
                 auto& previousTransform = previousTransformCandidate.value();
 
@@ -132,11 +130,38 @@ namespace Raster {
                 TryAppendAbstractPinMap(result, "Framebuffer", framebuffer);
 
             }
+        }
+
+        return result;
+    }
 
+    std::optional<Transform2D> TrackingMotionBlur::GetPreviousTransform(Transform2D& t_currentTransform, ContextData& t_contextData) {
+        auto& project = Workspace::GetProject();
+        auto transformPinCandidate = GetAttributePin("Transform");
+        if (!transformPinCandidate.has_value() || transformPinCandidate->connectedPinID <= 0) {
+            project.TimeTravel(-1);
+            auto previousTransformCandidate = GetAttribute<Transform2D>("Transform", t_contextData);
             project.ResetTimeTravel();
+            return previousTransformCandidate;
         }
 
-        return result;
+        // transforms produced by upstream nodes are remembered, so frame-by-frame rendering evaluates them once
+        auto producerPinID = transformPinCandidate->connectedPinID;
+        auto dependencyHash = TemporalCache::ComputeDependencyHash(producerPinID);
+        auto currentTime = project.GetCorrectCurrentTime();
+        TemporalCache::PutValue(TemporalCache::MakeKey(producerPinID, currentTime, dependencyHash), t_currentTransform);
+
+        auto previousKey = TemporalCache::MakeKey(producerPinID, currentTime - 1, dependencyHash);
+        auto cachedTransformCandidate = TemporalCache::GetValue(previousKey);
+        if (cachedTransformCandidate.has_value() && cachedTransformCandidate->type() == typeid(Transform2D)) {
+            return std::any_cast<Transform2D>(cachedTransformCandidate.value());
+        }
+
+        project.TimeTravel(-1);
+        auto previousTransformCandidate = GetAttribute<Transform2D>("Transform", t_contextData);
+        project.ResetTimeTravel();
+        if (previousTransformCandidate.has_value()) TemporalCache::PutValue(previousKey, previousTransformCandidate.value());
+        return previousTransformCandidate;
     }
 
     void TrackingMotionBlur::AbstractLoadSerialized(Json t_data) {
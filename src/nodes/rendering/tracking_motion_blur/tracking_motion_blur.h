@@ -5,6 +5,7 @@
 #include "compositor/compositor.h"
 #include "common/transform2d.h"
 #include "compositor/double_buffered_framebuffer.h"
+#include "compositor/temporal_cache.h"
 
 namespace Raster {
     struct TrackingMotionBlur : public NodeBase {
@@ -23,6 +24,8 @@ namespace Raster {
         std::string Icon();
         std::optional<std::string> Footer();
     private:
+        std::optional<Transform2D> GetPreviousTransform(Transform2D& t_currentTransform, ContextData& t_contextData);
+
         DoubleBufferedFramebuffer m_framebuffer, m_temporalFramebuffer;
 
         static std::optional<Pipeline> s_pipeline;
@@ -8,71 +8,40 @@ namespace Raster {
 
     LoadTextureByPath::LoadTextureByPath() {
         NodeBase::Initialize();
+        m_handleModificationTime = 0;
 
         AddOutputPin("Texture");
 
         SetupAttribute("Path", std::string(""));
-
-        this->archive = std::nullopt;
-        this->m_asyncUploadID = 0;
-    }
-
-    LoadTextureByPath::~LoadTextureByPath() {
-        if (archive.has_value()) {
-            auto& archiveValue = archive.value();
-            GPU::DestroyTexture(archiveValue.texture);
-        }
     }
 
     AbstractPinMap LoadTextureByPath::AbstractExecute(ContextData& t_contextData) {
         AbstractPinMap result = {};
 
-        if (!archive.has_value()) UpdateTextureArchive(t_contextData);
-        
-        if (archive.has_value()) {
-            auto unpackedArchive = archive.value();
-            auto path = GetAttribute<std::string>("Path", t_contextData).value_or("");
-            m_lastPath = path;
-            if (path != unpackedArchive.path) UpdateTextureArchive(t_contextData);
+        UpdateTextureHandle(t_contextData);
 
-            TryAppendAbstractPinMap(result, "Texture", unpackedArchive.texture);
+        auto textureCandidate = TextureCache::GetTexture(m_handle);
+        if (textureCandidate.has_value()) {
+            TryAppendAbstractPinMap(result, "Texture", textureCandidate.value());
         }
 
         return result;
     }
 
-    void LoadTextureByPath::UpdateTextureArchive(ContextData& t_contextData) {
+    void LoadTextureByPath::UpdateTextureHandle(ContextData& t_contextData) {
         std::string path = GetAttribute<std::string>("Path", t_contextData).value_or("");
-        if (std::filesystem::exists(path) && !std::filesystem::is_directory(path)) {
-            if (!m_loader.IsInitialized() && !m_asyncUploadID) {
-                m_loader = AsyncImageLoader(path);
-                if (archive.has_value()) {
-                    auto& textureArchive = archive.value();
-                    AsyncUpload::DestroyTexture(textureArchive.texture);
-                }
-                archive = std::nullopt;
-            }
-            if (m_loader.IsReady()) {
-                auto imageCandidate = m_loader.Get();
-                if (imageCandidate.has_value()) {
-                    auto& image = imageCandidate.value();
-                    
-                    TexturePrecision precision = TexturePrecision::Usual;
-                    if (image->precision == ImagePrecision::Half) precision = TexturePrecision::Half;
-                    if (image->precision == ImagePrecision::Full) precision = TexturePrecision::Full;
-
-                    if (!m_asyncUploadID) {
-                        m_asyncUploadID = AsyncUpload::GenerateTextureFromImage(image);
-                        m_loader = AsyncImageLoader();
-                    }
-                }
-            }
-            if (AsyncUpload::IsUploadReady(m_asyncUploadID)) {
-                auto& info = AsyncUpload::GetUpload(m_asyncUploadID);
-                archive = TextureArchive(info.texture, path);
-                AsyncUpload::DestroyUpload(m_asyncUploadID);
-            }
-        }
+        m_lastPath = path;
+        // edited files are picked up through modification time, missing files report 0 until they appear
+        std::error_code error;
+        int64_t modificationTime = (int64_t) std::filesystem::last_write_time(path, error).time_since_epoch().count();
+        if (error) modificationTime = 0;
+        if (m_handlePath.has_value() && m_handlePath.value() == path && m_handleModificationTime == modificationTime) return;
+
+        // the cache shares the texture with every other node and asset that loads the same file.
+        // failed loads are remembered as well, so invalid paths aren't retried every frame
+        m_handle = TextureCache::Acquire(path);
+        m_handlePath = path;
+        m_handleModificationTime = modificationTime;
     }
 
     bool LoadTextureByPath::AbstractDetailsAvailable() {
@@ -85,7 +54,7 @@ namespace Raster {
 
     std::string LoadTextureByPath::AbstractHeader() {
         std::string base = FormatString("Load Texture By Path: %s", m_lastPath.value_or("").c_str());
-        if (m_loader.IsInitialized() && !m_loader.IsReady()) {
+        if (TextureCache::IsLoading(m_handle)) {
             base = ICON_FA_SPINNER + (" " + base);
         }
         return base;
@@ -100,7 +69,10 @@ namespace Raster {
     }
 
     std::optional<std::string> LoadTextureByPath::Footer() {
-        return std::nullopt;
+        auto statistics = TextureCache::GetStatistics();
+        return FormatString("%s Texture Cache: %i hits / %i misses, %i MB in use, %i MB released",
+            ICON_FA_MEMORY, (int) statistics.hits, (int) statistics.misses,
+            (int) (statistics.referencedBytes / (1024 * 1024)), (int) (statistics.releasedBytes / (1024 * 1024)));
     }
 
     std::string LoadTextureByPath::Icon() {
@@ -3,26 +3,15 @@
 #include "common/common.h"
 #include "gpu/gpu.h"
 #include "image/image.h"
-#include "gpu/async_upload.h"
+#include "gpu/texture_cache.h"
 
 namespace Raster {
 
-    struct TextureArchive {
-        Texture texture;
-        std::string path;
-
-        TextureArchive(Texture t_texture, std::string t_path) :
-            texture(t_texture), path(t_path) {}
-    };
-
     struct LoadTextureByPath : public NodeBase {
     public:
-        std::optional<TextureArchive> archive;
-
         LoadTextureByPath();
-        ~LoadTextureByPath();
-        
-        void UpdateTextureArchive(ContextData& t_contextData);
+
+        void UpdateTextureHandle(ContextData& t_contextData);
 
         AbstractPinMap AbstractExecute(ContextData& t_contextData);
 
@@ -38,8 +27,9 @@ namespace Raster {
         std::optional<std::string> Footer();
 
     private:
-        AsyncUploadInfoID m_asyncUploadID;
-        AsyncImageLoader m_loader;
+        SharedTextureHandle m_handle;
+        std::optional<std::string> m_handlePath;
+        int64_t m_handleModificationTime;
 
         std::optional<std::string> m_lastPath;
     };
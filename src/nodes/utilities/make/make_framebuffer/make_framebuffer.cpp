@@ -44,10 +44,9 @@ namespace Raster {
             auto requiredResolution = resolutionCandidate.value() * Compositor::previewResolutionScale;
             if (!m_internalFramebuffer.has_value() || m_internalFramebuffer.value().width != (int) requiredResolution.x || m_internalFramebuffer.value().height != (int) requiredResolution.y || m_internalFramebuffer.value().Get().attachments[0].precision != Compositor::s_colorPrecision) {
                 if (m_internalFramebuffer.has_value()) {
-                    auto& framebuffer = m_internalFramebuffer.value();
-                    framebuffer.Destroy();
+                    Compositor::RecycleFramebuffer(m_internalFramebuffer.value());
                 }
-                m_internalFramebuffer = Compositor::GenerateCompatibleDoubleBufferedFramebuffer(requiredResolution, Compositor::s_colorPrecision);
+                m_internalFramebuffer = Compositor::AcquireDoubleBufferedFramebuffer(requiredResolution, Compositor::s_colorPrecision);
             }
 
             if (m_internalFramebuffer.has_value() && s_pipeline.has_value()) {
@@ -3,13 +3,13 @@
 #include "common/generic_resolution.h"
 #include "common/gradient_1d.h"
 #include "common/project.h"
-#include "common/randomizer.h"
 #include "common/sampler_settings.h"
 #include "common/transform2d.h"
 #include "compositor/managed_framebuffer.h"
 #include "compositor/texture_interoperability.h"
 #include "font/IconsFontAwesome5.h"
 #include "gpu/gpu.h"
+#include "gpu/shader_compiler.h"
 #include "common/choice.h"
 #include "common/dispatchers.h"
 #include "matchbox_effects.h"
@@ -38,18 +38,11 @@ namespace Raster {
     std::unordered_map<std::string, Pipeline> MatchboxEffectProvider::s_pipelineCache;
     std::unordered_map<std::string, Texture> MatchboxEffectProvider::s_textureGridsCache;
 
-    MatchboxEffectProvider::MatchboxEffectProvider(std::string t_xmlPath) {
+    MatchboxEffectProvider::MatchboxEffectProvider(std::shared_ptr<const MatchboxEffectDefinition> t_definition) {
         NodeBase::Initialize();
-        this->m_document = std::make_unique<xml_document>();
-        auto parseResult = m_document->load_file(t_xmlPath.c_str());
-        if (!parseResult) {
-            throw std::runtime_error("could not load matchbox effect " + t_xmlPath);
-        }
-
-        this->m_data = ParseEffectData(*m_document);
-        this->m_baseName = GetBaseName(RemoveExtension(t_xmlPath));
+        this->m_definition = t_definition;
 
-        for (auto& attribute : m_data.attributes) {
+        for (auto& attribute : m_definition->data.attributes) {
             if (attribute.duplicate) continue;
             SetupAttribute(attribute.uniformName, attribute.defaultValue);
             SetAttributeAlias(attribute.uniformName, attribute.attributeName);
@@ -58,6 +51,50 @@ namespace Raster {
             }
         }
         AddOutputPin("Output");
+
+        m_framebuffers = std::vector<ManagedFramebuffer>(m_definition->data.passes.size());
+
+        // projects instantiate all of their nodes when opened, so shaders are ready by the time they're rendered
+        m_compilingShaders = false;
+        for (auto& pass : m_definition->data.passes) {
+            RequestShader(pass.shaderIndex);
+        }
+    }
+
+    std::shared_ptr<const MatchboxEffectDefinition> MatchboxEffectProvider::LoadDefinition(std::string t_xmlPath) {
+        xml_document document;
+        if (!document.load_file(t_xmlPath.c_str())) {
+            throw std::runtime_error("could not load matchbox effect " + t_xmlPath);
+        }
+
+        auto definition = std::make_shared<MatchboxEffectDefinition>();
+        definition->data = ParseEffectData(document);
+        definition->baseName = GetBaseName(RemoveExtension(t_xmlPath));
+
+        auto shadersPath = GPU::GetShadersPath();
+        static std::vector<std::string> s_probeFormats = {
+            "matchbox/%s.glsl",
+            "matchbox/%s.%i.glsl",
+            "matchbox/%s.%02i.glsl"
+        };
+        for (auto& pass : definition->data.passes) {
+            if (definition->shaderCodes.find(pass.shaderIndex) != definition->shaderCodes.end()) continue;
+            for (auto& format : s_probeFormats) {
+                auto formattedPath = shadersPath + FormatString(format, definition->baseName.c_str(), pass.shaderIndex);
+                // DUMP_VAR(formattedPath);
+                if (std::filesystem::exists(formattedPath)) {
+                    // RASTER_LOG(formattedPath << " found");
+                    auto shaderContent = ReadFile(formattedPath);
+                    static std::optional<std::string> s_matchboxPreset;
+                    if (!s_matchboxPreset) {
+                        s_matchboxPreset = ReadFile(shadersPath + "matchbox/matchbox_shader_base.glsl");
+                    }
+                    definition->shaderCodes[pass.shaderIndex] = ReplaceString(*s_matchboxPreset, "MATCHBOX_CODE_GOES_HERE", shaderContent);
+                    break;
+                }
+            }
+        }
+        return definition;
     }
 
     MatchboxEffectProvider::~MatchboxEffectProvider() {
@@ -111,6 +148,20 @@ namespace Raster {
         if (!compositionCandidate) return result;
         auto& composition = *compositionCandidate;
 
+        // effect is bypassed until all of its shaders are compiled
+        m_compilingShaders = false;
+        for (auto& pass : m_definition->data.passes) {
+            GetPipelineForIndex(pass.shaderIndex);
+        }
+        if (m_compilingShaders) {
+            auto baseCandidate = TextureInteroperability::GetFramebuffer(GetDynamicCachedAttribute(m_definition->data.frontAttributeName, t_contextData));
+            if (!baseCandidate) {
+                baseCandidate = TextureInteroperability::GetFramebuffer(GetDynamicCachedAttribute(m_definition->data.backAttributeName, t_contextData));
+            }
+            if (baseCandidate) TryAppendAbstractPinMap(result, "Output", *baseCandidate);
+            return result;
+        }
+
         static Texture s_whiteTexture;
         if (!s_whiteTexture.handle) {
             s_whiteTexture = GPU::GenerateTexture(1, 1, 4);
@@ -126,12 +177,13 @@ namespace Raster {
         }
 
         std::vector<Framebuffer> passBuffers;
-        for (auto& pass : m_data.passes) {
+        for (int passIndex = 0; passIndex < m_definition->data.passes.size(); passIndex++) {
+            auto& pass = m_definition->data.passes[passIndex];
             Pipeline pipeline = GetPipelineForIndex(pass.shaderIndex);
             if (!pipeline.handle) continue;
-            auto baseCandidate = TextureInteroperability::GetFramebuffer(GetDynamicCachedAttribute(m_data.frontAttributeName, t_contextData));
+            auto baseCandidate = TextureInteroperability::GetFramebuffer(GetDynamicCachedAttribute(m_definition->data.frontAttributeName, t_contextData));
             if (!baseCandidate) {
-                baseCandidate = TextureInteroperability::GetFramebuffer(GetDynamicCachedAttribute(m_data.backAttributeName, t_contextData));
+                baseCandidate = TextureInteroperability::GetFramebuffer(GetDynamicCachedAttribute(m_definition->data.backAttributeName, t_contextData));
             }
             auto referenceFramebuffer = baseCandidate;
             if (pass.outputWidth > 0 && pass.outputHeight > 0) {
@@ -160,7 +212,7 @@ namespace Raster {
                     referenceFramebuffer->attachments[0].precision = Compositor::s_colorPrecision;
                 }
             }
-            auto framebuffer = pass.framebuffer.GetWithoutBlitting(referenceFramebuffer);
+            auto framebuffer = m_framebuffers[passIndex].GetWithoutBlitting(referenceFramebuffer);
             GPU::BindFramebuffer(framebuffer);
             GPU::BindPipeline(pipeline);
             GPU::ClearFramebuffer(0.0f, 0.0f, 0.0f, 0.0f);
@@ -174,7 +226,7 @@ namespace Raster {
                 GPU::BindFramebuffer(framebuffer);
                 GPU::BindPipeline(pipeline);
                 if (uniform.uniformName == "adsk_texture_grid") {
-                    auto textureGrid = GetTextureGrid(m_baseName);
+                    auto textureGrid = GetTextureGrid(m_definition->baseName);
                     GPU::BindTextureToShader(pipeline.fragment, "adsk_texture_grid", textureGrid, uniform.textureUnitIndex);
                     continue;
                 }
@@ -282,42 +334,32 @@ namespace Raster {
         if (m_cachedPipelines.find(t_index) != m_cachedPipelines.end()) {
             return m_cachedPipelines[t_index];
         }
-        auto shadersPath = GPU::GetShadersPath();
-        static std::vector<std::string> s_probeFormats = {
-            "matchbox/%s.glsl",
-            "matchbox/%s.%i.glsl",
-            "matchbox/%s.%02i.glsl"
-        };
-        for (auto& format : s_probeFormats) {
-            auto formattedPath = shadersPath + FormatString(format, m_baseName.c_str(), t_index);
-            // DUMP_VAR(formattedPath);
-            if (std::filesystem::exists(formattedPath)) {
-                // RASTER_LOG(formattedPath << " found");
-                auto shaderContent = ReadFile(formattedPath);
-                static std::optional<std::string> s_matchboxPreset;
-                if (!s_matchboxPreset) {
-                    s_matchboxPreset = ReadFile(shadersPath + "matchbox/matchbox_shader_base.glsl");
-                }
-                std::string generatedCode = *s_matchboxPreset;
-                generatedCode = ReplaceString(generatedCode, "MATCHBOX_CODE_GOES_HERE", shaderContent);
-                // DUMP_VAR(generatedCode);
-                int id = Randomizer::GetRandomInteger();
-                std::string newShaderPath = shadersPath + "matchbox/.matchbox" + std::to_string(id) + ".frag";
-                std::string clearPath = "matchbox/.matchbox" + std::to_string(id);
-                WriteFile(newShaderPath, generatedCode);
-                try {
-                    auto pipeline = GetCachedPipeline(clearPath);
-                    std::filesystem::remove(newShaderPath);
-                    m_cachedPipelines[t_index] = pipeline;
-                    return pipeline;
-                } catch (std::runtime_error e) {
-                    RASTER_LOG("failed to generate shader " << formattedPath);
-                    RASTER_LOG("\t" << e.what());
-                    throw std::runtime_error("terminating");
-                }
-            }
+        auto cacheName = FormatString("matchbox/%s.%i", m_definition->baseName.c_str(), t_index);
+        if (s_pipelineCache.find(cacheName) != s_pipelineCache.end()) {
+            m_cachedPipelines[t_index] = s_pipelineCache[cacheName];
+            return s_pipelineCache[cacheName];
+        }
+        auto shaderCandidate = RequestShader(t_index);
+        if (!shaderCandidate) return Pipeline();
+        auto pipeline = GPU::GeneratePipeline(GPU::s_basicShader, *shaderCandidate);
+        s_pipelineCache[cacheName] = pipeline;
+        m_cachedPipelines[t_index] = pipeline;
+        return pipeline;
+    }
+
+    std::optional<Shader> MatchboxEffectProvider::RequestShader(int t_index) {
+        auto& shaderCodes = m_definition->shaderCodes;
+        if (shaderCodes.find(t_index) == shaderCodes.end()) return std::nullopt;
+
+        try {
+            auto shaderCandidate = ShaderCompiler::RequestSource(ShaderType::Fragment, shaderCodes.at(t_index), FormatString("matchbox/%s.%i", m_definition->baseName.c_str(), t_index));
+            if (!shaderCandidate) m_compilingShaders = true;
+            return shaderCandidate;
+        } catch (std::runtime_error e) {
+            RASTER_LOG("failed to generate shader " << m_definition->baseName << " (pass " << t_index << ")");
+            RASTER_LOG("\t" << e.what());
+            throw std::runtime_error("terminating");
         }
-        return Pipeline();
     }
 
     MatchboxEffectData MatchboxEffectProvider::ParseEffectData(xml_document &t_document) {
@@ -480,18 +522,6 @@ namespace Raster {
         return result;
     }
 
-    Pipeline MatchboxEffectProvider::GetCachedPipeline(std::string t_fragmentPath) {
-        if (s_pipelineCache.find(t_fragmentPath) != s_pipelineCache.end()) {
-            return s_pipelineCache[t_fragmentPath];
-        }
-        auto pipeline = GPU::GeneratePipeline(GPU::s_basicShader, GPU::GenerateShader(ShaderType::Fragment, t_fragmentPath));
-        if (pipeline.handle) {
-            s_pipelineCache[t_fragmentPath] = pipeline;
-        }
-        return pipeline;
-    }
-
-
     Texture MatchboxEffectProvider::GetTextureGrid(std::string t_baseName) {
         if (s_textureGridsCache.find(t_baseName) != s_textureGridsCache.end()) {
             return s_textureGridsCache[t_baseName];
@@ -521,7 +551,7 @@ namespace Raster {
     }
 
     void MatchboxEffectProvider::AbstractRenderProperties() {
-        for (auto& attribute : m_data.attributes) {
+        for (auto& attribute : m_definition->data.attributes) {
             if (attribute.isSampler) continue;
             bool wasDisabled = false;
             if (!attribute.uiConditionType.empty()) {
@@ -564,7 +594,7 @@ namespace Raster {
     }
 
     std::string MatchboxEffectProvider::AbstractHeader() {
-        return m_data.metadata.name;
+        return m_definition->data.metadata.name;
     }
 
     std::string MatchboxEffectProvider::Icon() {
@@ -572,6 +602,7 @@ namespace Raster {
     }
 
     std::optional<std::string> MatchboxEffectProvider::Footer() {
+        if (m_compilingShaders) return FormatString("%s %s", ICON_FA_SPINNER, "Compiling Shaders");
         return std::nullopt;
     }
 }
@@ -5,6 +5,7 @@
 
 #include <typeindex>
 #include <unordered_map>
+#include <atomic>
 #include "common/synchronized_value.h"
 #include "common/typedefs.h"
 #include "compositor/managed_framebuffer.h"
@@ -59,7 +60,6 @@ namespace Raster {
     struct MatchboxEffectPass {
         int shaderIndex;
         int outputWidth, outputHeight;
-        ManagedFramebuffer framebuffer;
         std::string outputBitDepth;
         std::vector<MatchboxEffectUniform> uniforms;  
     };
@@ -73,8 +73,16 @@ namespace Raster {
         MatchboxEffectData() {}
     };
 
+    // parsed once when effects are registered and shared between all instances of that effect
+    struct MatchboxEffectDefinition {
+        MatchboxEffectData data;
+        std::string baseName;
+        // generated fragment shader code of each shader index that has a shader file
+        std::unordered_map<int, std::string> shaderCodes;
+    };
+
     struct MatchboxEffectProvider : public NodeBase {
-        MatchboxEffectProvider(std::string t_xmlPath);
+        MatchboxEffectProvider(std::shared_ptr<const MatchboxEffectDefinition> t_definition);
         ~MatchboxEffectProvider();
         
         AbstractPinMap AbstractExecute(ContextData& t_contextData);
@@ -92,13 +100,15 @@ namespace Raster {
 
         static MatchboxEffectMetadata ParseMetadata(xml_document& t_document);
         static MatchboxEffectData ParseEffectData(xml_document& t_document);
+        static std::shared_ptr<const MatchboxEffectDefinition> LoadDefinition(std::string t_xmlPath);
         static std::vector<MatchboxEffectAttribute> ParseAttributes(xml_document& t_document);
         static std::vector<MatchboxEffectPass> ParsePasses(xml_document& t_document);
         static std::vector<MatchboxEffectUniform> ParseUniforms(xml_node& t_node);
 
     private:
         static std::any MakeDynamicValue(xml_node& t_node);
-        static Pipeline GetCachedPipeline(std::string t_fragmentPath);
+        // returns std::nullopt while shader is compiled in background or if pass has no shader
+        std::optional<Shader> RequestShader(int t_index);
         static Texture GetTextureGrid(std::string t_baseName);
 
         template<typename T>
@@ -131,16 +141,15 @@ namespace Raster {
         };
 
         std::unordered_map<int, Pipeline> m_cachedPipelines;
+        std::atomic<bool> m_compilingShaders;
 
         std::optional<std::vector<Pipeline>> m_pipelines;
-        std::optional<std::vector<ManagedFramebuffer>> m_framebuffers;
-        std::unique_ptr<xml_document> m_document;
+        std::vector<ManagedFramebuffer> m_framebuffers;
         std::unordered_map<std::string, std::any> m_cachedValues;
 
         SynchronizedValue<std::unordered_map<std::string, std::string>> m_uiStringCache;
 
-        MatchboxEffectData m_data;
-        std::string m_baseName;
+        std::shared_ptr<const MatchboxEffectDefinition> m_definition;
         static std::unordered_map<std::string, Pipeline> s_pipelineCache;
         static std::unordered_map<std::string, Texture> s_textureGridsCache;
     };
@@ -30,18 +30,19 @@ namespace Raster {
         auto xmlIterator = std::filesystem::directory_iterator("xml/matchbox/");
         static NodeCategory matchboxCategory = NodeCategoryUtils::RegisterCategory(ICON_FA_BOX, "Matchbox Effects");
         for (auto& entry : xmlIterator) {
-            std::function<AbstractNode()> spawnFunction = [entry]() {
-                return std::make_shared<MatchboxEffectProvider>(entry.path().string());
-            };
-
-            xml_document doc;
-            if (!doc.load_file(entry.path().string().c_str())) {
+            std::shared_ptr<const MatchboxEffectDefinition> definition;
+            try {
+                definition = MatchboxEffectProvider::LoadDefinition(entry.path().string());
+            } catch (std::exception& e) {
                 print("failed to load matchbox effect '" << entry << "'");
                 continue;
             }
             print("loading matchbox effect '" << entry.path().string() << "'");
 
-            auto metadata = MatchboxEffectProvider::ParseMetadata(doc);
+            std::function<AbstractNode()> spawnFunction = [definition]() {
+                return std::make_shared<MatchboxEffectProvider>(definition);
+            };
+            auto& metadata = definition->data.metadata;
 
             NodeImplementation implementation;
             implementation.libraryName = metadata.name;
@@ -50,7 +51,7 @@ namespace Raster {
             implementation.description.prettyName = metadata.name;
             implementation.description.category = matchboxCategory;
 
-            Workspace::s_nodeImplementations.push_back(implementation);
+            Workspace::RegisterNodeImplementation(implementation);
         }
     }
 
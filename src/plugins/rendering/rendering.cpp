@@ -13,6 +13,8 @@
 #include "image/image.h"
 #include "common/dispatchers.h"
 #include "common/convolution_kernel.h"
+#include "common/ui_helpers.h"
+#include "compositor/convolution.h"
 #include "common/rendering.h"
 #include "../../ImGui/imgui_stdlib.h"
 #include "common/workspace.h"
@@ -97,9 +99,7 @@ namespace Raster {
         ImGui::BeginGroup();
             ImGui::Text("%s %s: %0.2f", ICON_FA_XMARK, Localization::GetString("MULTIPLIER").c_str(), kernel.multiplier);
             ImGui::PushItemWidth(170);
-                ImGui::DragFloat3("##matrix0", glm::value_ptr(kernel.kernel[0]));
-                ImGui::DragFloat3("##matrix1", glm::value_ptr(kernel.kernel[1]));
-                ImGui::DragFloat3("##matrix2", glm::value_ptr(kernel.kernel[2]));
+                UIHelpers::RenderConvolutionKernelEditor(kernel);
             ImGui::PopItemWidth();
         ImGui::EndGroup();
         if (GPU::s_imageConvolutionPreviewTexture.handle) {
@@ -110,16 +110,10 @@ namespace Raster {
                 if (!s_previewFramebuffer.handle) {
                     s_previewFramebuffer = GPU::GenerateFramebuffer(previewTexture.width, previewTexture.height, {GPU::GenerateTexture(previewTexture.width, previewTexture.height, 3)});
                 }
-                static std::optional<glm::mat3> s_lastRenderedKernel = std::nullopt;
-                if (!s_lastRenderedKernel || (s_lastRenderedKernel && *s_lastRenderedKernel != kernel.GetKernel())) {
-                    GPU::BindPipeline(GPU::s_kernelPreviewPipeline);
-                    GPU::BindFramebuffer(s_previewFramebuffer);
-                    GPU::ClearFramebuffer(0, 0, 0, 0);
-                    GPU::SetShaderUniform(GPU::s_kernelPreviewPipeline.fragment, "uResolution", glm::vec2(s_previewFramebuffer.width, s_previewFramebuffer.height));
-                    GPU::SetShaderUniform(GPU::s_kernelPreviewPipeline.fragment, "uKernel", kernel.GetKernel());
-                    GPU::BindTextureToShader(GPU::s_kernelPreviewPipeline.fragment, "uBase", previewTexture, 0);
-                    GPU::DrawArrays(3);
-                    s_lastRenderedKernel = kernel.GetKernel();
+                static std::optional<ConvolutionKernel> s_lastRenderedKernel = std::nullopt;
+                if (!s_lastRenderedKernel || (s_lastRenderedKernel && *s_lastRenderedKernel != kernel)) {
+                    Convolution::Apply(s_previewFramebuffer, previewTexture, kernel);
+                    s_lastRenderedKernel = kernel;
                 }
                 auto fitSize = FitRectInRect(ImVec2(100, 100), ImVec2(previewTexture.width, previewTexture.height));
                 ImGui::SetCursorPosY(ImGui::GetWindowSize().y / 2.0f - fitSize.y / 2.0f);
@@ -138,23 +132,16 @@ namespace Raster {
             ImGui::SetCursorPosX(ImGui::GetWindowSize().x / 2.0f - iFitSize.x / 2.0f);
             ImGui::PushStyleVar(ImGuiStyleVar_WindowPadding, ImVec2(0, 0));
             ImGui::BeginChild("##previewContainer", iFitSize, ImGuiChildFlags_Border);
-            if (GPU::s_imageConvolutionPreviewTexture.handle && GPU::s_kernelPreviewPipeline.handle) {
+            if (GPU::s_imageConvolutionPreviewTexture.handle) {
                 static Framebuffer s_previewFramebuffer;
                 auto& previewTexture = GPU::s_imageConvolutionPreviewTexture;
                 if (!s_previewFramebuffer.handle) {
                     s_previewFramebuffer = GPU::GenerateFramebuffer(previewTexture.width, previewTexture.height, {GPU::GenerateTexture(previewTexture.width, previewTexture.height, 3)});
                 }
-                static std::optional<glm::mat3> s_lastRenderedKernel = std::nullopt;
-                if (!s_lastRenderedKernel || (s_lastRenderedKernel && *s_lastRenderedKernel != kernel.GetKernel())) {
-                    GPU::BindPipeline(GPU::s_kernelPreviewPipeline);
-                    GPU::BindFramebuffer(s_previewFramebuffer);
-                    GPU::ClearFramebuffer(0, 0, 0, 1);
-                    GPU::SetShaderUniform(GPU::s_kernelPreviewPipeline.fragment, "uResolution", glm::vec2(s_previewFramebuffer.width, s_previewFramebuffer.height));
-                    GPU::SetShaderUniform(GPU::s_kernelPreviewPipeline.fragment, "uKernel", kernel.GetKernel());
-                    GPU::BindTextureToShader(GPU::s_kernelPreviewPipeline.fragment, "uBase", previewTexture, 0);
-                    GPU::DrawArrays(3);
-                    // RASTER_LOG("rendering kernel preview");
-                    s_lastRenderedKernel = kernel.GetKernel();
+                static std::optional<ConvolutionKernel> s_lastRenderedKernel = std::nullopt;
+                if (!s_lastRenderedKernel || (s_lastRenderedKernel && *s_lastRenderedKernel != kernel)) {
+                    Convolution::Apply(s_previewFramebuffer, previewTexture, kernel);
+                    s_lastRenderedKernel = kernel;
                 }
                 auto fitSize = FitRectInRect(dstSize, ImVec2(previewTexture.width, previewTexture.height));
                 ImGui::SetCursorPosX(ImGui::GetWindowSize().x / 2.0f - fitSize.x / 2.0f);
@@ -173,12 +160,7 @@ namespace Raster {
             if (ImGui::IsItemEdited()) isItemEdited = true;
             ImGui::PopItemWidth();
             ImGui::PushItemWidth(ImGui::GetContentRegionAvail().x);
-                ImGui::DragFloat3("##kernel0", glm::value_ptr(kernel.kernel[0]), 1);
-                if (ImGui::IsItemEdited()) isItemEdited = true;
-                ImGui::DragFloat3("##kernel1", glm::value_ptr(kernel.kernel[1]), 1);
-                if (ImGui::IsItemEdited()) isItemEdited = true;
-                ImGui::DragFloat3("##kernel2", glm::value_ptr(kernel.kernel[2]), 1);
-                if (ImGui::IsItemEdited()) isItemEdited = true;
+                if (UIHelpers::RenderConvolutionKernelEditor(kernel)) isItemEdited = true;
             ImGui::PopItemWidth();
             static bool s_searchFocused = false;
             if (ImGui::Button(FormatString("%s %s", ICON_FA_IMAGE, Localization::GetString("KERNEL_PRESETS").c_str()).c_str(), ImVec2(ImGui::GetContentRegionAvail().x, 0))) {
@@ -229,23 +211,16 @@ namespace Raster {
                 ImGui::SetCursorPosX(ImGui::GetWindowSize().x / 2.0f - iFitSize.x / 2.0f);
                 ImGui::PushStyleVar(ImGuiStyleVar_WindowPadding, ImVec2(0, 0));
                 ImGui::BeginChild("##previewContainer", iFitSize, ImGuiChildFlags_Border);
-                if (GPU::s_imageConvolutionPreviewTexture.handle && GPU::s_kernelPreviewPipeline.handle) {
+                if (GPU::s_imageConvolutionPreviewTexture.handle) {
                     static Framebuffer s_previewFramebuffer;
                     auto& previewTexture = GPU::s_imageConvolutionPreviewTexture;
                     if (!s_previewFramebuffer.handle) {
                         s_previewFramebuffer = GPU::GenerateFramebuffer(previewTexture.width, previewTexture.height, {GPU::GenerateTexture(previewTexture.width, previewTexture.height, 3)});
                     }
-                    static std::optional<glm::mat3> s_lastRenderedKernel = std::nullopt;
-                    if (!s_lastRenderedKernel || (s_lastRenderedKernel && *s_lastRenderedKernel != kernel.GetKernel())) {
-                        GPU::BindPipeline(GPU::s_kernelPreviewPipeline);
-                        GPU::BindFramebuffer(s_previewFramebuffer);
-                        GPU::ClearFramebuffer(0, 0, 0, 1);
-                        GPU::SetShaderUniform(GPU::s_kernelPreviewPipeline.fragment, "uResolution", glm::vec2(s_previewFramebuffer.width, s_previewFramebuffer.height));
-                        GPU::SetShaderUniform(GPU::s_kernelPreviewPipeline.fragment, "uKernel", kernel.GetKernel());
-                        GPU::BindTextureToShader(GPU::s_kernelPreviewPipeline.fragment, "uBase", previewTexture, 0);
-                        GPU::DrawArrays(3);
-                        // RASTER_LOG("rendering kernel preview");
-                        s_lastRenderedKernel = kernel.GetKernel();
+                    static std::optional<ConvolutionKernel> s_lastRenderedKernel = std::nullopt;
+                    if (!s_lastRenderedKernel || (s_lastRenderedKernel && *s_lastRenderedKernel != kernel)) {
+                        Convolution::Apply(s_previewFramebuffer, previewTexture, kernel);
+                        s_lastRenderedKernel = kernel;
                     }
                     auto fitSize = FitRectInRect(dstSize, ImVec2(previewTexture.width, previewTexture.height));
                     ImGui::SetCursorPosX(ImGui::GetWindowSize().x / 2.0f - fitSize.x / 2.0f);
@@ -264,9 +239,7 @@ namespace Raster {
                 ImGui::DragFloat("##multiplierDrag", &kernel.multiplier, 0.01f);
                 ImGui::PopItemWidth();
                 ImGui::PushItemWidth(ImGui::GetContentRegionAvail().x);
-                    ImGui::DragFloat3("##kernel0", glm::value_ptr(kernel.kernel[0]), 1);
-                    ImGui::DragFloat3("##kernel1", glm::value_ptr(kernel.kernel[1]), 1);
-                    ImGui::DragFloat3("##kernel2", glm::value_ptr(kernel.kernel[2]), 1);
+                    UIHelpers::RenderConvolutionKernelEditor(kernel);
                 ImGui::PopItemWidth();
             ImGui::EndChild();
 
@@ -280,7 +253,7 @@ namespace Raster {
         Dispatchers::s_stringDispatchers[std::type_index(typeid(ConvolutionKernel))] = DispatchStringConvolutionKernel;
         Dispatchers::s_propertyDispatchers[std::type_index(typeid(ConvolutionKernel))] = DispatchConvolutionKernelAttribute;
         Dispatchers::s_previewDispatchers[std::type_index(typeid(ConvolutionKernel))] = DispatchPreviewConvolutionKernelAttribute;
-        Workspace::s_nodeImplementations.push_back(
+        Workspace::RegisterNodeImplementation(
             Raster::NodeImplementation{
                 .libraryName = RASTER_PACKAGED "clamp_to_border_sampler_wrapping_constant",
                 .description = Raster::NodeDescription{
@@ -293,7 +266,7 @@ namespace Raster {
                 }
             }
         );
-        Workspace::s_nodeImplementations.push_back(
+        Workspace::RegisterNodeImplementation(
             Raster::NodeImplementation{
                 .libraryName = RASTER_PACKAGED "clamp_to_edge_sampler_wrapping_constant",
                 .description = Raster::NodeDescription{
@@ -306,7 +279,7 @@ namespace Raster {
                 }
             }
         );
-        Workspace::s_nodeImplementations.push_back(
+        Workspace::RegisterNodeImplementation(
             Raster::NodeImplementation{
                 .libraryName = RASTER_PACKAGED "mirrored_repeat_sampler_wrapping_constant",
                 .description = Raster::NodeDescription{
@@ -319,7 +292,7 @@ namespace Raster {
                 }
             }
         );
-        Workspace::s_nodeImplementations.push_back(
+        Workspace::RegisterNodeImplementation(
             Raster::NodeImplementation{
                 .libraryName = RASTER_PACKAGED "repeat_sampler_wrapping_constant",
                 .description = Raster::NodeDescription{
@@ -332,7 +305,7 @@ namespace Raster {
                 }
             }
         );
-        Workspace::s_nodeImplementations.push_back(
+        Workspace::RegisterNodeImplementation(
             Raster::NodeImplementation{
                 .libraryName = RASTER_PACKAGED "linear_sampler_filtering_constant",
                 .description = Raster::NodeDescription{
@@ -345,7 +318,7 @@ namespace Raster {
                 }
             }
         );
-        Workspace::s_nodeImplementations.push_back(
+        Workspace::RegisterNodeImplementation(
             Raster::NodeImplementation{
                 .libraryName = RASTER_PACKAGED "nearest_sampler_filtering_constant",
                 .description = Raster::NodeDescription{
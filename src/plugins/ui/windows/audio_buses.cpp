@@ -187,6 +187,24 @@ namespace Raster {
                         bool propertiesPopupMustBeOpened = ImGui::IsItemClicked(ImGuiMouseButton_Right);
                         
                         ImGui::SameLine(0, 12);
+                        if (ImGui::Button(bus.muted ? ICON_FA_VOLUME_XMARK : ICON_FA_VOLUME_HIGH)) {
+                            project.audioBusesMutex->lock();
+                            bus.muted = !bus.muted;
+                            project.audioBusesMutex->unlock();
+                        }
+                        ImGui::SetItemTooltip("%s %s", ICON_FA_VOLUME_XMARK, Localization::GetString("MUTE_AUDIO_BUS").c_str());
+                        ImGui::SameLine();
+                        ImGui::PushItemWidth(80);
+                            // routing pass reads gain concurrently, so it's only written under the buses mutex
+                            float gain = bus.gain;
+                            if (ImGui::SliderFloat("##audioBusGain", &gain, 0.0f, 2.0f, "%.2f")) {
+                                project.audioBusesMutex->lock();
+                                bus.gain = gain;
+                                project.audioBusesMutex->unlock();
+                            }
+                        ImGui::PopItemWidth();
+                        ImGui::SetItemTooltip("%s %s", ICON_FA_VOLUME_HIGH, Localization::GetString("AUDIO_BUS_GAIN").c_str());
+                        ImGui::SameLine();
                         auto redirectBusCandidate = Workspace::GetAudioBusByID(bus.redirectID);
                         std::string redirectBusText = FormatString("%s %s: %s", ICON_FA_FORWARD, Localization::GetString("REDIRECT_TO_BUS").c_str(), redirectBusCandidate.has_value() ? redirectBusCandidate.value()->name.c_str() : Localization::GetString("NONE").c_str());
                         if (ImGui::Button(redirectBusText.c_str())) {
@@ -205,6 +223,7 @@ namespace Raster {
                                 bool hasCandidates = false;
                                 for (auto& candidate : project.audioBuses) {
                                     if (candidate.id == bus.id) continue;
+                                    if (AudioBusRouting::CreatesCycle(project.audioBuses, bus.id, candidate.id)) continue;
                                     if (!s_redirectSearchFilter.empty() && LowerCase(bus.name).find(LowerCase(s_redirectSearchFilter)) == std::string::npos) continue;
                                     hasCandidates = true;
                                     if (ImGui::MenuItem(FormatString("%s %s", candidate.main ? ICON_FA_STAR " " ICON_FA_VOLUME_HIGH : ICON_FA_VOLUME_HIGH, candidate.name.c_str()).c_str())) {
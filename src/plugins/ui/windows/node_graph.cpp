@@ -10,6 +10,7 @@
 #include "asset_manager.h"
 #include "common/rendering.h"
 #include "common/layouts.h"
+#include "common/profiler.h"
 
 namespace Raster {
 
@@ -81,6 +82,18 @@ namespace Raster {
         ImGui::TextUnformatted(t_label.c_str());
     }
 
+    // node footer followed by smoothed node cost while profiler is enabled
+    static std::optional<std::string> GetNodeFooter(AbstractNode& t_node) {
+        auto footer = t_node->Footer();
+        if (!Profiler::s_enabled) return footer;
+        auto profileCandidate = Profiler::GetNodeProfile(t_node->nodeID);
+        if (!profileCandidate) return footer;
+        auto& profile = *profileCandidate;
+        std::string cost = FormatString("%s CPU %.2f ms / GPU %.2f ms", ICON_FA_STOPWATCH, profile.cpuMilliseconds, profile.gpuMilliseconds);
+        if (profile.audioMilliseconds > 0) cost += FormatString(" / %s %.2f ms", ICON_FA_VOLUME_HIGH, profile.audioMilliseconds);
+        return footer.has_value() ? *footer + "\n" + cost : cost;
+    }
+
     static unordered_dense::map<int, bool> s_inputPinCache;
 
     static void InvalidateInputPinCache(int t_pinID) {
@@ -682,7 +695,7 @@ namespace Raster {
                                     if (s_maxInputPinX + s_maxOutputPinX > s_headerSize.x) {
                                         s_headerSize.x = s_maxInputPinX + s_maxOutputPinX;
                                     }
-                                    auto footerCandidate = node->Footer();
+                                    auto footerCandidate = GetNodeFooter(node);
                                     if (footerCandidate) {
                                         auto footer = *footerCandidate;
                                         ImGui::SetWindowFontScale(0.8f);
@@ -799,7 +812,7 @@ namespace Raster {
                                     // Footer Rendering
 
                                     ImGui::SetWindowFontScale(0.8f);
-                                    auto footer = node->Footer();
+                                    auto footer = GetNodeFooter(node);
                                     if (footer.has_value()) {
                                         ImGui::Spacing();
                                         auto& actualFooter = footer.value();
@@ -1271,6 +1284,7 @@ namespace Raster {
                                                         exposedAttribute->name = attribute;
                                                         if (defaultParameter && (exposedAttribute->keyframes[0].value.type() == (*defaultParameter).type())) {
                                                             exposedAttribute->keyframes[0].value = *defaultParameter;
+                                                            AttributeBase::InvalidateKeyframes();
                                                         }
                                                         s_currentComposition->attributes.push_back(exposedAttribute);
                                                         Rendering::ForceRenderFrame();
@@ -1699,6 +1713,7 @@ namespace Raster {
                                     Camera targetCamera;
                                     targetCamera.persp = !orthoCamera;
                                     cameraAttribute->keyframes[0].value = targetCamera;
+                                    AttributeBase::InvalidateKeyframes();
                                     s_currentComposition->attributes.push_back(cameraAttribute);
                                     Workspace::GetProject().selectedAttributes = {cameraAttribute->id};
                                     ImGui::CloseCurrentPopup();
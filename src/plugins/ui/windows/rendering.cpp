@@ -4,6 +4,7 @@
 #include "common/transform2d.h"
 #include "common/dispatchers.h"
 #include "compositor/async_rendering.h"
+#include "compositor/resolution_governor.h"
 #include "common/rendering.h"
 #include "common/layouts.h"
 
@@ -132,7 +133,12 @@ namespace Raster {
                         project.customData["PreviewResolutionScale"] = 1.0f;
                     }
 
+                    if (!project.customData.contains("AdaptivePreviewResolution")) {
+                        project.customData["AdaptivePreviewResolution"] = false;
+                    }
+
                     float previewResolutionScale = project.customData["PreviewResolutionScale"];
+                    bool adaptivePreviewResolution = project.customData["AdaptivePreviewResolution"];
 
                     std::string previewResolutionName = Localization::GetString("CUSTOM");
                     if (previewResolutionScale == 1.0f) previewResolutionName = Localization::GetString("FULL");
@@ -140,7 +146,9 @@ namespace Raster {
                     else if (previewResolutionScale == 0.3f) previewResolutionName = Localization::GetString("THIRD");
                     else if (previewResolutionScale == 0.2f) previewResolutionName = Localization::GetString("QUARTER");
 
-                    if (ImGui::MenuItem(FormatString("%s %ix%i", ICON_FA_EXPAND, (int) (project.preferredResolution.x * previewResolutionScale), (int) (project.preferredResolution.y * previewResolutionScale)).c_str())) {
+                    // adaptive resolution shows the scale which is actually being rendered
+                    float displayedResolutionScale = adaptivePreviewResolution ? Compositor::previewResolutionScale : previewResolutionScale;
+                    if (ImGui::MenuItem(FormatString("%s%s %ix%i", adaptivePreviewResolution ? ICON_FA_GAUGE " " : "", ICON_FA_EXPAND, (int) (project.preferredResolution.x * displayedResolutionScale), (int) (project.preferredResolution.y * displayedResolutionScale)).c_str())) {
                         ImGui::OpenPopup("##previewResolutionPresets");
                     }
 
@@ -167,13 +175,24 @@ namespace Raster {
                             if (ImGui::IsItemEdited()) Rendering::ForceRenderFrame();
                             ImGui::EndMenu();
                         }
+                        ImGui::Separator();
+                        if (ImGui::MenuItem(FormatString("%s %s", ICON_FA_GAUGE, Localization::GetString("ADAPTIVE_RESOLUTION").c_str()).c_str(), nullptr, adaptivePreviewResolution)) {
+                            adaptivePreviewResolution = !adaptivePreviewResolution;
+                            ResolutionGovernor::Reset();
+                            Rendering::ForceRenderFrame();
+                        }
+                        ImGui::SetItemTooltip("%s %s", ICON_FA_GAUGE, Localization::GetString("ADAPTIVE_RESOLUTION_HINT").c_str());
                         ImGui::EndPopup();
                     }
                     ImGui::Separator();
 
                     project.customData["PreviewResolutionScale"] = previewResolutionScale;
+                    project.customData["AdaptivePreviewResolution"] = adaptivePreviewResolution;
 
-                    Compositor::previewResolutionScale = previewResolutionScale;
+                    // actual scale is picked by the rendering thread at the beginning of each frame
+                    ResolutionGovernor::s_maxScale = previewResolutionScale;
+                    ResolutionGovernor::s_enabled = adaptivePreviewResolution;
+                    ResolutionGovernor::UpdatePlaybackState(project.playing);
 
                     int attributesCount = 0;
                     int selectedAttributeIndex = 0;
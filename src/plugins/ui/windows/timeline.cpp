@@ -84,6 +84,8 @@ namespace Raster {
     static DragStructure s_timelineDrag;
 
     static std::unordered_map<int, float> s_legendOffsets;
+    // legend offsets measured during previous frame, used for expanded compositions which are scrolled out of view
+    static std::unordered_map<int, float> s_lastLegendOffsets;
     static ImGuiID s_legendTargetOpenTree = 0;
 
     static ImVec2 s_rootWindowSize, s_rootWindowPos;
@@ -95,6 +97,84 @@ namespace Raster {
 
     static ImVec2 s_timelineMousePos(0, 0);
 
+    // y is relative to the first row, rows are ordered top to bottom
+    struct TimelineRow {
+        int compositionIndex;
+        float y, height;
+    };
+
+    // compositions that must be submitted even when scrolled out of view (open popups, active drags)
+    static std::unordered_map<int, int> s_pinnedCompositionFrames;
+
+    static void PinComposition(int t_id) {
+        s_pinnedCompositionFrames[t_id] = ImGui::GetFrameCount();
+    }
+
+    static bool IsCompositionPinned(int t_id) {
+        if (s_pinnedCompositionFrames.empty()) return false;
+        auto iterator = s_pinnedCompositionFrames.find(t_id);
+        return iterator != s_pinnedCompositionFrames.end() && iterator->second >= ImGui::GetFrameCount() - 1;
+    }
+
+    static void PrunePinnedCompositions() {
+        for (auto iterator = s_pinnedCompositionFrames.begin(); iterator != s_pinnedCompositionFrames.end();) {
+            if (iterator->second < ImGui::GetFrameCount() - 1) iterator = s_pinnedCompositionFrames.erase(iterator);
+            else iterator++;
+        }
+    }
+
+    // indices of compositions passing timeline filters, top to bottom
+    static std::vector<int> FilterCompositions(Project& t_project) {
+        std::vector<int> indices;
+        indices.reserve(t_project.compositions.size());
+        bool filterByName = !s_compositionFilter.empty();
+        std::string lowerFilter = LowerCase(s_compositionFilter);
+        for (int i = t_project.compositions.size(); i --> 0;) {
+            auto& composition = t_project.compositions[i];
+            if (filterByName && LowerCase(composition.name).find(lowerFilter) == std::string::npos) continue;
+            if (s_colorMarkFilter != IM_COL32(0, 0, 0, 0) && composition.colorMark != s_colorMarkFilter) continue;
+            indices.push_back(i);
+        }
+        return indices;
+    }
+
+    static std::vector<TimelineRow> BuildTimelineRows(Project& t_project) {
+        std::vector<TimelineRow> rows;
+        float layerAccumulator = 0;
+        for (auto& index : FilterCompositions(t_project)) {
+            float legendOffset = 0;
+            auto legendOffsetIterator = s_legendOffsets.find(t_project.compositions[index].id);
+            if (legendOffsetIterator != s_legendOffsets.end()) legendOffset = legendOffsetIterator->second;
+            rows.push_back(TimelineRow{index, layerAccumulator, LAYER_HEIGHT + legendOffset});
+            layerAccumulator += LAYER_HEIGHT + legendOffset;
+        }
+        return rows;
+    }
+
+    // [first, last) range of rows intersecting [t_top, t_bottom]
+    static std::pair<size_t, size_t> GetVisibleRows(std::vector<TimelineRow>& t_rows, float t_top, float t_bottom) {
+        auto first = std::lower_bound(t_rows.begin(), t_rows.end(), t_top, [](const TimelineRow& row, float top) {
+            return row.y + row.height < top;
+        });
+        auto last = std::upper_bound(first, t_rows.end(), t_bottom, [](float bottom, const TimelineRow& row) {
+            return bottom < row.y;
+        });
+        return {first - t_rows.begin(), last - t_rows.begin()};
+    }
+
+    static void DrawLayerSeparator(float t_y) {
+        ImVec2 reservedCursor = ImGui::GetCursorPos();
+        ImGui::SetCursorPos({0, 0});
+        SetDrawListChannel(TimelineChannels::Separators);
+        RectBounds separatorBounds(
+            ImVec2(ImGui::GetScrollX(), t_y + LAYER_HEIGHT - LAYER_SEPARATOR / 2.0f),
+            ImVec2(ImGui::GetWindowSize().x, LAYER_SEPARATOR)
+        );
+        ImGui::GetWindowDrawList()->AddRectFilled(separatorBounds.UL, separatorBounds.BR, IM_COL32(0, 0, 0, 255));
+        SetDrawListChannel(TimelineChannels::Compositions);
+        ImGui::SetCursorPos(reservedCursor);
+    }
+
     static float precision(float f, int places) {
         float n = std::pow(10.0f, places ) ;
         return std::round(f * n) / n ;
@@ -237,6 +317,7 @@ namespace Raster {
             RenderLegend();
             RenderCompositionsEditor();
             RenderSplitter();
+            s_lastLegendOffsets.swap(s_legendOffsets);
             s_legendOffsets.clear();
             project.customData["TimelineColorFilter"] = s_colorMarkFilter;
             project.customData["TimelineSplitterState"] = s_splitterState;
@@ -405,18 +486,35 @@ namespace Raster {
             clipRectBR.x += ImGui::GetScrollX();
             clipRectBR.y += ImGui::GetScrollY();
             ImGui::GetWindowDrawList()->PushClipRect(clipRectUL, clipRectBR, true);
-            for (int i = project.compositions.size(); i --> 0;) {
-                auto& composition = project.compositions[i];
-                if (!s_compositionFilter.empty() && LowerCase(composition.name).find(LowerCase(s_compositionFilter)) == std::string::npos) continue;
-                if (s_colorMarkFilter != IM_COL32(0, 0, 0, 0) && composition.colorMark != s_colorMarkFilter) continue;
-                ImGui::SetCursorPosY(backgroundBounds.size.y + layerAccumulator);
-                RenderComposition(composition.id);
-                float legendOffset = 0;
-                if (s_legendOffsets.find(composition.id) != s_legendOffsets.end()) {
-                    legendOffset = s_legendOffsets[composition.id];
+            // only rows and time ranges which are on screen get submitted to ImGui
+            auto rows = BuildTimelineRows(project);
+            auto visibleRows = GetVisibleRows(rows, ImGui::GetScrollY() - backgroundBounds.size.y, ImGui::GetScrollY() + ImGui::GetWindowSize().y - backgroundBounds.size.y);
+            float visibleLeft = ImGui::GetScrollX();
+            float visibleRight = ImGui::GetScrollX() + ImGui::GetWindowSize().x;
+            float contentWidth = 0;
+            for (size_t r = 0; r < rows.size(); r++) {
+                auto& row = rows[r];
+                auto& composition = project.compositions[row.compositionIndex];
+                float compositionLeft = composition.GetBeginFrame() * s_pixelsPerFrame;
+                float compositionRight = std::ceil(compositionLeft) + std::ceil((composition.GetEndFrame() - composition.GetBeginFrame()) * s_pixelsPerFrame);
+                contentWidth = std::max(contentWidth, compositionRight);
+                layerAccumulator = row.y + row.height;
+
+                bool pinned = IsCompositionPinned(composition.id);
+                bool rowVisible = r >= visibleRows.first && r < visibleRows.second;
+                if (!rowVisible && !pinned) continue;
+                auto expandedIterator = s_attributesExpanded.find(composition.id);
+                bool expanded = expandedIterator != s_attributesExpanded.end() && expandedIterator->second;
+                if (!pinned && !expanded && (compositionRight < visibleLeft || compositionLeft > visibleRight)) {
+                    DrawLayerSeparator(backgroundBounds.size.y + row.y);
+                    continue;
                 }
-                layerAccumulator += LAYER_HEIGHT + legendOffset;
+                ImGui::SetCursorPosY(backgroundBounds.size.y + row.y);
+                RenderComposition(composition.id, row.compositionIndex);
             }
+            // culled compositions still define scrollable area
+            ImGui::SetCursorPos({contentWidth, backgroundBounds.size.y + layerAccumulator});
+            ImGui::Dummy({0, 0});
             ImGui::GetWindowDrawList()->PopClipRect();
             if (ImGui::IsMouseClicked(ImGuiMouseButton_Left) && project.selectedCompositions.size() > 1 && !s_anyCompositionWasPressed && ImGui::IsWindowFocused()) {
                 project.selectedCompositions = {project.selectedCompositions[0]};
@@ -456,11 +554,10 @@ namespace Raster {
         }
     }
 
-    void TimelineUI::RenderComposition(int t_id) {
-        auto compositionCandidate = Workspace::GetCompositionByID(t_id);
+    void TimelineUI::RenderComposition(int t_id, int t_compositionIndex) {
         auto& project = Workspace::s_project.value();
-        if (compositionCandidate.has_value()) {
-            auto& composition = compositionCandidate.value();
+        if (t_compositionIndex >= 0 && t_compositionIndex < project.compositions.size() && project.compositions[t_compositionIndex].id == t_id) {
+            auto composition = &project.compositions[t_compositionIndex];
             auto& selectedCompositions = project.selectedCompositions;
             ImGui::PushID(composition->id);
             ImGui::SetCursorPosX(std::ceil(composition->GetBeginFrame() * s_pixelsPerFrame));
@@ -508,15 +605,9 @@ namespace Raster {
             s_forwardBoundsDrags.resize(project.compositions.size());
             s_backwardBoundsDrags.resize(project.compositions.size());
 
-            int compositionIndex = 0;
-            for (auto& compositionIterable : project.compositions) {
-                if (compositionIterable.id == t_id) break;
-                compositionIndex++;
-            }
-
-            DragStructure& s_layerDrag = s_layerDrags[compositionIndex];
-            DragStructure& s_forwardBoundsDrag = s_forwardBoundsDrags[compositionIndex];
-            DragStructure& s_backwardBoundsDrag = s_backwardBoundsDrags[compositionIndex];
+            DragStructure& s_layerDrag = s_layerDrags[t_compositionIndex];
+            DragStructure& s_forwardBoundsDrag = s_forwardBoundsDrags[t_compositionIndex];
+            DragStructure& s_backwardBoundsDrag = s_backwardBoundsDrags[t_compositionIndex];
 
             ImGui::PopStyleVar();
             ImGui::PopStyleColor(3);
@@ -592,43 +683,58 @@ namespace Raster {
             DrawRect(forwardBoundsDrag, forwardDragColor);
             DrawRect(backwardBoundsDrag, backwardDragColor);
 
-            auto& waveformRecordsSync = WaveformManager::GetRecords();
-            waveformRecordsSync.Lock();
-            auto& waveformRecords = waveformRecordsSync.GetReference();
-            if (waveformRecords.find(t_id) != waveformRecords.end()) {
-                auto originalButtonCursor = ImGui::GetCursorPos();
+            {
+                ImVec2 originalButtonCursor = ImGui::GetCursorPos();
                 ImGui::SetCursorPos(buttonCursor);
-                auto& waveformRecord = waveformRecords[t_id];
                 ImVec2 originalCursor = ImGui::GetCursorScreenPos();
-                ImVec2 layerEndCursor = {originalCursor.x + s_rootWindowPos.x + composition->GetEndFrame() * s_pixelsPerFrame, originalCursor.y};
-                float pixelAdvance = (float) waveformRecord.precision / (float) AudioInfo::s_sampleRate * project.framerate * s_pixelsPerFrame;
-                float advanceAccumulator = 0;
+                ImGui::SetCursorPos(originalButtonCursor);
+                float visibleLeft = s_splitterState * s_rootWindowSize.x + s_rootWindowPos.x;
+                float visibleRight = ImGui::GetWindowSize().x + visibleLeft;
+                float compositionWidth = (composition->GetEndFrame() - composition->GetBeginFrame()) * s_pixelsPerFrame + s_rootWindowPos.x;
+
+                // only the on-screen slice is copied, drawing happens without holding the records lock
+                std::vector<float> waveformSlice;
+                size_t firstSample = 0;
+                float pixelAdvance = 0;
+                auto& waveformRecordsSync = WaveformManager::GetRecords();
+                waveformRecordsSync.Lock();
+                auto& waveformRecords = waveformRecordsSync.GetReference();
+                auto waveformIterator = waveformRecords.find(t_id);
+                if (waveformIterator != waveformRecords.end()) {
+                    auto& waveformRecord = waveformIterator->second;
+                    pixelAdvance = (float) waveformRecord.precision / (float) AudioInfo::s_sampleRate * project.framerate * s_pixelsPerFrame;
+                    if (pixelAdvance > 0) {
+                        firstSample = (size_t) std::max(std::ceil((visibleLeft - originalCursor.x) / pixelAdvance), 0.0f);
+                        size_t lastSample = waveformRecord.data.size();
+                        lastSample = std::min(lastSample, (size_t) std::max(std::floor(compositionWidth / pixelAdvance) + 1, 0.0f));
+                        lastSample = std::min(lastSample, (size_t) std::max(std::floor((visibleRight - originalCursor.x) / pixelAdvance) + 1, 0.0f));
+                        if (firstSample < lastSample) {
+                            waveformSlice.assign(waveformRecord.data.begin() + firstSample, waveformRecord.data.begin() + lastSample);
+                        }
+                    }
+                }
+                waveformRecordsSync.Unlock();
+
                 ImVec4 waveformColor = buttonColor * 0.7f;
                 waveformColor.w = 1.0f;
-                for (size_t i = 0; i < waveformRecord.data.size(); i++) {
-                    if (advanceAccumulator > (composition->GetEndFrame() - composition->GetBeginFrame()) * s_pixelsPerFrame + s_rootWindowPos.x) break;
-                    if (originalCursor.x < s_splitterState * s_rootWindowSize.x + s_rootWindowPos.x) {
-                        originalCursor.x += pixelAdvance;
-                        advanceAccumulator += pixelAdvance;
-                        continue;
-                    }
-                    if (originalCursor.x > ImGui::GetWindowSize().x + s_splitterState * s_rootWindowSize.x + s_rootWindowPos.x) break;
-                    float average = glm::abs(waveformRecord.data[i]);
+                auto waveformColorU32 = ImGui::GetColorU32(waveformColor);
+                // several samples may fall into a single pixel when zoomed out, draw their peak once
+                size_t samplesPerBar = pixelAdvance > 0 ? (size_t) std::max(std::ceil(1.0f / pixelAdvance), 1.0f) : 1;
+                for (size_t i = 0; i < waveformSlice.size(); i += samplesPerBar) {
+                    float average = 0;
+                    size_t barEnd = std::min(i + samplesPerBar, waveformSlice.size());
+                    for (size_t j = i; j < barEnd; j++) average = std::max(average, glm::abs(waveformSlice[j]));
                     float averageInPixels = average * LAYER_HEIGHT;
                     float invertedAverageInPixels = LAYER_HEIGHT - averageInPixels;
-                    ImVec2 bottomRight = originalCursor;
-                    bottomRight.y += LAYER_HEIGHT - 1;
-                    bottomRight.x += pixelAdvance;
                     ImVec2 upperLeft = originalCursor;
+                    upperLeft.x += (firstSample + i) * pixelAdvance;
                     upperLeft.y += invertedAverageInPixels + 1;
-                    ImGui::GetWindowDrawList()->AddRectFilled(upperLeft, bottomRight, ImGui::GetColorU32(waveformColor));
-                    // RASTER_LOG("drawing waveform");
-                    originalCursor.x += pixelAdvance;
-                    advanceAccumulator += pixelAdvance;
+                    ImVec2 bottomRight = originalCursor;
+                    bottomRight.x += (firstSample + barEnd) * pixelAdvance;
+                    bottomRight.y += LAYER_HEIGHT - 1;
+                    ImGui::GetWindowDrawList()->AddRectFilled(upperLeft, bottomRight, waveformColorU32);
                 }
-                ImGui::SetCursorPos(originalButtonCursor);
             }
-            waveformRecordsSync.Unlock();
 
             auto& bundles = Compositor::s_bundles.GetFrontValue();
             ImVec2 bundlePreviewSize(0, 0);
@@ -810,6 +916,7 @@ namespace Raster {
             } else s_layerDrag.Deactivate();
 
             s_anyLayerDragged = (s_anyLayerDragged || s_layerDrag.isActive || s_backwardBoundsDrag.isActive || s_forwardBoundsDrag.isActive) && ImGui::IsMouseDragging(ImGuiMouseButton_Left);
+            if (s_layerDrag.isActive || s_backwardBoundsDrag.isActive || s_forwardBoundsDrag.isActive) PinComposition(t_id);
 
             if (compositionHovered && ImGui::GetIO().MouseDoubleClicked[ImGuiMouseButton_Left]) {
                 ImGui::OpenPopup(FormatString("##renameComposition%i", t_id).c_str());
@@ -817,6 +924,7 @@ namespace Raster {
             static bool renameFieldFocued = false;
             PopStyleVars();
             if (ImGui::BeginPopup(FormatString("##renameComposition%i", t_id).c_str())) {
+                PinComposition(t_id);
                 if (!renameFieldFocued) {
                     ImGui::SetKeyboardFocusHere(0);
                     renameFieldFocued = true;
@@ -835,6 +943,7 @@ namespace Raster {
 
             PopStyleVars();
             if (ImGui::BeginPopup(FormatString("##compositionPopup%i", composition->id).c_str())) {
+                PinComposition(t_id);
                 RenderCompositionPopup(composition);
                 ImGui::EndPopup();
                 s_layerPopupActive = true;
@@ -1780,12 +1889,22 @@ namespace Raster {
             ImGui::SetCursorPos({0, backgroundBounds.size.y});
 
             float layerAccumulator = 0;
-            bool hasCompositionCandidates = false;
-            for (int i = project.compositions.size(); i --> 0;) {
+            PrunePinnedCompositions();
+            auto filteredCompositions = FilterCompositions(project);
+            bool hasCompositionCandidates = !filteredCompositions.empty();
+            float visibleTop = ImGui::GetScrollY() - backgroundBounds.size.y;
+            float visibleBottom = ImGui::GetScrollY() + ImGui::GetWindowSize().y - backgroundBounds.size.y;
+            for (auto& i : filteredCompositions) {
                 auto& composition = project.compositions[i];
-                if (!s_compositionFilter.empty() && LowerCase(composition.name).find(LowerCase(s_compositionFilter)) == std::string::npos) continue;
-                if (s_colorMarkFilter != IM_COL32(0, 0, 0, 0) && composition.colorMark != s_colorMarkFilter) continue;
-                hasCompositionCandidates = true;
+                // off-screen rows only advance the layout, expanded ones keep their last measured height
+                if (!IsCompositionPinned(composition.id) && (layerAccumulator > visibleBottom || layerAccumulator + LAYER_HEIGHT + s_lastLegendOffsets[composition.id] < visibleTop)) {
+                    auto expandedIterator = s_attributesExpanded.find(composition.id);
+                    if (expandedIterator != s_attributesExpanded.end() && expandedIterator->second) {
+                        s_legendOffsets[composition.id] = s_lastLegendOffsets[composition.id];
+                    }
+                    layerAccumulator += LAYER_HEIGHT + s_legendOffsets[composition.id];
+                    continue;
+                }
                 std::string compositionName = FormatString("%s %s", ICON_FA_LAYER_GROUP, composition.name.c_str());
                 ImVec2 compositionNameSize = ImGui::CalcTextSize(compositionName.c_str());
                 ImVec2 baseCursor = ImVec2{
@@ -1806,6 +1925,7 @@ namespace Raster {
                 LockCompositionDragTarget(&composition);
                 ImGui::SetItemTooltip("%s %s", composition.lockedCompositionID > 0 ? ICON_FA_LOCK : ICON_FA_LOCK_OPEN, Localization::GetString("LOCK_COMPOSITION_TO_ANOTHER_COMPOSITION").c_str());
                 if (ImGui::BeginPopup("##lockCompositionMenu")) {
+                    PinComposition(composition.id);
                     RenderLockCompositionPopup(&composition);
                     ImGui::EndPopup();
                 }
@@ -1832,6 +1952,7 @@ namespace Raster {
                     }
                     ImGui::SetItemTooltip("%s %s", ICON_FA_IMAGE, Localization::GetString("MASK_COMPOSITION").c_str());
                     if (ImGui::BeginPopup("##maskCompositionPopup")) {
+                        PinComposition(composition.id);
                         RenderMaskCompositionPopup(&composition);
                         ImGui::EndPopup();
                     }
@@ -1856,6 +1977,7 @@ namespace Raster {
                 }
                 ImGui::SetItemTooltip("%s %s", ICON_FA_PLUS, Localization::GetString("CREATE_NEW_ATTRIBUTE").c_str());
                 if (ImGui::BeginPopup(FormatString("##createAttribute%i", composition.id).c_str())) {
+                    PinComposition(composition.id);
                     RenderNewAttributePopup(&composition);
                     ImGui::EndPopup();
                 }
@@ -1866,6 +1988,7 @@ namespace Raster {
                     ImGui::OpenPopup(colorMarkEditorPopupID.c_str());
                 }
                 if (ImGui::BeginPopup(colorMarkEditorPopupID.c_str())) {
+                    PinComposition(composition.id);
                     ImGui::SeparatorText(FormatString("%s %s", ICON_FA_TAG, Localization::GetString("COLOR_MARK").c_str()).c_str());
                     static std::string s_colorMarkFilter = "";
                     ImGui::InputTextWithHint("##colorMarkFilter", FormatString("%s %s", ICON_FA_MAGNIFYING_GLASS, Localization::GetString("SEARCH_FILTER").c_str()).c_str(), &s_colorMarkFilter);
@@ -1894,6 +2017,7 @@ namespace Raster {
                     ImGui::OpenPopup(FormatString("##accessibilityPopup%i", composition.id).c_str());
                 }
                 if (ImGui::BeginPopup(FormatString("##accessibilityPopup%i", composition.id).c_str())) {
+                    PinComposition(composition.id);
                     RenderCompositionPopup(&composition, treeNodeID);
                     ImGui::EndPopup();
                 }
@@ -1918,6 +2042,7 @@ namespace Raster {
                 ImGui::SetCursorPos(reservedCursor);
 
                 if (ImGui::BeginPopup(FormatString("##compositionLegendPopup%i", composition.id).c_str())) {
+                    PinComposition(composition.id);
                     RenderCompositionPopup(&composition);
                     ImGui::EndPopup();
                 }
@@ -1942,6 +2067,9 @@ namespace Raster {
 
                 layerAccumulator += LAYER_HEIGHT + s_legendOffsets[composition.id];
             }
+            // culled compositions still define scrollable area
+            ImGui::SetCursorPos({0, backgroundBounds.size.y + layerAccumulator});
+            ImGui::Dummy({0, 0});
 
             if (!hasCompositionCandidates) {
                 UIHelpers::RenderNothingToShowText();
@@ -30,7 +30,7 @@ namespace Raster {
         static void RenderTicksBar();
         static void RenderTicks();
 
-        static void RenderComposition(int t_id);
+        static void RenderComposition(int t_id, int t_compositionIndex);
         static void RenderCompositionPopup(Composition* composition, ImGuiID t_parentTreeID = 0);
         static void RenderNewAttributePopup(Composition* t_composition, ImGuiID t_parentTreeID = 0);
         static void RenderLockCompositionPopup(Composition* t_composition);
@@ -6,7 +6,10 @@
 #include "common/sampler_settings.h"
 #include "common/transform2d.h"
 #include "compositor/managed_framebuffer.h"
+#include "compositor/domain_of_definition.h"
 #include "compositor/texture_interoperability.h"
+#include "compositor/gradient_lut.h"
+#include "gpu/shader_compiler.h"
 #include "font/IconsFontAwesome5.h"
 #include "gpu/gpu.h"
 #include "common/choice.h"
@@ -30,268 +33,269 @@ namespace Raster {
         return res;
     }
 
-    std::unordered_map<std::string, Pipeline> XMLEffectProvider::s_pipelineCache;
+    std::unordered_map<std::string, Pipeline> XMLEffectProgram::s_pipelineCache;
 
+    static std::optional<XMLEffectValueType> ParseValueType(std::string t_type) {
+        if (t_type == "float") return XMLEffectValueType::Float;
+        if (t_type == "bool") return XMLEffectValueType::Bool;
+        if (t_type == "int") return XMLEffectValueType::Int;
+        if (t_type == "glm::vec2") return XMLEffectValueType::Vec2;
+        if (t_type == "glm::vec3") return XMLEffectValueType::Vec3;
+        if (t_type == "glm::vec4") return XMLEffectValueType::Vec4;
+        return std::nullopt;
+    }
 
-    XMLEffectProvider::XMLEffectProvider(std::string t_xmlPath) {
-        NodeBase::Initialize();
-        this->m_document = std::make_unique<xml_document>();
-        auto parseResult = m_document->load_file(t_xmlPath.c_str());
-        if (!parseResult) {
-            throw std::runtime_error("could not load xml effect " + t_xmlPath);
-        }
-
-        this->m_cachedName = m_document->select_node("/effect/description").node().attribute("name").as_string();
-        this->m_cachedIcon = Font::GetIcon(m_document->select_node("/effect/icon").node().attribute("icon").as_string());
-
-        for (auto node : m_document->select_nodes("/effect/attributes/attribute")) {
-            auto attribute = node.node();
-            SetupAttribute(attribute.attribute("name").as_string(), 
-                            MakeDynamicValue(attribute.attribute("type").as_string(), attribute.attribute("value").as_string("")));
+    static std::type_index ValueTypeToTypeIndex(XMLEffectValueType t_type) {
+        switch (t_type) {
+            case XMLEffectValueType::Float: return typeid(float);
+            case XMLEffectValueType::Bool: return typeid(bool);
+            case XMLEffectValueType::Int: return typeid(int);
+            case XMLEffectValueType::Vec2: return typeid(glm::vec2);
+            case XMLEffectValueType::Vec3: return typeid(glm::vec3);
+            case XMLEffectValueType::Vec4: return typeid(glm::vec4);
         }
-        
-        for (auto node : m_document->select_nodes("/effect/pins/input")) {
-            auto pin = node.node();
-            AddInputPin(pin.attribute("name").as_string());
-        }
-
-        for (auto node : m_document->select_nodes("/effect/pins/output")) {
-            auto pin = node.node();
-            AddOutputPin(pin.attribute("name").as_string());
-        }
-
-        auto framebuffersNode = m_document->select_node("/effect/framebuffers");
-        auto framebuffersAttribute = framebuffersNode.node();
-        int framebuffersCount = framebuffersAttribute.attribute("count").as_int();
-        m_framebuffers = std::vector<ManagedFramebuffer>(framebuffersCount);
-    
-        auto gradientsNode = m_document->select_node("/effect/gradients1d");
-        auto gradientsAttribute = gradientsNode.node();
-        int gradientsCount = gradientsAttribute.attribute("count").as_int();
-        m_gradientBuffers = std::vector<std::optional<ArrayBuffer>>(gradientsCount);
-
-        auto samplerSettingsNode = m_document->select_node("/effect/samplers");
-        auto samplerSettingsAttribute = samplerSettingsNode.node();
-        int samplerSettingsCount = samplerSettingsAttribute.attribute("count").as_int();
-        m_samplers = std::vector<Sampler>(samplerSettingsCount);
+        return typeid(void);
     }
 
-    XMLEffectProvider::~XMLEffectProvider() {
-        for (auto& gradientBuffer : m_gradientBuffers) {
-            if (gradientBuffer) {
-                GPU::DestroyBuffer(*gradientBuffer);
-            }
-        }
+    std::shared_ptr<const XMLEffectProgram> XMLEffectProgram::Compile(xml_document& t_document) {
+        auto program = std::make_shared<XMLEffectProgram>();
 
-        for (auto& sampler : m_samplers) {
-            if (sampler.handle) GPU::DestroySampler(sampler);
-        }
-    }
+        program->name = t_document.select_node("/effect/description").node().attribute("name").as_string();
+        program->icon = Font::GetIcon(t_document.select_node("/effect/icon").node().attribute("icon").as_string());
 
-    static std::string GetNameByType(std::type_index t_index) {
-        if (Workspace::s_typeNames.find(t_index) != Workspace::s_typeNames.end()) {
-            return Workspace::s_typeNames[t_index];
+        for (auto node : t_document.select_nodes("/effect/attributes/attribute")) {
+            auto attribute = node.node();
+            XMLEffectAttribute compiledAttribute;
+            compiledAttribute.name = attribute.attribute("name").as_string();
+            compiledAttribute.defaultValue = MakeDynamicValue(attribute.attribute("type").as_string(), attribute.attribute("value").as_string(""));
+            program->attributes.push_back(compiledAttribute);
         }
-        return t_index.name();
-    } 
 
-    AbstractPinMap XMLEffectProvider::AbstractExecute(ContextData& t_contextData) {
-        AbstractPinMap result = {};
-        if (m_pipelines.empty()) {
-            for (auto node : m_document->select_nodes("/effect/shaders/shader")) {
-                auto shader = node.node();
-                std::string vertexPath = shader.attribute("vertex").as_string();
-                std::string fragmentPath = shader.attribute("fragment").as_string();
-                DUMP_VAR(fragmentPath);
-                if (s_pipelineCache.find(vertexPath + fragmentPath) != s_pipelineCache.end()) {
-                    m_pipelines.push_back(s_pipelineCache[vertexPath + fragmentPath]);
-                } else {
-                    Pipeline compiledShader = GPU::GeneratePipeline(
-                        vertexPath == "basic" ? GPU::s_basicShader : GPU::GenerateShader(ShaderType::Vertex, vertexPath), 
-                        GPU::GenerateShader(ShaderType::Fragment, fragmentPath));
-                    s_pipelineCache[vertexPath + fragmentPath] = compiledShader;
-                    m_pipelines.push_back(compiledShader);
-                }
-            }
+        for (auto node : t_document.select_nodes("/effect/pins/input")) {
+            program->inputPins.push_back(node.node().attribute("name").as_string());
         }
 
-        for (auto& sampler : m_samplers) {
-            if (!sampler.handle) {
-                sampler = GPU::GenerateSampler();
-            }
+        for (auto node : t_document.select_nodes("/effect/pins/output")) {
+            program->outputPins.push_back(node.node().attribute("name").as_string());
         }
 
-        std::vector<Framebuffer> swappedFramebuffers(m_framebuffers.size());
-
-        auto renderingNode = m_document->select_node("/effect/rendering").node();
-        int resultFramebuffer = renderingNode.attribute("result").as_int();
+        program->framebuffersCount = t_document.select_node("/effect/framebuffers").node().attribute("count").as_int();
+        program->gradientsCount = t_document.select_node("/effect/gradients1d").node().attribute("count").as_int();
+        program->samplersCount = t_document.select_node("/effect/samplers").node().attribute("count").as_int();
 
-        m_cachedValues.clear();
+        for (auto node : t_document.select_nodes("/effect/shaders/shader")) {
+            auto shader = node.node();
+            XMLEffectShader compiledShader;
+            compiledShader.vertexPath = shader.attribute("vertex").as_string();
+            compiledShader.fragmentPath = shader.attribute("fragment").as_string();
+            program->shaders.push_back(compiledShader);
+        }
 
-        std::vector<int> targetUnboundSamplers;
+        auto renderingNode = t_document.select_node("/effect/rendering").node();
+        program->resultFramebuffer = renderingNode.attribute("result").as_int();
+        program->resultPin = renderingNode.attribute("pin").as_string();
 
         for (auto pass : renderingNode.children("pass")) {
-            int targetFramebuffer = pass.attribute("framebuffer").as_int();
-            int targetShader = pass.attribute("shader").as_int();
-            std::string baseFramebuffer = pass.attribute("base").as_string();
+            XMLEffectPass compiledPass;
+            compiledPass.framebufferIndex = pass.attribute("framebuffer").as_int();
+            compiledPass.shaderIndex = pass.attribute("shader").as_int();
+            compiledPass.baseAttributeName = pass.attribute("base").as_string();
+
             std::string clearColorRawString = pass.attribute("clearColor").as_string();
-            auto clearColorStr = SplitString(clearColorRawString, ";");
-            glm::vec4 targetClearColor = glm::vec4(1);
             if (!clearColorRawString.empty()) {
-                targetClearColor = glm::vec4(std::stof(clearColorStr[0]), std::stof(clearColorStr[1]), std::stof(clearColorStr[2]), std::stof(clearColorStr[3]));
+                auto clearColorStr = SplitString(clearColorRawString, ";");
+                compiledPass.clearColor = glm::vec4(std::stof(clearColorStr[0]), std::stof(clearColorStr[1]), std::stof(clearColorStr[2]), std::stof(clearColorStr[3]));
             }
-            
-            std::optional<Framebuffer> baseFramebufferCandidate = TextureInteroperability::GetFramebuffer(GetDynamicCachedAttribute(baseFramebuffer, t_contextData));
-            auto& framebuffer = swappedFramebuffers.at(targetFramebuffer);
-            framebuffer = m_framebuffers.at(targetFramebuffer).Get(baseFramebufferCandidate);
 
-            GPU::BindPipeline(m_pipelines.at(targetShader));
-            GPU::BindFramebuffer(framebuffer);
-            if (!clearColorRawString.empty())
-                GPU::ClearFramebuffer(targetClearColor.r, targetClearColor.g, targetClearColor.g, targetClearColor.a);
+            if (compiledPass.framebufferIndex < 0 || compiledPass.framebufferIndex >= program->framebuffersCount) {
+                throw std::runtime_error("pass refers to a non-existent framebuffer " + std::to_string(compiledPass.framebufferIndex));
+            }
+            if (compiledPass.shaderIndex < 0 || compiledPass.shaderIndex >= program->shaders.size()) {
+                throw std::runtime_error("pass refers to a non-existent shader " + std::to_string(compiledPass.shaderIndex));
+            }
+
+            for (auto uniform : pass.children("uniform")) {
+                XMLEffectUniform compiledUniform;
+                compiledUniform.uniformName = uniform.attribute("name").as_string();
+                compiledUniform.vertexStage = std::string(uniform.attribute("stage").as_string()) == "vertex";
 
-            for (auto& uniform : pass.children("uniform")) {
-                std::string uniformName = uniform.attribute("name").as_string();
-                std::string stage = uniform.attribute("stage").as_string();
-                Shader& shaderStage = stage == "vertex" ? m_pipelines.at(targetShader).vertex : m_pipelines.at(targetShader).fragment;
                 for (auto value : uniform.children("value")) {
-                    std::string attributeName = value.attribute("attribute").as_string();
                     std::string type = value.attribute("type").as_string();
-
-                    std::optional<std::any> attributeCandidate = GetDynamicCachedAttribute(attributeName, t_contextData);
-                    GPU::BindPipeline(m_pipelines.at(targetShader));
-                    GPU::BindFramebuffer(framebuffer);
-                    if (attributeCandidate) {
-                        auto& attributeValue = *attributeCandidate;
-                        if (Workspace::GetTypeName(attributeValue) != type) {
-                            for (auto& conversionDispatcher : Dispatchers::s_conversionDispatchers) {
-                                if (conversionDispatcher.from == attributeValue.type() && GetNameByType(conversionDispatcher.to) == type) {
-                                    auto conversionCandidate = conversionDispatcher.function(attributeValue);
-                                    if (conversionCandidate) {
-                                        attributeValue = *conversionCandidate;
-                                    }
-                                }
-                            }
+                    auto valueTypeCandidate = ParseValueType(type);
+                    if (!valueTypeCandidate) {
+                        RASTER_LOG("unsupported uniform type '" << type << "' in '" << program->name << "'");
+                        continue;
+                    }
+                    XMLEffectValueBinding binding;
+                    binding.attributeName = value.attribute("attribute").as_string();
+                    binding.valueType = *valueTypeCandidate;
+                    binding.type = ValueTypeToTypeIndex(binding.valueType);
+                    binding.pixelSpace = value.attribute("pixelSpace").as_bool();
+                    for (auto& conversionDispatcher : Dispatchers::s_conversionDispatchers) {
+                        if (conversionDispatcher.to == binding.type) {
+                            binding.conversions.push_back(conversionDispatcher);
                         }
-
-#define UNIFORM_CLAUSE(t_real_type, t_str_type) \
-    if (attributeValue.type() == typeid(t_real_type) && t_str_type == type)  { \
-        GPU::SetShaderUniform(shaderStage, uniformName, std::any_cast<t_real_type>(attributeValue)); \
-    }
-                    
-                        UNIFORM_CLAUSE(float, "float");
-                        UNIFORM_CLAUSE(bool, "bool");
-                        UNIFORM_CLAUSE(int, "int");
-                        UNIFORM_CLAUSE(glm::vec2, "glm::vec2");
-                        UNIFORM_CLAUSE(glm::vec3, "glm::vec3");
-                        UNIFORM_CLAUSE(glm::vec4, "glm::vec4");
                     }
+                    compiledUniform.values.push_back(binding);
                 }
 
                 for (auto resolution : uniform.children("resolution")) {
-                    int resolutionFramebuffer = resolution.attribute("framebuffer").as_int();
-                    auto& targetResolutionFramebuffer = swappedFramebuffers[resolutionFramebuffer];
-                    GPU::SetShaderUniform(shaderStage, uniformName, glm::vec2(targetResolutionFramebuffer.width, targetResolutionFramebuffer.height));
+                    compiledUniform.resolutions.push_back(resolution.attribute("framebuffer").as_int());
                 }
+                compiledUniform.previewScale = (bool) uniform.child("previewScale");
 
                 for (auto screenSpaceRendering : uniform.children("screenSpaceRendering")) {
-                    std::string framebufferAttributeName = screenSpaceRendering.attribute("attribute").as_string();
-                    std::string overrideAttributeName = screenSpaceRendering.attribute("override").as_string();
-                    std::optional<Framebuffer> framebufferCandidate = GetCachedAttribute<Framebuffer>(framebufferAttributeName, t_contextData);
-                    if (!framebufferCandidate) continue;
-                    auto& targetScreenSpaceFramebuffer = *framebufferCandidate;
-                    bool useScreenSpaceRendering = !(targetScreenSpaceFramebuffer.attachments.size() >= 2);
-                    auto overriderCandidate = GetCachedAttribute<bool>(overrideAttributeName, t_contextData);
-                    if (overriderCandidate && *overriderCandidate) {
-                        useScreenSpaceRendering = true;
-                    }
-                    GPU::SetShaderUniform(shaderStage, uniformName, useScreenSpaceRendering);
+                    XMLEffectScreenSpaceBinding binding;
+                    binding.attributeName = screenSpaceRendering.attribute("attribute").as_string();
+                    binding.overrideAttributeName = screenSpaceRendering.attribute("override").as_string();
+                    compiledUniform.screenSpaceRenderings.push_back(binding);
                 }
 
                 for (auto attachment : uniform.children("attachment")) {
-                    int attachmentIndex = attachment.attribute("index").as_int();
-                    int unitIndex = attachment.attribute("unit").as_int();
-                    std::string availabilityUniformName = attachment.attribute("availability").as_string();
-                    auto attributeName = attachment.attribute("attribute").as_string();
-                    std::optional<Framebuffer> attributeCandidate = TextureInteroperability::GetFramebuffer(GetDynamicCachedAttribute(attributeName, t_contextData));
-                    GPU::BindPipeline(m_pipelines.at(targetShader));
-                    GPU::BindFramebuffer(framebuffer);
-                    bool wasBound = false;
-                    if (attributeCandidate) {
-                        auto& attributeValue = *attributeCandidate;
-                        if (attachmentIndex >= 0 && attachmentIndex < attributeValue.attachments.size()) {
-                            GPU::BindTextureToShader(shaderStage, uniformName, attributeValue.attachments.at(attachmentIndex), unitIndex);
-                            wasBound = true;
-                        }
-                    }
+                    XMLEffectAttachmentBinding binding;
+                    binding.attributeName = attachment.attribute("attribute").as_string();
+                    binding.availabilityUniformName = attachment.attribute("availability").as_string();
+                    binding.attachmentIndex = attachment.attribute("index").as_int();
+                    binding.unitIndex = attachment.attribute("unit").as_int();
+                    compiledUniform.attachments.push_back(binding);
+                }
+
+                compiledPass.uniforms.push_back(compiledUniform);
+            }
+
+            for (auto sampler : pass.children("sampler")) {
+                XMLEffectSlotBinding binding;
+                binding.attributeName = sampler.attribute("attribute").as_string();
+                binding.slotIndex = sampler.attribute("slot").as_int();
+                binding.unitIndex = sampler.attribute("unit").as_int();
+                compiledPass.samplers.push_back(binding);
+            }
+
+            for (auto gradient : pass.children("gradient1d")) {
+                XMLEffectGradientBinding binding;
+                binding.attributeName = gradient.attribute("attribute").as_string();
+                binding.slotIndex = gradient.attribute("slot").as_int();
+                binding.unitIndex = gradient.attribute("unit").as_int();
+                binding.uniformName = gradient.attribute("uniform").as_string();
+                compiledPass.gradients.push_back(binding);
+            }
+
+            for (auto draw : pass.children("draw")) {
+                compiledPass.draws.push_back(draw.attribute("count").as_int());
+            }
 
-                    if (!availabilityUniformName.empty()) GPU::SetShaderUniform(shaderStage, availabilityUniformName, wasBound);
+            auto domainNode = pass.child("domain");
+            if (domainNode) {
+                XMLEffectDomain domain;
+                domain.attributeName = domainNode.attribute("attribute").as_string();
+                for (auto expand : domainNode.children("expand")) {
+                    XMLEffectDomainExpansion expansion;
+                    expansion.attributeName = expand.attribute("attribute").as_string();
+                    expansion.scale = expand.attribute("scale").as_float(1.0f);
+                    expansion.pixelSpace = expand.attribute("pixelSpace").as_bool();
+                    expansion.divideByAspect = expand.attribute("divideByAspect").as_bool();
+                    domain.expansions.push_back(expansion);
                 }
+                compiledPass.domain = domain;
             }
 
-            for (auto& sampler : pass.children("sampler")) {
-                auto attributeName = sampler.attribute("attribute").as_string();
-                auto slotIndex = sampler.attribute("slot").as_int();
-                auto unitIndex = sampler.attribute("unit").as_int();
-                auto samplerSettingsCandidate = GetCachedAttribute<SamplerSettings>(attributeName, t_contextData);
+            program->passes.push_back(compiledPass);
+        }
 
-                if (!samplerSettingsCandidate) continue;
-                if (slotIndex < 0 || slotIndex >= m_samplers.size()) continue;
-                auto samplerObject = m_samplers[slotIndex];
-                auto& samplerSettings = *samplerSettingsCandidate;
-                GPU::SetSamplerTextureFilteringMode(samplerObject, TextureFilteringOperation::Magnify, samplerSettings.filteringMode);
-                GPU::SetSamplerTextureFilteringMode(samplerObject, TextureFilteringOperation::Minify, samplerSettings.filteringMode);
+        if (!program->passes.empty() && (program->resultFramebuffer < 0 || program->resultFramebuffer >= program->framebuffersCount)) {
+            throw std::runtime_error("result refers to a non-existent framebuffer " + std::to_string(program->resultFramebuffer));
+        }
 
-                GPU::SetSamplerTextureWrappingMode(samplerObject, TextureWrappingAxis::S, samplerSettings.wrappingMode);
-                GPU::SetSamplerTextureWrappingMode(samplerObject, TextureWrappingAxis::T, samplerSettings.wrappingMode);
+        for (auto node : t_document.select_nodes("/effect/properties/property")) {
+            auto property = node.node();
+            XMLEffectProperty compiledProperty;
+            compiledProperty.name = property.attribute("name").as_string();
 
-                GPU::BindSampler(samplerObject, unitIndex);
-                targetUnboundSamplers.push_back(unitIndex);
+            for (auto formatStringAttribute : property.children("formatString")) {
+                compiledProperty.metadata.push_back(FormatStringMetadata(formatStringAttribute.attribute("format").as_string()));
             }
 
-            for (auto& gradient : pass.children("gradient1d")) {
-                auto attributeName = gradient.attribute("attribute").as_string();
-                auto slotIndex = gradient.attribute("slot").as_int();
-                auto unitIndex = gradient.attribute("unit").as_int();
+            for (auto sliderRangeAttribute : property.children("sliderRange")) {
+                compiledProperty.metadata.push_back(SliderRangeMetadata(
+                    sliderRangeAttribute.attribute("min").as_float(),
+                    sliderRangeAttribute.attribute("max").as_float()
+                ));
+            }
 
-                if (slotIndex < 0 || slotIndex >= m_gradientBuffers.size()) continue;
-                auto& gradientBuffer = m_gradientBuffers[slotIndex];
-                auto gradientCandidate = GetCachedAttribute<Gradient1D>(attributeName, t_contextData);
-                if (gradientCandidate) {
-                    auto& gradient = *gradientCandidate;
-                    int gradientBufferSize = sizeof(float) + sizeof(float) * 5 * gradient.stops.size();
-                    char* gradientBufferArray = new char[gradientBufferSize];
-                    gradient.FillToBuffer(gradientBufferArray);
-                    if (!gradientBuffer.has_value()) {
-                        gradientBuffer = GPU::GenerateBuffer(gradientBufferSize, ArrayBufferType::ShaderStorageBuffer, ArrayBufferUsage::Dynamic);
-                    }
-                    auto& gradientBufferRaw = gradientBuffer.value();
-                    if (gradientBufferRaw.size != gradientBufferSize) {
-                        GPU::DestroyBuffer(gradientBufferRaw);
-                        gradientBuffer = GPU::GenerateBuffer(gradientBufferSize, ArrayBufferType::ShaderStorageBuffer, ArrayBufferUsage::Dynamic);
-                    }
-                    GPU::FillBuffer(gradientBufferRaw, 0, gradientBufferSize, gradientBufferArray);
-                    GPU::BindBufferBase(gradientBufferRaw, unitIndex);
-                    delete[] gradientBufferArray;
-                }
+            for (auto sliderStepAttribute : property.children("sliderStep")) {
+                compiledProperty.metadata.push_back(SliderStepMetadata(
+                    sliderStepAttribute.attribute("step").as_float()
+                ));
             }
 
-            for (auto& draw : pass.children("draw")) {
-                auto count = draw.attribute("count").as_int();
-                GPU::DrawArrays(count);
+            for (auto sliderBaseAttribute : property.children("sliderBase")) {
+                compiledProperty.metadata.push_back(SliderBaseMetadata(
+                    sliderBaseAttribute.attribute("base").as_float()
+                ));
             }
+
+            for (auto iconAttribute : property.children("icon")) {
+                compiledProperty.metadata.push_back(IconMetadata(
+                    Font::GetIcon(iconAttribute.attribute("icon").as_string())
+                ));
+            }
+
+            program->properties.push_back(compiledProperty);
         }
 
-        for (auto& unboundSampler : targetUnboundSamplers) {
-            GPU::BindSampler(std::nullopt, unboundSampler);
-        } 
+        return program;
+    }
 
-        TryAppendAbstractPinMap(result, renderingNode.attribute("pin").as_string(), swappedFramebuffers.at(resultFramebuffer));
+    std::optional<Pipeline> XMLEffectProgram::GetCachedPipeline(std::string t_vertexPath, std::string t_fragmentPath) {
+        auto key = t_vertexPath + t_fragmentPath;
+        if (s_pipelineCache.find(key) != s_pipelineCache.end()) {
+            return s_pipelineCache[key];
+        }
+        auto vertexCandidate = t_vertexPath == "basic" ? std::optional<Shader>(GPU::s_basicShader) : ShaderCompiler::Request(ShaderType::Vertex, t_vertexPath);
+        auto fragmentCandidate = ShaderCompiler::Request(ShaderType::Fragment, t_fragmentPath);
+        if (!vertexCandidate || !fragmentCandidate) return std::nullopt;
+        Pipeline compiledShader = GPU::GeneratePipeline(*vertexCandidate, *fragmentCandidate);
+        s_pipelineCache[key] = compiledShader;
+        return compiledShader;
+    }
 
-        return result;
+    void XMLEffectProgram::RequestShaders() const {
+        for (auto& shader : shaders) {
+            if (shader.vertexPath != "basic") ShaderCompiler::Request(ShaderType::Vertex, shader.vertexPath);
+            ShaderCompiler::Request(ShaderType::Fragment, shader.fragmentPath);
+        }
     }
 
-    std::any XMLEffectProvider::MakeDynamicValue(std::string t_type, std::string t_value) {
+    const XMLEffectLinkage* XMLEffectProgram::Link() const {
+        std::lock_guard<std::mutex> lock(m_linkMutex);
+        if (m_linkage) return &*m_linkage;
+
+        XMLEffectLinkage linkage;
+        for (auto& shader : shaders) {
+            auto pipelineCandidate = GetCachedPipeline(shader.vertexPath, shader.fragmentPath);
+            if (!pipelineCandidate) return nullptr;
+            linkage.pipelines.push_back(*pipelineCandidate);
+        }
+
+        for (auto& pass : passes) {
+            auto& pipeline = linkage.pipelines.at(pass.shaderIndex);
+            XMLEffectLinkedPass linkedPass;
+            for (auto& uniform : pass.uniforms) {
+                const Shader& shaderStage = uniform.vertexStage ? pipeline.vertex : pipeline.fragment;
+                XMLEffectLinkedUniform linkedUniform;
+                linkedUniform.location = GPU::GetShaderUniformLocation(shaderStage, uniform.uniformName);
+                for (auto& attachment : uniform.attachments) {
+                    linkedUniform.availabilityLocations.push_back(attachment.availabilityUniformName.empty() ? -1 : GPU::GetShaderUniformLocation(shaderStage, attachment.availabilityUniformName));
+                }
+                linkedPass.uniforms.push_back(linkedUniform);
+            }
+            linkage.passes.push_back(linkedPass);
+        }
+        m_linkage = linkage;
+        return &*m_linkage;
+    }
+
+    std::any XMLEffectProgram::MakeDynamicValue(std::string t_type, std::string t_value) {
         if (t_type == "float") {
             if (t_value.empty()) return 0.0f;
             return std::stof(t_value.c_str());
@@ -345,42 +349,327 @@ namespace Raster {
         throw std::runtime_error("could not make dynamic value from " + t_type + " " + t_value);
     }
 
-    void XMLEffectProvider::AbstractRenderProperties() {
-        for (auto node : m_document->select_nodes("/effect/properties/property")) {
-            auto property = node.node();
-            auto propertyName = property.attribute("name").as_string();
-            std::vector<std::any> metadata;
+    XMLEffectProvider::XMLEffectProvider(std::shared_ptr<const XMLEffectProgram> t_program) {
+        NodeBase::Initialize();
+        this->m_program = t_program;
 
-            for (auto formatStringAttribute : property.children("formatString")) {
-                metadata.push_back(FormatStringMetadata(formatStringAttribute.attribute("format").as_string()));
+        for (auto& attribute : m_program->attributes) {
+            SetupAttribute(attribute.name, attribute.defaultValue);
+        }
+        
+        for (auto& pin : m_program->inputPins) {
+            AddInputPin(pin);
+        }
+
+        for (auto& pin : m_program->outputPins) {
+            AddOutputPin(pin);
+        }
+
+        m_framebuffers = std::vector<ManagedFramebuffer>(m_program->framebuffersCount);
+        m_swappedFramebuffers = std::vector<Framebuffer>(m_program->framebuffersCount);
+        m_gradientBuffers = std::vector<std::optional<ArrayBuffer>>(m_program->gradientsCount);
+        m_samplers = std::vector<Sampler>(m_program->samplersCount);
+        m_compilingShaders = false;
+
+        // projects instantiate all of their nodes when opened, so shaders are ready by the time they're rendered
+        m_program->RequestShaders();
+    }
+
+    XMLEffectProvider::~XMLEffectProvider() {
+        for (auto& gradientBuffer : m_gradientBuffers) {
+            if (gradientBuffer) {
+                GPU::DestroyBuffer(*gradientBuffer);
             }
+        }
 
-            for (auto sliderRangeAttribute : property.children("sliderRange")) {
-                metadata.push_back(SliderRangeMetadata(
-                    sliderRangeAttribute.attribute("min").as_float(),
-                    sliderRangeAttribute.attribute("max").as_float()
-                ));
+        for (auto& sampler : m_samplers) {
+            if (sampler.handle) GPU::DestroySampler(sampler);
+        }
+    }
+
+    static void SetValueUniform(const Shader& t_shader, int t_location, XMLEffectValueType t_type, std::any& t_value) {
+        switch (t_type) {
+            case XMLEffectValueType::Float: {
+                GPU::SetShaderUniform(t_shader, t_location, std::any_cast<float>(t_value));
+                break;
+            }
+            case XMLEffectValueType::Bool: {
+                GPU::SetShaderUniform(t_shader, t_location, (int) std::any_cast<bool>(t_value));
+                break;
             }
+            case XMLEffectValueType::Int: {
+                GPU::SetShaderUniform(t_shader, t_location, std::any_cast<int>(t_value));
+                break;
+            }
+            case XMLEffectValueType::Vec2: {
+                GPU::SetShaderUniform(t_shader, t_location, std::any_cast<glm::vec2>(t_value));
+                break;
+            }
+            case XMLEffectValueType::Vec3: {
+                GPU::SetShaderUniform(t_shader, t_location, std::any_cast<glm::vec3>(t_value));
+                break;
+            }
+            case XMLEffectValueType::Vec4: {
+                GPU::SetShaderUniform(t_shader, t_location, std::any_cast<glm::vec4>(t_value));
+                break;
+            }
+        }
+    }
 
-            for (auto sliderStepAttribute : property.children("sliderStep")) {
-                metadata.push_back(SliderStepMetadata(
-                    sliderStepAttribute.attribute("step").as_float()
-                ));
+    // keeps pixel-space parameters proportional to the image while preview is rendered in reduced resolution
+    static void ScalePixelSpaceValue(XMLEffectValueType t_type, std::any& t_value) {
+        float scale = Compositor::previewResolutionScale;
+        if (scale == 1.0f) return;
+        switch (t_type) {
+            case XMLEffectValueType::Float: {
+                t_value = std::any_cast<float>(t_value) * scale;
+                break;
             }
+            case XMLEffectValueType::Int: {
+                int value = std::any_cast<int>(t_value);
+                t_value = value == 0 ? 0 : std::max((int) std::round(value * scale), 1);
+                break;
+            }
+            case XMLEffectValueType::Vec2: {
+                t_value = std::any_cast<glm::vec2>(t_value) * scale;
+                break;
+            }
+            case XMLEffectValueType::Vec3: {
+                t_value = std::any_cast<glm::vec3>(t_value) * scale;
+                break;
+            }
+            case XMLEffectValueType::Vec4: {
+                t_value = std::any_cast<glm::vec4>(t_value) * scale;
+                break;
+            }
+            default: break;
+        }
+    }
 
-            for (auto sliderBaseAttribute : property.children("sliderBase")) {
-                metadata.push_back(SliderBaseMetadata(
-                    sliderBaseAttribute.attribute("base").as_float()
-                ));
+    AbstractPinMap XMLEffectProvider::AbstractExecute(ContextData& t_contextData) {
+        AbstractPinMap result = {};
+        auto& program = *m_program;
+        m_cachedValues.clear();
+
+        auto linkagePointer = program.Link();
+        m_compilingShaders = linkagePointer == nullptr;
+        if (!linkagePointer) {
+            // effect is bypassed until its shaders are compiled
+            if (!program.passes.empty()) {
+                auto baseCandidate = TextureInteroperability::GetFramebuffer(GetDynamicCachedAttribute(program.passes[0].baseAttributeName, t_contextData));
+                if (baseCandidate) TryAppendAbstractPinMap(result, program.resultPin, *baseCandidate);
             }
+            return result;
+        }
+        auto& linkage = *linkagePointer;
 
-            for (auto iconAttribute : property.children("icon")) {
-                metadata.push_back(IconMetadata(
-                    Font::GetIcon(iconAttribute.attribute("icon").as_string())
-                ));
+        for (auto& sampler : m_samplers) {
+            if (!sampler.handle) {
+                sampler = GPU::GenerateSampler();
+            }
+        }
+
+        std::vector<int> targetUnboundSamplers;
+
+        for (int passIndex = 0; passIndex < program.passes.size(); passIndex++) {
+            auto& pass = program.passes[passIndex];
+            auto& linkedPass = linkage.passes[passIndex];
+            auto& pipeline = linkage.pipelines[pass.shaderIndex];
+            
+            std::optional<Framebuffer> baseFramebufferCandidate = TextureInteroperability::GetFramebuffer(GetDynamicCachedAttribute(pass.baseAttributeName, t_contextData));
+            auto& managedFramebuffer = m_framebuffers[pass.framebufferIndex];
+            auto& framebuffer = m_swappedFramebuffers[pass.framebufferIndex];
+            framebuffer = managedFramebuffer.Get(baseFramebufferCandidate);
+
+            auto passRegion = GetPassRegion(pass, framebuffer, t_contextData);
+            if (passRegion) passRegion = passRegion->Union(managedFramebuffer.GetBaseRegion());
+            bool passScissored = passRegion && !passRegion->Covers(framebuffer.width, framebuffer.height);
+
+            GPU::BindPipeline(pipeline);
+            GPU::BindFramebuffer(framebuffer);
+            if (passScissored) GPU::SetScissorRect(passRegion->ToScissor());
+            if (pass.clearColor) {
+                auto& clearColor = *pass.clearColor;
+                GPU::ClearFramebuffer(clearColor.r, clearColor.g, clearColor.b, clearColor.a);
             }
 
-            RenderAttributeProperty(propertyName, metadata);
+            for (int uniformIndex = 0; uniformIndex < pass.uniforms.size(); uniformIndex++) {
+                auto& uniform = pass.uniforms[uniformIndex];
+                auto& linkedUniform = linkedPass.uniforms[uniformIndex];
+                const Shader& shaderStage = uniform.vertexStage ? pipeline.vertex : pipeline.fragment;
+
+                for (auto& value : uniform.values) {
+                    std::optional<std::any> attributeCandidate = GetDynamicCachedAttribute(value.attributeName, t_contextData);
+                    if (!attributeCandidate) continue;
+                    // fetching attributes can execute other nodes, so the pipeline state must be restored
+                    GPU::BindPipeline(pipeline);
+                    GPU::BindFramebuffer(framebuffer);
+                    auto& attributeValue = *attributeCandidate;
+                    if (std::type_index(attributeValue.type()) != value.type) {
+                        for (auto& conversionDispatcher : value.conversions) {
+                            if (conversionDispatcher.from == attributeValue.type()) {
+                                auto conversionCandidate = conversionDispatcher.function(attributeValue);
+                                if (conversionCandidate) {
+                                    attributeValue = *conversionCandidate;
+                                }
+                                break;
+                            }
+                        }
+                    }
+
+                    if (std::type_index(attributeValue.type()) == value.type) {
+                        if (value.pixelSpace) ScalePixelSpaceValue(value.valueType, attributeValue);
+                        SetValueUniform(shaderStage, linkedUniform.location, value.valueType, attributeValue);
+                    }
+                }
+
+                for (auto& resolutionFramebuffer : uniform.resolutions) {
+                    auto& targetResolutionFramebuffer = m_swappedFramebuffers[resolutionFramebuffer];
+                    GPU::SetShaderUniform(shaderStage, linkedUniform.location, glm::vec2(targetResolutionFramebuffer.width, targetResolutionFramebuffer.height));
+                }
+
+                if (uniform.previewScale) {
+                    GPU::SetShaderUniform(shaderStage, linkedUniform.location, Compositor::previewResolutionScale);
+                }
+
+                for (auto& screenSpaceRendering : uniform.screenSpaceRenderings) {
+                    std::optional<Framebuffer> framebufferCandidate = GetCachedAttribute<Framebuffer>(screenSpaceRendering.attributeName, t_contextData);
+                    if (!framebufferCandidate) continue;
+                    auto& targetScreenSpaceFramebuffer = *framebufferCandidate;
+                    bool useScreenSpaceRendering = !(targetScreenSpaceFramebuffer.attachments.size() >= 2);
+                    auto overriderCandidate = GetCachedAttribute<bool>(screenSpaceRendering.overrideAttributeName, t_contextData);
+                    if (overriderCandidate && *overriderCandidate) {
+                        useScreenSpaceRendering = true;
+                    }
+                    GPU::SetShaderUniform(shaderStage, linkedUniform.location, (int) useScreenSpaceRendering);
+                }
+
+                for (int attachmentIndex = 0; attachmentIndex < uniform.attachments.size(); attachmentIndex++) {
+                    auto& attachment = uniform.attachments[attachmentIndex];
+                    std::optional<Framebuffer> attributeCandidate = TextureInteroperability::GetFramebuffer(GetDynamicCachedAttribute(attachment.attributeName, t_contextData));
+                    GPU::BindPipeline(pipeline);
+                    GPU::BindFramebuffer(framebuffer);
+                    bool wasBound = false;
+                    if (attributeCandidate) {
+                        auto& attributeValue = *attributeCandidate;
+                        if (attachment.attachmentIndex >= 0 && attachment.attachmentIndex < attributeValue.attachments.size()) {
+                            GPU::BindTextureToShader(shaderStage, linkedUniform.location, attributeValue.attachments.at(attachment.attachmentIndex), attachment.unitIndex);
+                            wasBound = true;
+                        }
+                    }
+
+                    GPU::SetShaderUniform(shaderStage, linkedUniform.availabilityLocations[attachmentIndex], (int) wasBound);
+                }
+            }
+
+            for (auto& sampler : pass.samplers) {
+                auto samplerSettingsCandidate = GetCachedAttribute<SamplerSettings>(sampler.attributeName, t_contextData);
+
+                if (!samplerSettingsCandidate) continue;
+                if (sampler.slotIndex < 0 || sampler.slotIndex >= m_samplers.size()) continue;
+                auto samplerObject = m_samplers[sampler.slotIndex];
+                auto& samplerSettings = *samplerSettingsCandidate;
+                GPU::SetSamplerTextureFilteringMode(samplerObject, TextureFilteringOperation::Magnify, samplerSettings.filteringMode);
+                GPU::SetSamplerTextureFilteringMode(samplerObject, TextureFilteringOperation::Minify, samplerSettings.filteringMode);
+
+                GPU::SetSamplerTextureWrappingMode(samplerObject, TextureWrappingAxis::S, samplerSettings.wrappingMode);
+                GPU::SetSamplerTextureWrappingMode(samplerObject, TextureWrappingAxis::T, samplerSettings.wrappingMode);
+
+                GPU::BindSampler(samplerObject, sampler.unitIndex);
+                targetUnboundSamplers.push_back(sampler.unitIndex);
+            }
+
+            for (auto& gradient : pass.gradients) {
+                if (!gradient.uniformName.empty()) {
+                    auto gradientCandidate = GetCachedAttribute<Gradient1D>(gradient.attributeName, t_contextData);
+                    if (!gradientCandidate) continue;
+                    GPU::BindPipeline(pipeline);
+                    GPU::BindFramebuffer(framebuffer);
+                    GPU::BindTextureToShader(pipeline.fragment, gradient.uniformName, GradientLUT::Get(*gradientCandidate, Compositor::s_colorPrecision), gradient.unitIndex);
+                    GPU::BindSampler(GradientLUT::GetSampler(), gradient.unitIndex);
+                    targetUnboundSamplers.push_back(gradient.unitIndex);
+                    continue;
+                }
+                if (gradient.slotIndex < 0 || gradient.slotIndex >= m_gradientBuffers.size()) continue;
+                auto& gradientBuffer = m_gradientBuffers[gradient.slotIndex];
+                auto gradientCandidate = GetCachedAttribute<Gradient1D>(gradient.attributeName, t_contextData);
+                if (gradientCandidate) {
+                    auto& gradientValue = *gradientCandidate;
+                    int gradientBufferSize = sizeof(float) + sizeof(float) * 5 * gradientValue.stops.size();
+                    char* gradientBufferArray = new char[gradientBufferSize];
+                    gradientValue.FillToBuffer(gradientBufferArray);
+                    if (!gradientBuffer.has_value()) {
+                        gradientBuffer = GPU::GenerateBuffer(gradientBufferSize, ArrayBufferType::ShaderStorageBuffer, ArrayBufferUsage::Dynamic);
+                    }
+                    auto& gradientBufferRaw = gradientBuffer.value();
+                    if (gradientBufferRaw.size != gradientBufferSize) {
+                        GPU::DestroyBuffer(gradientBufferRaw);
+                        gradientBuffer = GPU::GenerateBuffer(gradientBufferSize, ArrayBufferType::ShaderStorageBuffer, ArrayBufferUsage::Dynamic);
+                    }
+                    GPU::FillBuffer(gradientBufferRaw, 0, gradientBufferSize, gradientBufferArray);
+                    GPU::BindBufferBase(gradientBufferRaw, gradient.unitIndex);
+                    delete[] gradientBufferArray;
+                }
+            }
+
+            // nodes executed while fetching attributes reset the scissor once they're done
+            if (passScissored) GPU::SetScissorRect(passRegion->ToScissor());
+            for (auto& drawCount : pass.draws) {
+                GPU::DrawArrays(drawCount);
+            }
+
+            if (passScissored) GPU::SetScissorRect(std::nullopt);
+            if (passRegion) managedFramebuffer.SetDomainOfDefinition(*passRegion);
+        }
+
+        for (auto& unboundSampler : targetUnboundSamplers) {
+            GPU::BindSampler(std::nullopt, unboundSampler);
+        } 
+
+        if (!program.passes.empty()) {
+            TryAppendAbstractPinMap(result, program.resultPin, m_swappedFramebuffers[program.resultFramebuffer]);
+        }
+
+        return result;
+    }
+
+    std::optional<PixelRegion> XMLEffectProvider::GetPassRegion(const XMLEffectPass& t_pass, Framebuffer& t_framebuffer, ContextData& t_contextData) {
+        if (!t_pass.domain) return std::nullopt;
+        auto& domain = *t_pass.domain;
+        auto textureCandidate = TextureInteroperability::GetTexture(GetDynamicCachedAttribute(domain.attributeName, t_contextData));
+        if (!textureCandidate) return std::nullopt;
+        auto region = DomainOfDefinition::GetOrFull(*textureCandidate);
+
+        glm::vec2 resolution(t_framebuffer.width, t_framebuffer.height);
+        glm::vec2 radius(0.0f);
+        for (auto& expansion : domain.expansions) {
+            auto valueCandidate = GetDynamicCachedAttribute(expansion.attributeName, t_contextData);
+            if (!valueCandidate) return std::nullopt;
+            auto& value = *valueCandidate;
+            glm::vec2 amount;
+            if (value.type() == typeid(float)) amount = glm::vec2(std::any_cast<float>(value));
+            else if (value.type() == typeid(int)) amount = glm::vec2(std::any_cast<int>(value));
+            else if (value.type() == typeid(glm::vec2)) amount = std::any_cast<glm::vec2>(value);
+            // radius can't be bounded, pass stays unscissored
+            else return std::nullopt;
+
+            amount = glm::abs(amount) * expansion.scale;
+            if (expansion.pixelSpace) {
+                amount *= Compositor::previewResolutionScale;
+            } else {
+                if (expansion.divideByAspect) amount *= resolution.y / resolution.x;
+                amount *= resolution;
+            }
+            radius += amount;
+        }
+
+        // an extra pixel covers bilinear filtering of the farthest sample
+        return region.Expand((int) std::ceil(radius.x) + 1, (int) std::ceil(radius.y) + 1).Clamp(t_framebuffer.width, t_framebuffer.height);
+    }
+
+    void XMLEffectProvider::AbstractRenderProperties() {
+        for (auto& property : m_program->properties) {
+            RenderAttributeProperty(property.name, property.metadata);
         }
     }
 
@@ -397,14 +686,15 @@ namespace Raster {
     }
 
     std::string XMLEffectProvider::AbstractHeader() {
-        return m_cachedName;
+        return m_program->name;
     }
 
     std::string XMLEffectProvider::Icon() {
-        return m_cachedIcon;
+        return m_program->icon;
     }
 
     std::optional<std::string> XMLEffectProvider::Footer() {
+        if (m_compilingShaders) return FormatString("%s %s", ICON_FA_SPINNER, "Compiling Shaders");
         return std::nullopt;
     }
 }
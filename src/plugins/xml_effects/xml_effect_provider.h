@@ -2,6 +2,9 @@
 
 #include "xml.hpp"
 
+#include <typeindex>
+#include <mutex>
+#include <atomic>
 #include "common/typedefs.h"
 #include "compositor/managed_framebuffer.h"
 #include "raster.h"
@@ -18,8 +21,145 @@ namespace Raster {
 
     using namespace pugi;
 
+    enum class XMLEffectValueType {
+        Float, Bool, Int, Vec2, Vec3, Vec4
+    };
+
+    struct XMLEffectValueBinding {
+        std::string attributeName;
+        XMLEffectValueType valueType;
+        std::type_index type;
+        // value is a distance in pixels of the full resolution render, scaled down with preview resolution
+        bool pixelSpace;
+
+        // only the dispatchers that convert into `type`, resolved once at compile time
+        std::vector<ConversionDispatcherPair> conversions;
+
+        XMLEffectValueBinding() : valueType(XMLEffectValueType::Float), type(typeid(void)), pixelSpace(false) {}
+    };
+
+    struct XMLEffectScreenSpaceBinding {
+        std::string attributeName, overrideAttributeName;
+    };
+
+    struct XMLEffectAttachmentBinding {
+        std::string attributeName;
+        std::string availabilityUniformName;
+        int attachmentIndex, unitIndex;
+    };
+
+    struct XMLEffectUniform {
+        std::string uniformName;
+        bool vertexStage;
+        std::vector<XMLEffectValueBinding> values;
+        std::vector<int> resolutions;
+        // receives Compositor::previewResolutionScale, lets shaders keep hardcoded pixel sizes proportional
+        bool previewScale;
+        std::vector<XMLEffectScreenSpaceBinding> screenSpaceRenderings;
+        std::vector<XMLEffectAttachmentBinding> attachments;
+    };
+
+    struct XMLEffectSlotBinding {
+        std::string attributeName;
+        int slotIndex, unitIndex;
+    };
+
+    struct XMLEffectGradientBinding {
+        std::string attributeName;
+        int slotIndex, unitIndex;
+        // sampler uniform receiving the baked gradient texture, stops are uploaded to a storage buffer if empty
+        std::string uniformName;
+    };
+
+    struct XMLEffectDomainExpansion {
+        std::string attributeName;
+        float scale;
+        // value is a distance in pixels rather than a fraction of framebuffer resolution
+        bool pixelSpace;
+        // value is a fraction of resolution divided by aspect ratio, as used by most shadertoy-derived shaders
+        bool divideByAspect;
+    };
+
+    // output of a pass is transparent wherever `attributeName` texture is transparent
+    // farther than the expansion radius, so the pass can be scissored to its domain of definition
+    struct XMLEffectDomain {
+        std::string attributeName;
+        std::vector<XMLEffectDomainExpansion> expansions;
+    };
+
+    struct XMLEffectPass {
+        int framebufferIndex, shaderIndex;
+        std::string baseAttributeName;
+        std::optional<glm::vec4> clearColor;
+        std::vector<XMLEffectUniform> uniforms;
+        std::vector<XMLEffectSlotBinding> samplers;
+        std::vector<XMLEffectGradientBinding> gradients;
+        std::vector<int> draws;
+        // passes without declared domain are assumed to cover the whole frame
+        std::optional<XMLEffectDomain> domain;
+    };
+
+    struct XMLEffectAttribute {
+        std::string name;
+        std::any defaultValue;
+    };
+
+    struct XMLEffectProperty {
+        std::string name;
+        std::vector<std::any> metadata;
+    };
+
+    struct XMLEffectShader {
+        std::string vertexPath, fragmentPath;
+    };
+
+    // uniform locations resolved against the compiled pipelines,
+    // laid out in the same order as XMLEffectPass::uniforms
+    struct XMLEffectLinkedUniform {
+        int location;
+        std::vector<int> availabilityLocations;
+    };
+
+    struct XMLEffectLinkedPass {
+        std::vector<XMLEffectLinkedUniform> uniforms;
+    };
+
+    struct XMLEffectLinkage {
+        std::vector<Pipeline> pipelines;
+        std::vector<XMLEffectLinkedPass> passes;
+    };
+
+    // XML document compiled once per effect type and shared between all instances of that effect
+    struct XMLEffectProgram {
+        std::string name, icon;
+        std::vector<XMLEffectAttribute> attributes;
+        std::vector<std::string> inputPins, outputPins;
+        std::vector<XMLEffectProperty> properties;
+        std::vector<XMLEffectShader> shaders;
+        std::vector<XMLEffectPass> passes;
+        int framebuffersCount, gradientsCount, samplersCount;
+        int resultFramebuffer;
+        std::string resultPin;
+
+        // resolves uniform locations once all shaders are compiled, must be called from the rendering thread.
+        // returns nullptr while shaders are still being compiled in background
+        const XMLEffectLinkage* Link() const;
+        // queues background compilation of all shaders used by the effect
+        void RequestShaders() const;
+
+        static std::shared_ptr<const XMLEffectProgram> Compile(xml_document& t_document);
+
+    private:
+        mutable std::mutex m_linkMutex;
+        mutable std::optional<XMLEffectLinkage> m_linkage;
+
+        static std::any MakeDynamicValue(std::string t_type, std::string t_value = "");
+        static std::optional<Pipeline> GetCachedPipeline(std::string t_vertexPath, std::string t_fragmentPath);
+        static std::unordered_map<std::string, Pipeline> s_pipelineCache;
+    };
+
     struct XMLEffectProvider : public NodeBase {
-        XMLEffectProvider(std::string t_xmlPath);
+        XMLEffectProvider(std::shared_ptr<const XMLEffectProgram> t_program);
         ~XMLEffectProvider();
         
         AbstractPinMap AbstractExecute(ContextData& t_contextData);
@@ -34,8 +174,6 @@ namespace Raster {
         std::optional<std::string> Footer();
 
     private:
-        std::any MakeDynamicValue(std::string t_type, std::string t_value = "");
-        
         template<typename T>
         std::optional<T> GetCachedAttribute(std::string t_attribute, ContextData& t_contextData) {
             if (m_cachedValues.find(t_attribute) != m_cachedValues.end()) {
@@ -53,6 +191,8 @@ namespace Raster {
             return std::nullopt;
         };
 
+        std::optional<PixelRegion> GetPassRegion(const XMLEffectPass& t_pass, Framebuffer& t_framebuffer, ContextData& t_contextData);
+
         std::optional<std::any> GetDynamicCachedAttribute(std::string t_attribute, ContextData& t_contextData) {
             if (m_cachedValues.find(t_attribute) != m_cachedValues.end()) {
                 return m_cachedValues[t_attribute];
@@ -65,14 +205,12 @@ namespace Raster {
             return std::nullopt;
         };
 
+        std::shared_ptr<const XMLEffectProgram> m_program;
         std::vector<Sampler> m_samplers;
-        std::vector<Pipeline> m_pipelines;
         std::vector<ManagedFramebuffer> m_framebuffers;
+        std::vector<Framebuffer> m_swappedFramebuffers;
         std::vector<std::optional<ArrayBuffer>> m_gradientBuffers;
-        std::unique_ptr<xml_document> m_document;
         std::unordered_map<std::string, std::any> m_cachedValues;
-
-        std::string m_cachedName, m_cachedIcon;
-        static std::unordered_map<std::string, Pipeline> s_pipelineCache;
+        std::atomic<bool> m_compilingShaders;
     };
 };
\ No newline at end of file
@@ -28,10 +28,6 @@ namespace Raster {
     void XMLEffectsPlugin::LoadXMLEffects() {
         auto xmlIterator = std::filesystem::directory_iterator("effects");
         for (auto& entry : xmlIterator) {
-            std::function<AbstractNode()> spawnFunction = [entry]() {
-                return std::make_shared<XMLEffectProvider>(entry.path().string());
-            };
-
             xml_document doc;
             if (!doc.load_file(entry.path().string().c_str())) {
                 print("failed to load xml effect '" << entry << "'");
@@ -39,6 +35,19 @@ namespace Raster {
             }
             print("loading xml effect '" << entry.path().string() << "'");
 
+            std::shared_ptr<const XMLEffectProgram> program;
+            try {
+                program = XMLEffectProgram::Compile(doc);
+            } catch (std::exception& e) {
+                print("failed to compile xml effect '" << entry.path().string() << "'");
+                print("\t" << e.what());
+                continue;
+            }
+
+            std::function<AbstractNode()> spawnFunction = [program]() {
+                return std::make_shared<XMLEffectProvider>(program);
+            };
+
             auto description = doc.child("effect").child("description");
             auto packaged = description.attribute("packaged").as_bool();
             auto packageName = description.attribute("packageName").as_string();
@@ -51,7 +60,7 @@ namespace Raster {
             implementation.description.prettyName = name;
             implementation.description.category = DefaultNodeCategories::s_rendering;
 
-            Workspace::s_nodeImplementations.push_back(implementation);
+            Workspace::RegisterNodeImplementation(implementation);
         }
     }
 
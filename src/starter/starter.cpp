@@ -1,15 +1,27 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <cstdio>
 #include <filesystem>
+#include <fstream>
 #include <iostream>
+#include <map>
+#include <optional>
 #include <ostream>
 #include <random>
+#include <sstream>
+#include <thread>
+#include <vector>
 #include "zip/zip.h"
 
 // what is a starter?
 // - before running Raster, it needs to be unpacked from so-called PAK files
 // - PAK files are essentially ZIP archives with some metadata included in them
 // - the purpose of PAK files is to simplify distribution of custom plugins/nodes/attributes and etc.
-// - starter creates hidden temporary folder to which all PAK files will be extracted
+// - starter extracts all PAK files into a hidden cache folder keyed by the contents of PAK files,
+//   so consecutive launches with unchanged PAK files skip extraction entirely
+// - cache entries are read-only and shared between launches, raster itself runs from a private
+//   working folder which links to the cache entry and is removed once raster exits
 
 #if defined(WIN32) || defined(_WIN32) || defined(__WIN32__) || defined(__NT__)
     #define RASTER_PLATFORM_WINDOWS
@@ -27,8 +39,15 @@
 
 #define print(expr) std::cout << expr << std::endl
 
+#define CACHE_FOLDER "./.raster_cache/"
+#define CACHE_HASHES_FILE CACHE_FOLDER "hashes"
+// written by raster into its working folder, kept next to the cache entry so warm starts can reuse it
+#define LIBRARIES_MANIFEST_FILE "libraries.json"
+// cache entries which weren't used for this long are removed
+#define CACHE_EXPIRATION_HOURS (24 * 7)
+
 static std::random_device s_random_device;
-static std::mt19937 s_random;
+static std::mt19937 s_random(s_random_device());
 static std::uniform_int_distribution<std::mt19937::result_type> s_distribution;
 
 int GetRandomInteger() {
@@ -46,6 +65,301 @@ static std::string FormatString( const std::string& format, Args ... args ) {
     return std::string( buf.get(), buf.get() + size - 1 ); // We don't want the '\0' inside
 }
 
+struct PakFile {
+    std::string path;
+    uint64_t size;
+    int64_t modificationTime;
+    uint64_t hash;
+};
+
+struct ExtractionJob {
+    int pakIndex;
+    size_t entryIndex;
+    std::string name;
+};
+
+// FNV-1a
+static uint64_t HashBytes(uint64_t t_hash, const char* t_data, size_t t_size) {
+    for (size_t i = 0; i < t_size; i++) {
+        t_hash ^= (uint8_t) t_data[i];
+        t_hash *= 1099511628211ULL;
+    }
+    return t_hash;
+}
+
+static uint64_t HashFile(const std::string& t_path) {
+    uint64_t hash = 14695981039346656037ULL;
+    std::ifstream stream(t_path, std::ios::binary);
+    std::vector<char> buffer(1 << 20);
+    while (stream) {
+        stream.read(buffer.data(), buffer.size());
+        hash = HashBytes(hash, buffer.data(), stream.gcount());
+    }
+    return hash;
+}
+
+static int64_t GetModificationTime(const std::filesystem::path& t_path) {
+    std::error_code error;
+    auto time = std::filesystem::last_write_time(t_path, error);
+    if (error) return 0;
+    return time.time_since_epoch().count();
+}
+
+// content hashes are memoized by path, size and modification time,
+// so warm starts don't have to read PAK files at all
+static std::map<std::string, PakFile> ReadHashes() {
+    std::map<std::string, PakFile> hashes;
+    std::ifstream stream(CACHE_HASHES_FILE);
+    std::string line;
+    while (std::getline(stream, line)) {
+        std::istringstream lineStream(line);
+        PakFile pak;
+        if (std::getline(lineStream, pak.path, '\t') && lineStream >> pak.size >> pak.modificationTime >> std::hex >> pak.hash) {
+            hashes[pak.path] = pak;
+        }
+    }
+    return hashes;
+}
+
+static void WriteHashes(const std::vector<PakFile>& t_paks) {
+    std::string temporaryPath = FormatString(CACHE_HASHES_FILE ".%i", GetRandomInteger());
+    {
+        std::ofstream stream(temporaryPath);
+        for (auto& pak : t_paks) {
+            stream << pak.path << '\t' << pak.size << ' ' << pak.modificationTime << ' ' << std::hex << pak.hash << std::dec << '\n';
+        }
+    }
+    std::error_code error;
+    std::filesystem::rename(temporaryPath, CACHE_HASHES_FILE, error);
+    if (error) std::filesystem::remove(temporaryPath, error);
+}
+
+static std::vector<PakFile> CollectPaks(const std::string& t_paksFolder) {
+    std::vector<PakFile> paks;
+    for (auto& entry : std::filesystem::recursive_directory_iterator(t_paksFolder)) {
+        if (!entry.is_regular_file()) continue;
+        PakFile pak;
+        pak.path = entry.path().generic_string();
+        pak.size = entry.file_size();
+        pak.modificationTime = GetModificationTime(entry.path());
+        pak.hash = 0;
+        paks.push_back(pak);
+    }
+    // stable order, later PAKs override entries of earlier ones
+    std::sort(paks.begin(), paks.end(), [](auto& a, auto& b) { return a.path < b.path; });
+
+    auto memoizedHashes = ReadHashes();
+    std::vector<std::thread> threads;
+    for (auto& pak : paks) {
+        auto memoized = memoizedHashes.find(pak.path);
+        if (memoized != memoizedHashes.end() && memoized->second.size == pak.size && memoized->second.modificationTime == pak.modificationTime) {
+            pak.hash = memoized->second.hash;
+            continue;
+        }
+        threads.emplace_back([&pak]() {
+            pak.hash = HashFile(pak.path);
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    if (!threads.empty()) WriteHashes(paks);
+    return paks;
+}
+
+static std::string GetCacheKey(const std::vector<PakFile>& t_paks) {
+    uint64_t hash = 14695981039346656037ULL;
+    for (auto& pak : t_paks) {
+        hash = HashBytes(hash, pak.path.data(), pak.path.size());
+        hash = HashBytes(hash, (const char*) &pak.hash, sizeof(pak.hash));
+    }
+    return FormatString("%016llx", (unsigned long long) hash);
+}
+
+static bool IsSafeEntryName(const std::string& t_name) {
+    if (t_name.empty() || t_name[0] == '/' || t_name[0] == '\\') return false;
+    return std::filesystem::path(t_name).lexically_normal().generic_string().rfind("..", 0) != 0;
+}
+
+// extracts every entry of every PAK into t_folder, entries are distributed between worker threads
+static bool ExtractPaks(const std::vector<PakFile>& t_paks, const std::string& t_folder) {
+    std::map<std::string, ExtractionJob> jobsByName;
+    for (int i = 0; i < (int) t_paks.size(); i++) {
+        print("extracting " << t_paks[i].path);
+        int error = 0;
+        auto zip = zip_openwitherror(t_paks[i].path.c_str(), 0, 'r', &error);
+        if (!zip) {
+            print("failed to open " << t_paks[i].path << ": " << zip_strerror(error));
+            return false;
+        }
+        auto entriesCount = zip_entries_total(zip);
+        for (ssize_t entryIndex = 0; entryIndex < entriesCount; entryIndex++) {
+            if (zip_entry_openbyindex(zip, entryIndex) < 0) continue;
+            std::string name = zip_entry_name(zip);
+            bool isDirectory = zip_entry_isdir(zip);
+            zip_entry_close(zip);
+            if (!IsSafeEntryName(name)) {
+                print("skipping unsafe entry " << name);
+                continue;
+            }
+            if (isDirectory) {
+                std::filesystem::create_directories(t_folder + name);
+                continue;
+            }
+            jobsByName[name] = {i, (size_t) entryIndex, name};
+        }
+        zip_close(zip);
+    }
+
+    std::vector<ExtractionJob> jobs;
+    for (auto& [name, job] : jobsByName) jobs.push_back(job);
+
+    std::atomic<size_t> nextJob = 0;
+    std::atomic<bool> failed = false;
+    auto worker = [&]() {
+        // zip handles are not thread-safe, so every worker opens its own
+        std::vector<zip_t*> zips(t_paks.size(), nullptr);
+        size_t jobIndex;
+        while (!failed && (jobIndex = nextJob++) < jobs.size()) {
+            auto& job = jobs[jobIndex];
+            auto& zip = zips[job.pakIndex];
+            if (!zip) zip = zip_open(t_paks[job.pakIndex].path.c_str(), 0, 'r');
+            std::string targetPath = t_folder + job.name;
+            std::error_code error;
+            std::filesystem::create_directories(std::filesystem::path(targetPath).parent_path(), error);
+            if (!zip || zip_entry_openbyindex(zip, job.entryIndex) < 0 || zip_entry_fread(zip, targetPath.c_str()) < 0) {
+                print("failed to extract " << job.name << " from " << t_paks[job.pakIndex].path);
+                failed = true;
+            }
+            if (zip) zip_entry_close(zip);
+        }
+        for (auto zip : zips) if (zip) zip_close(zip);
+    };
+
+    int threadsCount = std::max(1, std::min((int) std::thread::hardware_concurrency(), (int) jobs.size()));
+    std::vector<std::thread> threads;
+    for (int i = 0; i < threadsCount; i++) threads.emplace_back(worker);
+    for (auto& thread : threads) thread.join();
+    return !failed;
+}
+
+static std::string GetManifestPath(const std::string& t_key) {
+    return std::string(CACHE_FOLDER) + t_key + "." LIBRARIES_MANIFEST_FILE;
+}
+
+// files of a complete cache entry are read-only, so nothing can modify them through links of a working folder
+static void SetWritable(const std::string& t_folder, bool t_writable) {
+    std::error_code error;
+    for (auto& entry : std::filesystem::recursive_directory_iterator(t_folder, error)) {
+        if (!entry.is_regular_file(error)) continue;
+        if (t_writable) {
+            std::filesystem::permissions(entry.path(), std::filesystem::perms::owner_write, std::filesystem::perm_options::add, error);
+        } else {
+            std::filesystem::permissions(entry.path(), std::filesystem::perms::owner_write | std::filesystem::perms::group_write | std::filesystem::perms::others_write, std::filesystem::perm_options::remove, error);
+        }
+    }
+}
+
+// removes staging folders of interrupted launches and cache entries which weren't used for a while
+static void PruneCache(const std::string& t_key) {
+    std::error_code error;
+    auto now = std::filesystem::file_time_type::clock::now();
+    for (auto& entry : std::filesystem::directory_iterator(CACHE_FOLDER, error)) {
+        auto path = entry.path().generic_string();
+        if (entry.path().filename() == t_key || path == GetManifestPath(t_key) || path == CACHE_HASHES_FILE) continue;
+        auto modificationTime = std::filesystem::last_write_time(entry.path(), error);
+        if (error || now - modificationTime < std::chrono::hours(CACHE_EXPIRATION_HOURS)) continue;
+        if (entry.is_directory()) SetWritable(path, true);
+        std::filesystem::remove_all(entry.path(), error);
+    }
+}
+
+static std::optional<std::string> PrepareCache(const std::string& t_paksFolder) {
+    std::filesystem::create_directories(CACHE_FOLDER);
+    auto paks = CollectPaks(t_paksFolder);
+    auto key = GetCacheKey(paks);
+    std::string cacheFolderPath = std::string(CACHE_FOLDER) + key + "/";
+    PruneCache(key);
+
+    std::error_code error;
+    if (std::filesystem::exists(cacheFolderPath)) {
+        print("using cached PAK files " << cacheFolderPath);
+        std::filesystem::last_write_time(cacheFolderPath, std::filesystem::file_time_type::clock::now(), error);
+        return cacheFolderPath;
+    }
+
+    // PAK files are extracted into a private staging folder and renamed into place when complete,
+    // so concurrent launches never observe a partially extracted cache entry
+    std::string stagingFolderPath = FormatString("%s%s.staging%i/", CACHE_FOLDER, key.c_str(), GetRandomInteger());
+    std::filesystem::create_directories(stagingFolderPath);
+    if (!ExtractPaks(paks, stagingFolderPath)) {
+        std::filesystem::remove_all(stagingFolderPath, error);
+        return std::nullopt;
+    }
+    SetWritable(stagingFolderPath, false);
+    std::filesystem::rename(stagingFolderPath, std::string(CACHE_FOLDER) + key, error);
+    if (error) {
+        // another launch has finished extracting the same PAK files first
+        SetWritable(stagingFolderPath, true);
+        std::filesystem::remove_all(stagingFolderPath, error);
+        if (!std::filesystem::exists(cacheFolderPath)) return std::nullopt;
+    }
+    return cacheFolderPath;
+}
+
+// mirrors the cache entry into t_workingFolder: directories are recreated and files are linked,
+// falling back to copies where symlinks are not available (e.g. Windows without developer mode)
+static bool PrepareWorkingFolder(const std::string& t_cacheFolder, const std::string& t_workingFolder) {
+    std::error_code error;
+    std::filesystem::create_directories(t_workingFolder, error);
+    if (error) return false;
+    auto cacheFolder = std::filesystem::absolute(t_cacheFolder);
+    bool symlinksAvailable = true;
+    for (auto& entry : std::filesystem::recursive_directory_iterator(cacheFolder, error)) {
+        auto relativePath = std::filesystem::relative(entry.path(), cacheFolder, error);
+        if (error) return false;
+        // cache entries created by previous versions of starter may still hold per-launch files
+        auto relativeName = relativePath.generic_string();
+        if (relativeName == LIBRARIES_MANIFEST_FILE || relativeName == "project" || relativeName.rfind("project/", 0) == 0) continue;
+        auto targetPath = std::filesystem::path(t_workingFolder) / relativePath;
+        if (entry.is_directory()) {
+            std::filesystem::create_directories(targetPath, error);
+            if (error) return false;
+            continue;
+        }
+        if (symlinksAvailable) {
+            std::filesystem::create_symlink(entry.path(), targetPath, error);
+            if (!error) continue;
+            symlinksAvailable = false;
+            error.clear();
+        }
+        std::filesystem::copy_file(entry.path(), targetPath, error);
+        if (error) {
+            print("failed to prepare " << targetPath.generic_string() << ": " << error.message());
+            return false;
+        }
+        // copies inherit read-only permissions of the cache entry
+        std::filesystem::permissions(targetPath, std::filesystem::perms::owner_write, std::filesystem::perm_options::add, error);
+    }
+    if (error) return false;
+
+    std::string key = cacheFolder.parent_path().filename().generic_string();
+    if (std::filesystem::exists(GetManifestPath(key))) {
+        std::filesystem::copy_file(GetManifestPath(key), t_workingFolder + LIBRARIES_MANIFEST_FILE, error);
+    }
+    return true;
+}
+
+// keeps manifest of described libraries for the next launch with the same cache entry
+static void SaveWorkingFolderManifest(const std::string& t_cacheFolder, const std::string& t_workingFolder) {
+    std::error_code error;
+    std::string workingManifestPath = t_workingFolder + LIBRARIES_MANIFEST_FILE;
+    if (!std::filesystem::is_regular_file(workingManifestPath, error) || std::filesystem::is_symlink(workingManifestPath, error)) return;
+    std::string key = std::filesystem::absolute(t_cacheFolder).parent_path().filename().generic_string();
+    std::string temporaryPath = FormatString("%s.%i", GetManifestPath(key).c_str(), GetRandomInteger());
+    std::filesystem::copy_file(workingManifestPath, temporaryPath, error);
+    if (!error) std::filesystem::rename(temporaryPath, GetManifestPath(key), error);
+    if (error) std::filesystem::remove(temporaryPath, error);
+}
+
 int main(int argc, char** argv) {
     bool extractOnly = false;
     for (int i = 1; i < argc; i++) {
@@ -64,15 +378,6 @@ int main(int argc, char** argv) {
         print("extract only mode!");
     }
     print("starting raster from " << std::filesystem::current_path());
-    int randomID = GetRandomInteger();
-    std::string temporaryFolderPath = FormatString("./.raster%i/", randomID);
-    if (std::filesystem::exists(temporaryFolderPath)) {
-        std::filesystem::remove_all(temporaryFolderPath);
-    }
-
-    if (!std::filesystem::exists(temporaryFolderPath)) {
-        std::filesystem::create_directory(temporaryFolderPath);
-    }
 
     std::string paksFolder = "./paks/";
     if (!std::filesystem::exists(paksFolder + "core.pak")) {
@@ -81,20 +386,30 @@ int main(int argc, char** argv) {
         print("without paks/core.pak starter has nothing to execute");
         return 1;
     }
-    auto paksIterator = std::filesystem::recursive_directory_iterator(paksFolder);
-    for (auto& entry : paksIterator) {
-        print("extracting " << entry.path().string());
-        zip_extract(entry.path().string().c_str(), temporaryFolderPath.c_str(), nullptr, nullptr);
-    }
 
-    // getchar();
+    auto cacheFolderCandidate = PrepareCache(paksFolder);
+    if (!cacheFolderCandidate.has_value()) {
+        print("failed to extract PAK files! exiting");
+        return 1;
+    }
+    auto cacheFolderPath = *cacheFolderCandidate;
+    if (extractOnly) {
+        print("extracted to " << cacheFolderPath);
+    }
 
     auto originalCwd = std::filesystem::current_path();
+    std::string workingFolderPath = FormatString("./.raster%i/", GetRandomInteger());
     if (!extractOnly) {
+        if (!PrepareWorkingFolder(cacheFolderPath, workingFolderPath)) {
+            print("failed to prepare working folder " << workingFolderPath << "! exiting");
+            std::error_code error;
+            std::filesystem::remove_all(workingFolderPath, error);
+            return 1;
+        }
         try {
-            std::string targetExecutable = temporaryFolderPath + "raster_core" + std::string(EXECUTABLE_EXTENSION);
+            std::string targetExecutable = workingFolderPath + "raster_core" + std::string(EXECUTABLE_EXTENSION);
             if (std::filesystem::exists(targetExecutable)) {
-                std::filesystem::current_path(temporaryFolderPath);
+                std::filesystem::current_path(workingFolderPath);
                 std::flush(std::cout);
                 #if defined(RASTER_PLATFORM_LINUX) || defined(RASTER_PLATFORM_APPLE)
                     system("./raster_core");
@@ -109,9 +424,14 @@ int main(int argc, char** argv) {
         }
     }
 
-    if (!extractOnly) print("removing temporary files...");
     std::filesystem::current_path(originalCwd);
-    if (!extractOnly) std::filesystem::remove_all(temporaryFolderPath);
+    if (!extractOnly) {
+        print("removing temporary files...");
+        SaveWorkingFolderManifest(cacheFolderPath, workingFolderPath);
+        // links are removed without touching the cache entry they point to
+        std::error_code error;
+        std::filesystem::remove_all(workingFolderPath, error);
+    }
 
     return 0;
-}
\ No newline at end of file
+}